@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+#include "AccountStore.h"
+
+/**
+ * Lookup latency of the dense account table against a std::map.
+ *
+ * Fills a std::map (the previous storage), a dense AccountStore, and an
+ * AccountStore forced to keep every account in its sparse fallback with the
+ * same sequential numbers, then times the same random lookups in each.
+ * All entries share one account: only the containers are measured.
+ *
+ * Usage: AccountLookupBenchmark [minAccounts] [maxAccounts] [lookups]
+ */
+namespace {
+
+const int FIRST_ACCOUNT = 1001;
+
+template <typename Lookup>
+double nanosecondsPerLookup(const std::vector<int>& keys, Lookup lookup) {
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int key : keys) {
+        found += lookup(key) ? 1 : 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    if (found != keys.size()) {
+        std::cerr << "Lookup missed " << keys.size() - found << " account(s)" << std::endl;
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(keys.size());
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int minAccounts = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int maxAccounts = argc > 2 ? std::atoi(argv[2]) : 10000000;
+    int lookups = argc > 3 ? std::atoi(argv[3]) : 2000000;
+    
+    auto account = std::make_shared<Account>(FIRST_ACCOUNT, "Holder", "password", Money::rupees(1000));
+    
+    std::cout << "Lookups per run: " << lookups << std::endl;
+    std::cout << std::setw(10) << "Accounts" << std::setw(14) << "map ns" << std::setw(14) << "dense ns"
+              << std::setw(14) << "sparse ns" << std::setw(10) << "speedup" << std::endl;
+    
+    for (long long size = minAccounts; size <= maxAccounts; size *= 10) {
+        int accounts = static_cast<int>(size);
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> pick(0, accounts - 1);
+        std::vector<int> offsets(static_cast<size_t>(lookups));
+        for (auto& offset : offsets) {
+            offset = pick(random);
+        }
+        
+        double mapNs;
+        {
+            std::map<int, std::shared_ptr<Account>> map;
+            for (int i = 0; i < accounts; ++i) {
+                map.emplace(FIRST_ACCOUNT + i, account);
+            }
+            std::vector<int> keys;
+            for (int offset : offsets) {
+                keys.push_back(FIRST_ACCOUNT + offset);
+            }
+            mapNs = nanosecondsPerLookup(keys, [&map](int key) {
+                auto it = map.find(key);
+                return it != map.end() ? it->second : nullptr;
+            });
+        }
+        
+        double denseNs;
+        {
+            AccountStore store(AccountStore::DEFAULT_STRIPES, FIRST_ACCOUNT);
+            for (int i = 0; i < accounts; ++i) {
+                store.assign(FIRST_ACCOUNT + i, account);
+            }
+            std::vector<int> keys;
+            for (int offset : offsets) {
+                keys.push_back(FIRST_ACCOUNT + offset);
+            }
+            denseNs = nanosecondsPerLookup(keys, [&store](int key) { return store.find(key); });
+        }
+        
+        double sparseNs;
+        {
+            // A base above every number sends all of them to the sparse fallback
+            AccountStore store(AccountStore::DEFAULT_STRIPES, std::numeric_limits<int>::max());
+            for (int i = 0; i < accounts; ++i) {
+                store.assign(FIRST_ACCOUNT + i, account);
+            }
+            std::vector<int> keys;
+            for (int offset : offsets) {
+                keys.push_back(FIRST_ACCOUNT + offset);
+            }
+            sparseNs = nanosecondsPerLookup(keys, [&store](int key) { return store.find(key); });
+        }
+        
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << std::setw(10) << accounts << std::setw(14) << mapNs << std::setw(14) << denseNs
+                  << std::setw(14) << sparseNs << std::setw(9) << mapNs / denseNs << "x" << std::endl;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AccountStore.h"
+
+/**
+ * Multi-threaded throughput of account operations through the striped store.
+ *
+ * Each thread looks up random accounts and deposits into or withdraws from
+ * them. A single-stripe store stands in for one global lock over the map.
+ *
+ * Usage: AccountStoreBenchmark [accounts] [operationsPerThread] [maxThreads]
+ */
+namespace {
+
+double runOperations(AccountStore& store, int accounts, int threads, int operations) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&store, accounts, operations, t]() {
+            std::mt19937 random(static_cast<unsigned int>(t + 1));
+            std::uniform_int_distribution<int> pick(0, accounts - 1);
+            for (int i = 0; i < operations; ++i) {
+                auto account = store.find(1001 + pick(random));
+                if (i % 2 == 0) {
+                    account->depositAsync(Money::rupees(10)).get();
+                } else {
+                    account->withdrawAsync(Money::rupees(10)).get();
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return seconds > 0 ? threads * operations / seconds : 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int accounts = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int operations = argc > 2 ? std::atoi(argv[2]) : 200000;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+    
+    AccountStore globalLock(1);
+    AccountStore striped;
+    for (int i = 0; i < accounts; ++i) {
+        auto account = std::make_shared<Account>(1001 + i, "Holder " + std::to_string(i), "password", Money::rupees(1000));
+        globalLock.assign(1001 + i, account);
+        striped.assign(1001 + i, account);
+    }
+    
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "Accounts              : " << accounts << std::endl;
+    std::cout << "Operations per thread : " << operations << std::endl;
+    std::cout << "Stripes               : " << AccountStore::DEFAULT_STRIPES << std::endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double single = runOperations(globalLock, accounts, threads, operations);
+        double many = runOperations(striped, accounts, threads, operations);
+        std::cout << std::setw(2) << threads << " thread(s)           : " << std::setw(10) << single
+                  << " ops/sec (1 stripe), " << std::setw(10) << many << " ops/sec (striped)" << std::endl;
+    }
+    
+    return 0;
+}
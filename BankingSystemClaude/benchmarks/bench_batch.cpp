@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BankManager.h"
+
+/**
+ * Bulk reconciliation: one call per operation vs the batch API.
+ *
+ * Usage: BatchBenchmark [accounts] [operations] [threads]
+ */
+namespace {
+
+std::vector<int> createAccounts(BankManager* bank, int count) {
+    std::vector<int> numbers;
+    for (int i = 0; i < count; ++i) {
+        numbers.push_back(bank->createAccount("Holder " + std::to_string(i), "password", Money::rupees(1000000)));
+    }
+    return numbers;
+}
+
+std::vector<BatchOperation> makeOperations(const std::vector<int>& numbers, int count) {
+    std::vector<BatchOperation> operations;
+    operations.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        BatchOperation::Type type = (i % 4 == 0) ? BatchOperation::Type::WITHDRAWAL : BatchOperation::Type::DEPOSIT;
+        operations.push_back({type, numbers[(i * 7919) % numbers.size()], Money::rupees(10 + i % 100)});
+    }
+    return operations;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int accountCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int operationCount = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    size_t threads = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 0;
+    
+    // Baseline: one deposit()/withdraw() call per operation
+    BankManager::resetInstance();
+    BankManager* bank = BankManager::getInstance();
+    std::vector<BatchOperation> operations = makeOperations(createAccounts(bank, accountCount), operationCount);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& op : operations) {
+        auto account = bank->getAccount(op.accountNumber);
+        if (op.type == BatchOperation::Type::DEPOSIT) {
+            account->deposit(op.amount);
+        } else {
+            account->withdraw(op.amount);
+        }
+    }
+    double perCallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    // Batch API from a vector
+    BankManager::resetInstance();
+    bank = BankManager::getInstance();
+    bank->setLoadThreads(threads);
+    createAccounts(bank, accountCount);
+    BatchReport vectorReport = bank->applyBatch(operations);
+    
+    // Batch API from CSV text
+    std::string csv = "type,account,amount\n";
+    for (const auto& op : operations) {
+        csv += (op.type == BatchOperation::Type::DEPOSIT) ? "D," : "W,";
+        csv += std::to_string(op.accountNumber) + "," + op.amount.toString() + "\n";
+    }
+    BankManager::resetInstance();
+    bank = BankManager::getInstance();
+    bank->setLoadThreads(threads);
+    createAccounts(bank, accountCount);
+    std::istringstream csvStream(csv);
+    BatchReport csvReport = bank->applyBatch(csvStream);
+    
+    BankManager::resetInstance();
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Accounts              : " << accountCount << std::endl;
+    std::cout << "Operations            : " << operationCount << std::endl;
+    std::cout << "Batch threads         : " << vectorReport.threads << std::endl;
+    std::cout << "Per-call operations   : " << perCallMs << " ms" << std::endl;
+    std::cout << "Batch (vector)        : " << vectorReport.applyMilliseconds << " ms ("
+              << vectorReport.applied << " applied, " << vectorReport.rejected << " rejected)" << std::endl;
+    std::cout << "Batch (CSV)           : " << csvReport.parseMilliseconds << " ms parse + "
+              << csvReport.applyMilliseconds << " ms apply" << std::endl;
+    std::cout << "Batch vs per-call     : "
+              << (vectorReport.applyMilliseconds > 0 ? perCallMs / vectorReport.applyMilliseconds : 0) << "x" << std::endl;
+    
+    return 0;
+}
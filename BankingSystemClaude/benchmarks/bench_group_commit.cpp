@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BankManager.h"
+#include "FileManager.h"
+
+/**
+ * Durable-operation throughput vs group-commit window.
+ *
+ * Each thread deposits into its own account and waits for every deposit to
+ * be synced to the journal before issuing the next one. A commit closes when
+ * its window expires or once every thread is waiting on it.
+ *
+ * Usage: GroupCommitBenchmark [threads] [operationsPerThread]
+ */
+namespace {
+
+const char* BENCH_JOURNAL = "bench_group_commit.journal";
+
+struct RunResult {
+    double opsPerSecond;
+    size_t commits;
+};
+
+RunResult runWindow(int threads, int operations, std::chrono::microseconds window) {
+    FileManager fileManager;
+    fileManager.deleteFile(BENCH_JOURNAL);
+    
+    BankManager::resetInstance();
+    BankManager* bank = BankManager::getInstance();
+    bank->enableJournal(BENCH_JOURNAL);
+    bank->setCommitDelay(window);
+    bank->setCommitBatch(static_cast<size_t>(threads));
+    
+    std::vector<std::shared_ptr<Account>> accounts;
+    for (int t = 0; t < threads; ++t) {
+        accounts.push_back(bank->getAccount(bank->createAccount("Holder " + std::to_string(t), "password", Money::rupees(1000))));
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&accounts, t, operations]() {
+            for (int i = 0; i < operations; ++i) {
+                accounts[t]->depositAsync(Money::rupees(1)).get();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double seconds = std::chrono::duration<double>(end - start).count();
+    RunResult result;
+    result.opsPerSecond = seconds > 0 ? threads * operations / seconds : 0;
+    result.commits = bank->getJournalCommits();
+    
+    BankManager::resetInstance();
+    fileManager.deleteFile(BENCH_JOURNAL);
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int threads = argc > 1 ? std::atoi(argv[1]) : 8;
+    int operations = argc > 2 ? std::atoi(argv[2]) : 500;
+    const long windows[] = {0, 100, 500, 1000, 2000};
+    
+    std::cout << "Threads               : " << threads << std::endl;
+    std::cout << "Deposits per thread   : " << operations << std::endl;
+    
+    for (long window : windows) {
+        RunResult result = runWindow(threads, operations, std::chrono::microseconds(window));
+        
+        std::cout << std::fixed << std::setprecision(0);
+        std::cout << "Window " << std::setw(5) << window << " us      : " << std::setw(9) << result.opsPerSecond
+                  << " ops/sec, " << result.commits << " commits" << std::endl;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "Account.h"
+
+/**
+ * Recent-history upkeep: inline ring buffer against the old deque.
+ *
+ * Each of the histories receives the same stream of transactions. The deque
+ * side pushes a copy and pops the front once it holds more than the history
+ * length, as Account did before; the ring buffer constructs in place.
+ *
+ * Usage: TransactionHistoryBenchmark [histories] [transactions per history]
+ */
+int main(int argc, char* argv[]) {
+    int histories = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int perHistory = argc > 2 ? std::atoi(argv[2]) : 50;
+    auto when = std::chrono::system_clock::now();
+
+    Money dequeChecksum;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::deque<Transaction>> deques(histories);
+        for (int t = 0; t < perHistory; ++t) {
+            for (auto& history : deques) {
+                Transaction trans(Transaction::Type::DEPOSIT, Money::rupees(t), Money::rupees(t), DescriptionTable::CASH_DEPOSIT, when);
+                history.push_back(trans);
+                if (history.size() > Account::MAX_TRANSACTION_HISTORY) {
+                    history.pop_front();
+                }
+            }
+        }
+        for (const auto& history : deques) {
+            dequeChecksum += history.back().getAmount();
+        }
+    }
+    double dequeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    Money ringChecksum;
+    start = std::chrono::steady_clock::now();
+    {
+        std::vector<Account::TransactionHistory> rings(histories);
+        for (int t = 0; t < perHistory; ++t) {
+            for (auto& history : rings) {
+                history.emplace_back(Transaction::Type::DEPOSIT, Money::rupees(t), Money::rupees(t), DescriptionTable::CASH_DEPOSIT, when);
+            }
+        }
+        for (const auto& history : rings) {
+            ringChecksum += history.back().getAmount();
+        }
+    }
+    double ringMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Histories           : " << histories << " x " << perHistory << " transactions" << std::endl;
+    std::cout << "std::deque          : " << dequeMs << " ms (" << sizeof(std::deque<Transaction>)
+              << " bytes + heap chunks each, checksum " << dequeChecksum << ")" << std::endl;
+    std::cout << "RingBuffer          : " << ringMs << " ms (" << sizeof(Account::TransactionHistory)
+              << " bytes inline each, checksum " << ringChecksum << ")" << std::endl;
+    std::cout << "Speedup             : " << dequeMs / ringMs << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "FixedDeposit.h"
+#include "FixedDepositColumns.h"
+#include "ThreadPool.h"
+
+/**
+ * Monthly FD maturity payouts: column projection against a walk over FD objects.
+ *
+ * The object walk visits every heap-allocated FD and asks it for its maturity
+ * date and amount, as a treasury report had to before the FD index existed.
+ * The projection scans the FD columns, once on one thread and once on all cores.
+ *
+ * Usage: MaturityProjectionBenchmark [deposits] [iterations]
+ */
+int main(int argc, char* argv[]) {
+    int deposits = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 5;
+    const size_t months = 36;
+
+    // FDs opened over the last two years, one every few minutes
+    auto now = std::chrono::system_clock::now();
+    FixedDepositColumns columns;
+    std::vector<std::shared_ptr<FixedDeposit>> objects;
+    objects.reserve(deposits);
+    for (int i = 0; i < deposits; ++i) {
+        auto opened = now - std::chrono::seconds(static_cast<int64_t>(i) * 730 * 86400 / deposits);
+        objects.push_back(std::make_shared<FixedDeposit>(Money::fromPaise(100000 + i % 9000000), i % 2 == 0 ? 12 : 24, opened));
+        columns.attach(1001 + i / 4, *objects.back());
+    }
+    int firstMonth = FixedDeposit::monthIndex(now);
+
+    std::vector<Money> objectBuckets;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        objectBuckets.assign(months, Money());
+        for (const auto& fd : objects) {
+            int offset = fd->getMaturityMonth() - firstMonth;
+            if (offset >= 0 && offset < static_cast<int>(months)) {
+                objectBuckets[offset] += fd->calculateMaturityAmount();
+            }
+        }
+    }
+    double objectMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    auto project = [&](size_t threads, MaturityProjection& result) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            result = columns.project(firstMonth, months, threads);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    };
+    size_t threads = ThreadPool::defaultThreadCount();
+    MaturityProjection serial;
+    MaturityProjection parallel;
+    double serialMs = project(1, serial);
+    double parallelMs = project(threads, parallel);
+
+    Money objectTotal;
+    Money columnTotal;
+    for (size_t m = 0; m < months; ++m) {
+        objectTotal += objectBuckets[m];
+        columnTotal += parallel.months[m].payout;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Fixed deposits      : " << deposits << " over " << months << " months" << std::endl;
+    std::cout << "Object walk         : " << objectMs / iterations << " ms (payout " << objectTotal << ")" << std::endl;
+    std::cout << "Projection, 1 thread: " << serialMs / iterations << " ms" << std::endl;
+    std::cout << "Projection, " << std::setw(2) << threads << " thr : " << parallelMs / iterations
+              << " ms (payout " << columnTotal << ")" << std::endl;
+    std::cout << "Speedup             : " << objectMs / parallelMs << "x" << std::endl;
+    return 0;
+}
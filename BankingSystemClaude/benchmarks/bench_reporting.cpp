@@ -0,0 +1,51 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include "AccountColumns.h"
+#include "AccountStore.h"
+
+/**
+ * Bank-wide total balance: column scan against a walk over account objects.
+ *
+ * The object walk visits every account through the store and reads its
+ * balance under the account lock, as a report had to before the columns
+ * existed. The column scan sums the contiguous balance column.
+ *
+ * Usage: ReportingBenchmark [accounts] [iterations]
+ */
+int main(int argc, char* argv[]) {
+    int accounts = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 10;
+    
+    AccountColumns columns;
+    AccountStore store(AccountStore::DEFAULT_STRIPES, 1001, &columns);
+    for (int i = 0; i < accounts; ++i) {
+        store.assign(1001 + i, std::make_shared<Account>(1001 + i, "Holder", "password", Money::rupees(100 + i % 1000)));
+    }
+    
+    Money objectTotal;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        objectTotal = Money();
+        store.forEach([&objectTotal](int, const std::shared_ptr<Account>& account) {
+            objectTotal += account->getBalance();
+        });
+    }
+    double objectMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    Money columnTotal;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        columnTotal = columns.totalBalance();
+    }
+    double columnMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Accounts            : " << accounts << std::endl;
+    std::cout << "Object walk         : " << objectMs / iterations << " ms (total " << objectTotal << ")" << std::endl;
+    std::cout << "Column scan         : " << columnMs / iterations << " ms (total " << columnTotal << ")" << std::endl;
+    std::cout << "Speedup             : " << objectMs / columnMs << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "BankManager.h"
+#include "FileManager.h"
+#include "ThreadPool.h"
+
+/**
+ * Load-time benchmark: text snapshot vs binary snapshot, serial vs parallel,
+ * eager vs lazy (index only).
+ *
+ * Usage: SnapshotLoadBenchmark [accountCount] [iterations] [loadThreads]
+ */
+namespace {
+
+double timeLoad(const std::string& filename, int iterations, size_t threads,
+                BankManager::LoadMode mode = BankManager::LoadMode::EAGER) {
+    double best = 0;
+    for (int i = 0; i < iterations; ++i) {
+        BankManager::resetInstance();
+        BankManager* bank = BankManager::getInstance();
+        bank->setLoadThreads(threads);
+        bank->setLoadMode(mode);
+        
+        auto start = std::chrono::steady_clock::now();
+        bank->loadFromFile(filename);
+        auto end = std::chrono::steady_clock::now();
+        
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (i == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int accountCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 3;
+    size_t threads = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 0;
+    
+    BankManager::resetInstance();
+    BankManager* bank = BankManager::getInstance();
+    for (int i = 0; i < accountCount; ++i) {
+        int accNum = bank->createAccount("Holder " + std::to_string(i), "password", Money::rupees(1000 + i));
+        auto account = bank->getAccount(accNum);
+        account->deposit(Money::rupees(250));
+        account->withdraw(Money::rupees(100));
+        if (i % 4 == 0) {
+            account->openFixedDeposit(Money::rupees(500), (i % 8 == 0) ? 12 : 24);
+        }
+    }
+    bank->saveToFile("bench_snapshot.txt", BankManager::SnapshotFormat::TEXT);
+    bank->saveToFile("bench_snapshot.bin", BankManager::SnapshotFormat::BINARY);
+    
+    double textMs = timeLoad("bench_snapshot.txt", iterations, 1);
+    double binaryMs = timeLoad("bench_snapshot.bin", iterations, 1);
+    double textParallelMs = timeLoad("bench_snapshot.txt", iterations, threads);
+    double binaryParallelMs = timeLoad("bench_snapshot.bin", iterations, threads);
+    double lazyMs = timeLoad("bench_snapshot.bin", iterations, 1, BankManager::LoadMode::LAZY);
+    
+    BankManager::resetInstance();
+    
+    FileManager fileManager;
+    size_t textBytes = fileManager.readFromFile("bench_snapshot.txt").size();
+    size_t binaryBytes = fileManager.readFromFile("bench_snapshot.bin").size();
+    fileManager.deleteFile("bench_snapshot.txt");
+    fileManager.deleteFile("bench_snapshot.bin");
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Accounts              : " << accountCount << std::endl;
+    std::cout << "Load threads          : " << (threads == 0 ? ThreadPool::defaultThreadCount() : threads) << std::endl;
+    std::cout << "Text load (serial)    : " << textMs << " ms (" << textBytes << " bytes)" << std::endl;
+    std::cout << "Text load (parallel)  : " << textParallelMs << " ms" << std::endl;
+    std::cout << "Binary load (serial)  : " << binaryMs << " ms (" << binaryBytes << " bytes)" << std::endl;
+    std::cout << "Binary load (parallel): " << binaryParallelMs << " ms" << std::endl;
+    std::cout << "Binary load (lazy)    : " << lazyMs << " ms" << std::endl;
+    std::cout << "Binary vs text        : " << (binaryMs > 0 ? textMs / binaryMs : 0) << "x" << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Transaction.h"
+
+namespace {
+
+/**
+ * The rendering Transaction::toString used before the cached formatter:
+ * localtime and strftime per row, then a string stream
+ */
+std::string legacyToString(const Transaction& trans) {
+    std::stringstream ss;
+    std::time_t time = std::chrono::system_clock::to_time_t(trans.getTimestamp());
+    std::tm tm{};
+    localtime_r(&time, &tm);
+    char timeStr[100];
+    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &tm);
+
+    std::string typeStr;
+    switch (trans.getType()) {
+        case Transaction::Type::DEPOSIT: typeStr = "DEPOSIT   "; break;
+        case Transaction::Type::WITHDRAWAL: typeStr = "WITHDRAWAL"; break;
+        case Transaction::Type::FD_OPEN: typeStr = "FD OPEN   "; break;
+        case Transaction::Type::FD_MATURITY: typeStr = "FD MATURITY"; break;
+        case Transaction::Type::TRANSFER: typeStr = "TRANSFER  "; break;
+    }
+    ss << timeStr << " | " << typeStr << " | ₹" << trans.getAmount() << " | Balance: ₹" << trans.getBalanceAfter();
+    const std::string& description = trans.getDescription();
+    if (!description.empty()) {
+        ss << " | " << description;
+    }
+    return ss.str();
+}
+
+}
+
+/**
+ * Statement rendering: legacy per-row formatting against the cached formatter.
+ *
+ * Renders the same rows three ways: the old localtime/strftime/stringstream
+ * path, toString() (one string per row) and appendTo() into one reused line
+ * buffer. The last run renders with appendTo() on several threads at once.
+ * Rows are a few minutes apart, as in a busy account's statement.
+ *
+ * Usage: StatementFormatBenchmark [rows] [threads]
+ */
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    std::vector<Transaction> statement;
+    statement.reserve(rows);
+    auto start = std::chrono::system_clock::from_time_t(1700000000);
+    for (int i = 0; i < rows; ++i) {
+        statement.emplace_back(i % 2 == 0 ? Transaction::Type::DEPOSIT : Transaction::Type::WITHDRAWAL,
+                               Money::fromPaise(100 + i % 100000), Money::fromPaise(1000000 + i),
+                               i % 2 == 0 ? DescriptionTable::CASH_DEPOSIT : DescriptionTable::CASH_WITHDRAWAL,
+                               start + std::chrono::seconds(i * 150));
+    }
+
+    auto time = [](auto&& render) {
+        auto begin = std::chrono::steady_clock::now();
+        size_t bytes = render();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        return std::make_pair(ms, bytes);
+    };
+
+    auto legacy = time([&statement]() {
+        size_t bytes = 0;
+        for (const auto& trans : statement) {
+            bytes += legacyToString(trans).size();
+        }
+        return bytes;
+    });
+    auto strings = time([&statement]() {
+        size_t bytes = 0;
+        for (const auto& trans : statement) {
+            bytes += trans.toString().size();
+        }
+        return bytes;
+    });
+    auto appendRows = [&statement](size_t begin, size_t end) {
+        size_t bytes = 0;
+        std::string line;
+        for (size_t i = begin; i < end; ++i) {
+            line.clear();
+            statement[i].appendTo(line);
+            bytes += line.size();
+        }
+        return bytes;
+    };
+    auto buffered = time([&appendRows, &statement]() { return appendRows(0, statement.size()); });
+    auto parallel = time([&appendRows, &statement, threads]() {
+        // Each thread renders one contiguous slice, as separate statement jobs would
+        size_t slice = (statement.size() + threads - 1) / threads;
+        std::vector<size_t> bytes(threads, 0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            size_t begin = std::min(statement.size(), t * slice);
+            size_t end = std::min(statement.size(), begin + slice);
+            workers.emplace_back([&appendRows, &bytes, t, begin, end]() { bytes[t] = appendRows(begin, end); });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        size_t total = 0;
+        for (size_t b : bytes) {
+            total += b;
+        }
+        return total;
+    });
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Rows                : " << rows << std::endl;
+    std::cout << "Legacy toString     : " << legacy.first << " ms (" << legacy.second << " bytes)" << std::endl;
+    std::cout << "toString            : " << strings.first << " ms (" << strings.second << " bytes)" << std::endl;
+    std::cout << "appendTo, 1 buffer  : " << buffered.first << " ms" << std::endl;
+    std::cout << "appendTo, " << threads << " threads : " << parallel.first << " ms (" << parallel.second << " bytes)" << std::endl;
+    std::cout << "Speedup             : " << legacy.first / buffered.first << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BankManager.h"
+
+/**
+ * Parallel transfer throughput.
+ *
+ * Each thread transfers back and forth between accounts in its own block,
+ * and every hundredth transfer crosses into a random other account, so
+ * pairs are mostly disjoint but the ordered-locking path is exercised.
+ *
+ * Usage: TransferBenchmark [accountsPerThread] [transfersPerThread] [maxThreads]
+ */
+namespace {
+
+double runTransfers(BankManager* bank, int firstAccount, int blockSize, int threads, int transfers) {
+    int totalAccounts = blockSize * threads;
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([bank, firstAccount, blockSize, totalAccounts, transfers, t]() {
+            std::mt19937 random(static_cast<unsigned int>(t + 1));
+            std::uniform_int_distribution<int> local(0, blockSize - 1);
+            std::uniform_int_distribution<int> any(0, totalAccounts - 1);
+            int base = firstAccount + t * blockSize;
+            for (int i = 0; i < transfers; ++i) {
+                int from = base + local(random);
+                int to = (i % 100 == 0) ? firstAccount + any(random) : base + local(random);
+                bank->transfer(from, to, Money::rupees(1));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return seconds > 0 ? threads * transfers / seconds : 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int blockSize = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int transfers = argc > 2 ? std::atoi(argv[2]) : 200000;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+    
+    std::cout << "Accounts per thread   : " << blockSize << std::endl;
+    std::cout << "Transfers per thread  : " << transfers << std::endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        BankManager::resetInstance();
+        BankManager* bank = BankManager::getInstance();
+        int firstAccount = bank->getNextAccountNumber();
+        for (int i = 0; i < blockSize * threads; ++i) {
+            bank->createAccount("Holder " + std::to_string(i), "password", Money::rupees(1000000));
+        }
+        
+        double rate = runTransfers(bank, firstAccount, blockSize, threads, transfers);
+        std::cout << std::fixed << std::setprecision(0);
+        std::cout << std::setw(2) << threads << " thread(s)           : " << std::setw(10) << rate
+                  << " transfers/sec" << std::endl;
+    }
+    BankManager::resetInstance();
+    
+    return 0;
+}
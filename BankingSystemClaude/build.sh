@@ -25,13 +25,13 @@ mkdir -p $OBJ_DIR
 
 # Compiler settings
 CXX="g++"
-CXXFLAGS="-std=c++11 -Wall -Wextra -I$INCLUDE_DIR"
+CXXFLAGS="-std=c++17 -pthread -Wall -Wextra -I$INCLUDE_DIR"
 LDFLAGS=""
 
 echo "Step 1: Compiling source files..."
 
 # Compile all source files except main.cpp
-SOURCES="Transaction FixedDeposit Account BankManager FileManager"
+SOURCES="Money Transaction TimestampFormatter DescriptionTable FixedDeposit Account BankManager FileManager Journal ThreadPool AccountStore AccountColumns FixedDepositColumns TransactionIndex TransactionLog MaturityScheduler ConsoleView"
 OBJECTS=""
 
 for src in $SOURCES; do
@@ -1,42 +1,188 @@
 #ifndef ACCOUNT_H
 #define ACCOUNT_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
-#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <future>
+#include <string_view>
 #include "Transaction.h"
 #include "FixedDeposit.h"
+#include "Journal.h"
+#include "BatchOperation.h"
+#include "AccountColumns.h"
+#include "RingBuffer.h"
+
+class TransactionLog;
+class MaturityScheduler;
+
+/**
+ * @brief Outcome of a transfer between two accounts
+ */
+enum class TransferResult {
+    OK,
+    INVALID_AMOUNT,        // Amount is not positive
+    SAME_ACCOUNT,          // Source and destination are the same account
+    ACCOUNT_NOT_FOUND,     // Source or destination does not exist
+    INSUFFICIENT_BALANCE
+};
+
+/**
+ * @brief Human-readable message for a transfer result
+ */
+inline const char* transferResultMessage(TransferResult result) {
+    switch (result) {
+        case TransferResult::OK: return "Transfer successful";
+        case TransferResult::INVALID_AMOUNT: return "Transfer amount must be positive";
+        case TransferResult::SAME_ACCOUNT: return "Cannot transfer to the same account";
+        case TransferResult::ACCOUNT_NOT_FOUND: return "Account not found";
+        case TransferResult::INSUFFICIENT_BALANCE: return "Insufficient balance";
+    }
+    return "Unknown transfer result";
+}
+
+/**
+ * @brief Outcome of a deposit, withdrawal or fixed deposit opening
+ */
+enum class OperationResult {
+    OK,
+    INVALID_AMOUNT,        // Amount is not positive
+    INSUFFICIENT_BALANCE,
+    INVALID_TENURE         // FD tenure is not 12 or 24 months
+};
+
+/**
+ * @brief Human-readable message for an operation result
+ */
+inline const char* operationResultMessage(OperationResult result) {
+    switch (result) {
+        case OperationResult::OK: return "Operation successful";
+        case OperationResult::INVALID_AMOUNT: return "Amount must be positive";
+        case OperationResult::INSUFFICIENT_BALANCE: return "Insufficient balance";
+        case OperationResult::INVALID_TENURE: return "FD tenure must be 12 or 24 months";
+    }
+    return "Unknown operation result";
+}
 
 /**
  * @brief Account class representing a bank account
+ *
+ * Operations and reads that change or inspect the balance, history or fixed
+ * deposits lock the account's own mutex, so different threads may operate on
+ * the same account. getTransactionHistory() and getFixedDeposits() return
+ * references and are only safe while no other thread modifies the account.
+ * Nothing here writes to the console; rendering lives in ConsoleView.
  */
 class Account {
+public:
+    static constexpr size_t MAX_TRANSACTION_HISTORY = 5;
+    // Recent transactions, oldest first
+    using TransactionHistory = RingBuffer<Transaction, MAX_TRANSACTION_HISTORY>;
+
 private:
     int accountNumber;
     std::string accountHolderName;
     std::string passwordHash;  // Stored as hashed password
-    double balance;
-    std::deque<Transaction> transactionHistory;  // Using deque for efficient front/back operations
+    Money balance;
+    TransactionHistory transactionHistory;  // Last MAX_TRANSACTION_HISTORY transactions, stored inline
     std::vector<std::shared_ptr<FixedDeposit>> fixedDeposits;
-    
-    static const size_t MAX_TRANSACTION_HISTORY = 5;
+    Journal* journal;  // Not owned; set by BankManager when journaling is enabled
+    TransactionLog* transactionLog;  // Not owned; receives every transaction when full history is kept
+    MaturityScheduler* maturities;  // Not owned; told about every FD so it is credited when it matures
+    uint64_t version;  // versionClock value at the last modification
+    AccountColumns* columns;  // Not owned; holds the row this account publishes its aggregates to
+    AccountColumns::Cell columnCell;
+    std::vector<FixedDepositColumns::Cell> depositCells;  // Row of each FD in columns, parallel to fixedDeposits
+    mutable std::mutex mutex;  // Guards balance, history, fixed deposits, version and column row
+
+    static std::atomic<uint64_t> versionClock;  // Shared by all accounts; only increases
 
     /**
      * @brief Add transaction to history (maintains only last 5)
      */
-    void addTransaction(Transaction::Type type, double amount, const std::string& desc = "");
+    void addTransaction(Transaction::Type type, Money amount, uint32_t description = DescriptionTable::NONE,
+                        std::chrono::system_clock::time_point when = std::chrono::system_clock::now(),
+                        int counterparty = 0);
+
+    /**
+     * @brief Copy balance and FD aggregates into the attached column row (mutex held)
+     */
+    void publishColumns();
+
+    /**
+     * @brief Add an FD and tell the maturity scheduler and columns about it (mutex held)
+     */
+    void addFixedDeposit(std::shared_ptr<FixedDeposit> fd);
+
+    /**
+     * @brief Remove an FD and release its column row (mutex held)
+     * @return The removed FD
+     */
+    std::shared_ptr<FixedDeposit> removeFixedDeposit(size_t index);
+
+    /**
+     * @brief Sum of the principal of all fixed deposits (mutex held)
+     */
+    Money fixedDepositPrincipal() const;
+
+    /**
+     * @brief Pass the journal's snapshot gate (before taking the mutex); empty without a journal
+     */
+    std::shared_lock<std::shared_mutex> admitOperation() const;
+
+    /**
+     * @brief Append the operation that produced the latest transaction to the journal
+     */
+    void recordOperation(JournalEntry::Operation op, Money amount, int tenure = 0);
+
+    /**
+     * @brief Build the journal entry for the operation that produced the latest transaction
+     */
+    JournalEntry operationEntry(JournalEntry::Operation op, Money amount, int tenure = 0) const;
+
+    /**
+     * @brief Build the FD_MATURITY journal entry for a matured FD
+     */
+    JournalEntry maturityEntry(const FixedDeposit& fd) const;
+
+    /**
+     * @brief Journal the latest operation and return when it becomes durable
+     */
+    std::future<bool> recordOperationDurable(JournalEntry::Operation op, Money amount);
 
     /**
      * @brief Hash password (simple hash for demonstration)
      */
     std::string hashPassword(const std::string& password) const;
 
+    /**
+     * @brief Tag selecting the restore constructor
+     */
+    struct Restored {};
+
+    /**
+     * @brief Constructor for an account restored from storage (hash already computed)
+     *
+     * The version starts at 0: the account is unchanged from what is stored.
+     */
+    Account(Restored, int accNum, std::string_view name, std::string_view hash, Money currentBalance);
+
 public:
     /**
      * @brief Constructor for new account
      */
-    Account(int accNum, const std::string& name, const std::string& pass, double initialBalance);
+    Account(int accNum, const std::string& name, const std::string& pass, Money initialBalance);
+
+    /**
+     * @brief Copy an account (taken under the source account's lock)
+     */
+    Account(const Account& other);
+
+    Account& operator=(const Account&) = delete;
 
     /**
      * @brief Get account number
@@ -48,15 +194,54 @@ public:
      */
     std::string getAccountHolderName() const { return accountHolderName; }
 
+    /**
+     * @brief Get modification stamp
+     *
+     * Every change to the account moves it past all earlier stamps, so an account
+     * changed after a call to currentVersion() has a greater version than it returned.
+     */
+    uint64_t getVersion() const;
+
+    /**
+     * @brief Get latest modification stamp handed out to any account
+     */
+    static uint64_t currentVersion() { return versionClock.load(); }
+
     /**
      * @brief Get current balance
      */
-    double getBalance() const { return balance; }
+    Money getBalance() const;
 
     /**
      * @brief Get transaction history
      */
-    const std::deque<Transaction>& getTransactionHistory() const { return transactionHistory; }
+    const TransactionHistory& getTransactionHistory() const { return transactionHistory; }
+
+    /**
+     * @brief Get number of transactions in the full history
+     *
+     * With a transaction log attached this counts every logged transaction;
+     * otherwise only the recent history kept in memory.
+     */
+    size_t getTransactionCount() const;
+
+    /**
+     * @brief Get a page of the full history, oldest first
+     * @param first Position of the first transaction (0 is the oldest)
+     * @param count Maximum number of transactions to return
+     */
+    std::vector<Transaction> getTransactionPage(size_t first, size_t count) const;
+
+    /**
+     * @brief Get transactions with from <= timestamp < to and a type in typeMask, oldest first
+     *
+     * With a transaction log attached this searches the full history in
+     * O(log n + k) through the account's TransactionIndex.
+     * @param typeMask Bitwise OR of Transaction::maskOf() values to include
+     */
+    std::vector<Transaction> transactionsBetween(std::chrono::system_clock::time_point from,
+                                                 std::chrono::system_clock::time_point to,
+                                                 uint32_t typeMask = Transaction::ALL_TYPES) const;
 
     /**
      * @brief Get fixed deposits
@@ -71,44 +256,130 @@ public:
     /**
      * @brief Deposit money
      * @param amount Amount to deposit (must be positive)
-     * @return true if successful, false otherwise
+     * @return OK, or INVALID_AMOUNT
      */
-    bool deposit(double amount);
+    OperationResult deposit(Money amount);
 
     /**
      * @brief Withdraw money
      * @param amount Amount to withdraw
-     * @return true if successful, false if insufficient balance
+     * @return OK, INVALID_AMOUNT or INSUFFICIENT_BALANCE
+     */
+    OperationResult withdraw(Money amount);
+
+    /**
+     * @brief Deposit money and wait for durability through the returned future
+     *
+     * Applies the deposit immediately. The future becomes
+     * true once the journal has synced the operation (or at once with no journal
+     * attached), and false if the amount is rejected or the sync fails.
      */
-    bool withdraw(double amount);
+    std::future<bool> depositAsync(Money amount);
 
     /**
-     * @brief Display current balance
+     * @brief Withdraw money and wait for durability through the returned future
+     *
+     * Same contract as depositAsync(); the future is false on insufficient balance.
      */
-    void displayBalance() const;
+    std::future<bool> withdrawAsync(Money amount);
 
     /**
-     * @brief Display account details
+     * @brief Apply a run of batch operations on this account in order 
+     *
+     * Holds the account lock once for the whole run and journals the applied
+     * operations with a single flush.
+     * @param operations Whole batch
+     * @param indices Positions in operations that belong to this account, in order
+     * @param results Receives the outcome at each of those positions
+     * @return Number of operations applied
      */
-    void displayAccountDetails() const;
+    size_t applyBatch(const std::vector<BatchOperation>& operations, const std::vector<size_t>& indices,
+                      std::vector<BatchResult>& results);
 
     /**
-     * @brief Display last 5 transactions
+     * @brief Move money between two accounts atomically 
+     *
+     * Both accounts are locked for the whole transfer, in account-number order
+     * unless both locks can be taken without waiting, so opposing transfers
+     * never deadlock. Each side records a TRANSFER transaction, and the transfer
+     * is journaled as a single entry through the source account's journal.
      */
-    void displayTransactionHistory() const;
+    static TransferResult transfer(Account& from, Account& to, Money amount);
 
     /**
      * @brief Open a fixed deposit
      * @param amount FD amount
      * @param tenure Tenure in months (12 or 24)
-     * @return true if successful, false otherwise
+     * @return OK, INVALID_AMOUNT, INVALID_TENURE or INSUFFICIENT_BALANCE
+     */
+    OperationResult openFixedDeposit(Money amount, int tenure);
+
+    /**
+     * @brief Attach the journal that deposits, withdrawals and FD opens are recorded into
+     * @param j Journal (not owned), or nullptr to stop journaling
+     */
+    void setJournal(Journal* j) { journal = j; }
+
+    /**
+     * @brief Attach the log that keeps this account's full transaction history
+     * @param log Transaction log (not owned), or nullptr to keep only recent history
+     */
+    void setTransactionLog(TransactionLog* log) { transactionLog = log; }
+
+    /**
+     * @brief Attach the scheduler that tracks when this account's FDs mature
+     *
+     * Schedules every FD the account holds; FDs opened later are scheduled as
+     * they are opened.
+     * @param scheduler Maturity scheduler (not owned), or nullptr to stop scheduling
      */
-    bool openFixedDeposit(double amount, int tenure);
+    void setMaturityScheduler(MaturityScheduler* scheduler);
 
     /**
-     * @brief Display all fixed deposits
+     * @brief Close every FD that has matured by now and credit its maturity amount
+     *
+     * Each FD is removed and its principal plus interest credited as an
+     * FD_MATURITY transaction stamped with the maturity time, so FDs that
+     * matured while the bank was down are caught up with their true dates.
+     * All matured FDs are credited under one lock and journaled as one batch.
+     * @return Number of FDs credited
      */
-    void displayFixedDeposits() const;
+    size_t creditMaturedDeposits(std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
+
+    /**
+     * @brief Get the earliest maturity among the FDs still open
+     * @return false if the account holds no FDs
+     */
+    bool nextMaturity(std::chrono::system_clock::time_point& when) const;
+
+    /**
+     * @brief Publish this account's balance and FD aggregates to a row of the given columns
+     *
+     * Each open FD also takes a row of the columns' FD index. Releases the
+     * rows held in other columns, if any. Every later change is published to
+     * the rows as part of the operation.
+     */
+    void attachColumns(AccountColumns* target);
+
+    /**
+     * @brief Release this account's rows if they are held in the given columns
+     */
+    void detachColumns(AccountColumns* from);
+
+    /**
+     * @brief Build the CREATE_ACCOUNT journal entry describing this account
+     */
+    JournalEntry creationEntry() const;
+
+    /**
+     * @brief Re-apply a journaled operation during recovery (no validation)
+     */
+    void replay(const JournalEntry& entry);
+
+    /**
+     * @brief Recreate an account from its CREATE_ACCOUNT journal entry
+     */
+    static std::shared_ptr<Account> restore(const JournalEntry& entry);
 
     /**
      * @brief Serialize account to string
@@ -119,6 +390,26 @@ public:
      * @brief Deserialize account from string
      */
     static std::shared_ptr<Account> deserialize(const std::string& data);
+
+    /**
+     * @brief Parse a serialized account block without exceptions or temporaries
+     * @param data Block in serialize() format (views into data are not retained)
+     * @param out Receives the new account (unchanged on error)
+     */
+    static ParseError parse(std::string_view data, std::shared_ptr<Account>& out);
+
+    /**
+     * @brief Append length-prefixed binary account record to a snapshot buffer
+     */
+    void serializeBinary(BinaryWriter& out) const;
+
+    /**
+     * @brief Read one binary account record (including its length prefix)
+     * @param amounts Amount format of the containing snapshot
+     * @param times Transaction timestamp format of the containing snapshot
+     */
+    static std::shared_ptr<Account> deserializeBinary(BinaryReader& in, AmountFormat amounts = AmountFormat::PAISE,
+                                                      TimestampFormat times = TimestampFormat::TICKS);
 };
 
 #endif // ACCOUNT_H
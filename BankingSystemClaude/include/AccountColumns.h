@@ -0,0 +1,130 @@
+#ifndef ACCOUNT_COLUMNS_H
+#define ACCOUNT_COLUMNS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "Money.h"
+#include "FixedDepositColumns.h"
+
+/**
+ * @brief Bank-wide aggregates computed by a column scan
+ */
+struct BalanceSummary {
+    size_t accounts = 0;
+    Money totalBalance;
+    Money minBalance;                  // 0 when there are no accounts
+    Money maxBalance;
+    size_t fixedDeposits = 0;
+    Money totalFdPrincipal;
+    std::vector<Money> bucketBounds;   // Ascending upper bounds (exclusive) of all but the last bucket
+    std::vector<size_t> bucketCounts;  // Accounts per balance bucket (bucketBounds.size() + 1 entries)
+};
+
+/**
+ * @brief Struct-of-arrays copy of every account's balance and FD aggregates
+ *
+ * Rows live in fixed-size chunks of contiguous columns, so bank-wide queries
+ * are linear scans over plain arrays instead of walks over heap-allocated
+ * accounts. Amounts are stored as paise, so the sums are exact integer
+ * additions that vectorize. Accounts attach themselves to a row and publish every change to
+ * it while holding their own lock; a released row is zeroed and reused.
+ *
+ * Writers share a chunk's lock and a scan takes it exclusively, so each
+ * chunk is read in a consistent state. Chunks never move once allocated.
+ */
+class AccountColumns {
+public:
+    static const size_t CHUNK_ROWS = 4096;
+
+    struct Chunk {
+        mutable std::shared_mutex mutex;      // Shared by row writers, exclusive for scans
+        bool occupied[CHUNK_ROWS] = {};       // False for a free row; any account number is valid
+        int accountNumbers[CHUNK_ROWS] = {};
+        int64_t balances[CHUNK_ROWS] = {};    // Paise
+        int64_t fdPrincipal[CHUNK_ROWS] = {};
+        uint32_t fdCounts[CHUNK_ROWS] = {};
+    };
+
+    /**
+     * @brief Position of one account's row
+     */
+    struct Cell {
+        Chunk* chunk = nullptr;
+        size_t row = 0;
+        size_t index = 0;  // chunk number * CHUNK_ROWS + row
+    };
+
+private:
+    mutable std::shared_mutex chunksMutex;  // Guards chunks, freeRows, nextRow and rows
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<size_t> freeRows;
+    size_t nextRow;
+    size_t rows;  // Rows currently attached
+    FixedDepositColumns depositColumns;  // One row per open FD of the attached accounts
+
+    /**
+     * @brief Number of rows of a chunk handed out so far (chunksMutex held)
+     */
+    size_t usedRows(size_t chunk) const;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    AccountColumns();
+
+    AccountColumns(const AccountColumns&) = delete;
+    AccountColumns& operator=(const AccountColumns&) = delete;
+
+    /**
+     * @brief Take a row and fill it with an account's current values
+     */
+    Cell attach(int accountNumber, Money balance, Money fdPrincipal, uint32_t fdCount);
+
+    /**
+     * @brief Overwrite a row with an account's current values
+     */
+    static void publish(const Cell& cell, Money balance, Money fdPrincipal, uint32_t fdCount);
+
+    /**
+     * @brief Zero a row and make it available again
+     */
+    void release(const Cell& cell);
+
+    /**
+     * @brief Number of attached rows
+     */
+    size_t size() const;
+
+    /**
+     * @brief Sum of all balances
+     */
+    Money totalBalance() const;
+
+    /**
+     * @brief Sum of the principal of all fixed deposits
+     */
+    Money totalFdPrincipal() const;
+
+    /**
+     * @brief Scan all columns once for totals, extremes and a balance histogram
+     * @param bucketBounds Ascending upper bounds (exclusive) of the histogram buckets
+     */
+    BalanceSummary summarize(const std::vector<Money>& bucketBounds = {}) const;
+
+    /**
+     * @brief Per-FD columns of the attached accounts
+     */
+    FixedDepositColumns& deposits() { return depositColumns; }
+
+    /**
+     * @brief Per-FD columns of the attached accounts
+     */
+    const FixedDepositColumns& deposits() const { return depositColumns; }
+};
+
+#endif // ACCOUNT_COLUMNS_H
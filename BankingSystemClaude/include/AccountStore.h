@@ -0,0 +1,162 @@
+#ifndef ACCOUNT_STORE_H
+#define ACCOUNT_STORE_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+#include "Account.h"
+
+/**
+ * @brief Concurrent table from account number to account, with lock striping
+ *
+ * Accounts are spread over a fixed number of stripes by account number, each
+ * behind its own reader-writer lock. Lookups on different stripes never
+ * contend, and lookups on the same stripe only contend with inserts into it.
+ * Balance changes are synchronized by the accounts themselves, not by the store.
+ *
+ * Account numbers are handed out sequentially from a base, so each stripe
+ * keeps its accounts in a dense vector indexed by (accountNumber - base) /
+ * stripes: a lookup is one bounds check and one load. Erased accounts leave
+ * an empty slot (a tombstone). Numbers below the base, or so far past the end
+ * of the dense table that growing it would waste memory (e.g. imported
+ * accounts), fall back to a sorted map; the table absorbs them once it grows
+ * to cover their slots.
+ *
+ * A store given AccountColumns attaches every account it holds to a column
+ * row, and releases the row when the account is replaced or removed.
+ */
+class AccountStore {
+public:
+    typedef std::pair<int, std::shared_ptr<Account>> Entry;
+
+    static const size_t DEFAULT_STRIPES = 16;
+    static const size_t MAX_DENSE_GAP = 4096;  // Empty slots a single insert may add to a dense table
+
+private:
+    struct Stripe {
+        mutable std::shared_mutex mutex;
+        std::vector<std::shared_ptr<Account>> dense;     // Slot per number; nullptr = free or erased
+        std::map<int, std::shared_ptr<Account>> sparse;  // Numbers outside the dense table
+        long long first = 0;                             // Account number of dense slot 0
+        size_t live = 0;                                 // Accounts in this stripe
+    };
+
+    std::vector<Stripe> stripes;
+    int base;  // Lowest account number kept in the dense tables
+    AccountColumns* columns;  // Not owned; may be nullptr
+    std::atomic<size_t> count;
+
+    /**
+     * @brief Stripe holding the given account number
+     */
+    Stripe& stripeFor(int accountNumber);
+    const Stripe& stripeFor(int accountNumber) const;
+
+    /**
+     * @brief Dense slot of an account number within its stripe, or -1 if below the base
+     */
+    long long slotOf(int accountNumber) const;
+
+    /**
+     * @brief Stored pointer for an account number, or nullptr if it has no slot (stripe locked)
+     */
+    const std::shared_ptr<Account>* lookup(const Stripe& stripe, int accountNumber) const;
+
+    /**
+     * @brief Slot for storing an account number, created if missing (stripe write-locked)
+     *
+     * Extends the dense table when the gap is small enough, otherwise uses the sparse map.
+     */
+    std::shared_ptr<Account>& slotFor(Stripe& stripe, int accountNumber);
+
+    /**
+     * @brief Grow a stripe's dense table and move sparse entries it now covers (stripe write-locked)
+     */
+    void growDense(Stripe& stripe, size_t slots);
+
+public:
+    /**
+     * @brief Constructor
+     * @param stripeCount Number of independently locked stripes (at least 1)
+     * @param firstAccountNumber Account number the dense tables start at
+     * @param accountColumns Columns kept in step with the stored accounts (not owned, optional)
+     */
+    explicit AccountStore(size_t stripeCount = DEFAULT_STRIPES, int firstAccountNumber = 0,
+                          AccountColumns* accountColumns = nullptr);
+
+    /**
+     * @brief Destructor - releases the column rows of the stored accounts
+     */
+    ~AccountStore();
+
+    AccountStore(const AccountStore&) = delete;
+    AccountStore& operator=(const AccountStore&) = delete;
+
+    /**
+     * @brief Find an account
+     * @return The account, or nullptr if it is not in the store
+     */
+    std::shared_ptr<Account> find(int accountNumber) const;
+
+    /**
+     * @brief Check if an account is in the store
+     */
+    bool contains(int accountNumber) const;
+
+    /**
+     * @brief Insert an account unless one with the same number is already present
+     * @param account Account to insert; replaced by the stored account if one was present
+     * @return true if the account was inserted
+     */
+    bool insert(int accountNumber, std::shared_ptr<Account>& account);
+
+    /**
+     * @brief Insert an account, replacing any account with the same number
+     */
+    void assign(int accountNumber, std::shared_ptr<Account> account);
+
+    /**
+     * @brief Remove an account, leaving a tombstone in its dense slot
+     * @return true if the account was present
+     */
+    bool erase(int accountNumber);
+
+    /**
+     * @brief Get number of accounts in the store
+     */
+    size_t size() const { return count.load(); }
+
+    /**
+     * @brief Check if the store is empty
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Get number of accounts held in the sparse fallback maps
+     */
+    size_t sparseSize() const;
+
+    /**
+     * @brief Remove all accounts
+     */
+    void clear();
+
+    /**
+     * @brief Visit every account, one stripe at a time (not in account-number order)
+     *
+     * The visited stripe is read-locked; visit must not insert into the store.
+     */
+    void forEach(const std::function<void(int, const std::shared_ptr<Account>&)>& visit) const;
+
+    /**
+     * @brief Get accounts in account-number order
+     * @param filter Optional predicate on the account number selecting which accounts to return
+     */
+    std::vector<Entry> sorted(const std::function<bool(int)>& filter = nullptr) const;
+};
+
+#endif // ACCOUNT_STORE_H
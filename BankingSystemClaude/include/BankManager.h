@@ -1,22 +1,230 @@
 #ifndef BANK_MANAGER_H
 #define BANK_MANAGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <istream>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include "Account.h"
+#include "AccountStore.h"
+#include "BatchOperation.h"
+#include "Journal.h"
+#include "MaturityScheduler.h"
+#include "FileManager.h"
+#include "TransactionLog.h"
+
+/**
+ * @brief Outcome of creating an account or logging in
+ */
+enum class BankResult {
+    OK,
+    EMPTY_NAME,         // Account holder name is empty
+    SHORT_PASSWORD,     // Password has fewer than 4 characters
+    NEGATIVE_BALANCE,   // Initial balance is negative
+    ACCOUNT_NOT_FOUND,
+    INVALID_PASSWORD
+};
+
+/**
+ * @brief Human-readable message for a bank result
+ */
+inline const char* bankResultMessage(BankResult result) {
+    switch (result) {
+        case BankResult::OK: return "OK";
+        case BankResult::EMPTY_NAME: return "Account holder name cannot be empty";
+        case BankResult::SHORT_PASSWORD: return "Password must be at least 4 characters long";
+        case BankResult::NEGATIVE_BALANCE: return "Initial balance cannot be negative";
+        case BankResult::ACCOUNT_NOT_FOUND: return "Account not found";
+        case BankResult::INVALID_PASSWORD: return "Invalid password";
+    }
+    return "Unknown result";
+}
 
 /**
  * @brief BankManager class - Singleton pattern
  * Manages all bank accounts and operations
+ *
+ * Nothing here writes to the console: operations return result codes, and
+ * problems met while loading or saving are collected for takeDiagnostics().
  */
 class BankManager {
+public:
+    /**
+     * @brief On-disk encodings supported by saveToFile/loadFromFile
+     */
+    enum class SnapshotFormat {
+        TEXT,   // Line-oriented NEXT_ACCOUNT / ACCOUNT_START format
+        BINARY  // Versioned, length-prefixed binary format
+    };
+
+    /**
+     * @brief How loadFromFile brings accounts into memory
+     */
+    enum class LoadMode {
+        EAGER,  // Deserialize every account up front
+        LAZY    // Map the file, index account offsets, deserialize on first access
+    };
+
+    static const uint32_t BINARY_SNAPSHOT_VERSION = 5;
+    static const int FIRST_ACCOUNT_NUMBER = 1001;  // Numbers are handed out sequentially from here
+
+    /**
+     * @brief Work done by one saveToFile call
+     */
+    struct SaveStats {
+        size_t shards = 0;              // Files in the snapshot layout
+        size_t shardsWritten = 0;
+        size_t accountsSerialized = 0;  // Changed (or never cached) accounts encoded afresh
+        size_t accountsReused = 0;      // Copied from the record cache or the mapped snapshot
+        size_t bytesWritten = 0;
+        double milliseconds = 0;
+    };
+
+    /**
+     * @brief What one loadFromFile call found
+     */
+    struct LoadStats {
+        bool fileFound = false;  // false: no snapshot yet, starting fresh
+        bool indexed = false;    // Accounts were indexed for lazy loading rather than decoded
+        size_t files = 0;        // Snapshot files read (shards)
+        size_t accounts = 0;     // Accounts loaded or indexed
+        size_t replayed = 0;     // Journal operations replayed on top
+    };
+
 private:
     static std::unique_ptr<BankManager> instance;
     static std::mutex mutex_;
 
-    std::map<int, std::shared_ptr<Account>> accounts;
+    AccountColumns columns;  // Balances and FD aggregates of the materialized accounts, for reports
+    AccountStore accounts;   // Materialized accounts
     int nextAccountNumber;
+    std::mutex creationMutex;  // Serializes account-number allocation
+    
+    std::unique_ptr<Journal> journal;
+    std::unique_ptr<TransactionLog> transactionLog;  // Full history of every account, when enabled
+    MaturityScheduler maturities;  // FD maturities of the materialized accounts
+    uint64_t checkpointLsn;       // Last journal LSN reflected in the loaded/saved snapshot
+    size_t checkpointInterval;    // Journal entries between automatic checkpoints
+    std::chrono::microseconds commitDelay;  // Group-commit window applied to the journal
+    size_t commitBatch;                     // Callers that close a group-commit window early
+    size_t loadThreads;           // Worker threads used by loadFromFile (0 = hardware concurrency)
+    size_t loadBufferSize;        // Streaming buffer used by loadFromFile
+    LoadMode loadMode;
+    size_t shardCount;            // Shard files written by saveToFile (1 = single file)
+
+    /**
+     * @brief Locates one account record inside a snapshot file
+     *
+     * Binary snapshots (version 3+) store a sorted array of these after the
+     * records; the array is searched in place through the file mapping.
+     */
+    struct SnapshotIndexEntry {
+        int32_t accountNumber;
+        uint32_t length;   // Record length in bytes (binary records include their prefix)
+        uint64_t offset;   // Record offset from the start of the file
+    };
+
+    /**
+     * @brief Memory-mapped snapshot backing accounts that have not been materialized
+     */
+    struct LazySnapshot {
+        std::unique_ptr<FileManager::MappedFile> file;
+        std::string filename;
+        SnapshotFormat format;
+        AmountFormat amounts;                         // Of binary records
+        TimestampFormat times;                        // Of binary records
+        const char* index;                            // Sorted SnapshotIndexEntry array
+        size_t indexSize;
+        std::vector<SnapshotIndexEntry> ownedIndex;   // Built by scanning files without an index
+
+        SnapshotIndexEntry entryAt(size_t i) const;
+        std::string_view recordAt(size_t i) const;
+        bool find(int accountNumber, size_t& position) const;
+    };
+
+    /**
+     * @brief Last encoded form of an account, valid while its version is unchanged
+     */
+    struct CachedRecord {
+        uint64_t version = 0;
+        SnapshotFormat format = SnapshotFormat::TEXT;
+        std::string data;
+    };
+
+    /**
+     * @brief Persistence state of one shard file
+     *
+     * Accounts belong to shard (accountNumber % shards.size()). Each shard owns
+     * its record cache so shards can be encoded concurrently.
+     */
+    struct ShardState {
+        std::shared_ptr<const LazySnapshot> snapshot;  // Unmaterialized accounts (lazy loads only)
+        std::unordered_map<int, CachedRecord> records;  // Encoded materialized accounts
+        uint64_t checkpointLsn = 0;              // Journal LSN covered by the shard's file
+        uint64_t savedVersion = 0;               // Account::currentVersion() when last read/written
+        bool damaged = false;                    // File could not be loaded
+    };
+
+    std::vector<ShardState> shards;   // Layout of the snapshot last loaded or saved
+    std::string shardSource;          // Snapshot file the shard states describe
+    SnapshotFormat shardFormat;       // Encoding of that snapshot
+    std::atomic<size_t> materializedFromSnapshot;  // Indexed accounts already present in the map
+    SaveStats lastSaveStats;
+    LoadStats lastLoadStats;
+    std::mutex diagnosticsMutex;
+    std::vector<std::string> diagnostics;  // Problems not yet collected by takeDiagnostics()
+
+    /**
+     * @brief Work handed to the background snapshot thread
+     *
+     * Holds private copies of the accounts changed since the previous request,
+     * so the interactive thread can keep modifying the originals.
+     */
+    struct SnapshotRequest {
+        std::string filename;
+        SnapshotFormat format = SnapshotFormat::TEXT;
+        size_t shardCount = 1;
+        int nextAccountNumber = 0;
+        uint64_t checkpointLsn = 0;
+        bool reset = false;                // Rebuild the writer from the shard states below
+        std::vector<ShardState> shards;    // Metadata and mapped snapshots only (reset requests)
+        std::string shardSource;
+        SnapshotFormat shardFormat = SnapshotFormat::TEXT;
+        std::map<int, std::shared_ptr<Account>> accounts;
+    };
+
+    bool backgroundSnapshots;              // checkpoint()/checkpointIfDue() use the snapshot thread
+    std::unique_ptr<BankManager> snapshotWriter;  // Copy-on-write view; only the snapshot thread touches it
+    std::thread snapshotThread;
+    mutable std::mutex snapshotMutex;
+    std::condition_variable snapshotCondition;
+    std::unique_ptr<SnapshotRequest> pendingSnapshot;  // Guarded by snapshotMutex; bursts merge here
+    bool snapshotRunning;                  // Guarded by snapshotMutex
+    bool stopSnapshots;                    // Guarded by snapshotMutex
+    bool lastSnapshotOk;                   // Guarded by snapshotMutex
+    size_t snapshotsWritten;               // Guarded by snapshotMutex
+    uint64_t completedSnapshotLsn;         // Guarded by snapshotMutex
+    SaveStats completedSaveStats;          // Guarded by snapshotMutex; last background save
+    uint64_t handedOffVersion;             // Account::currentVersion() at the last request
+    bool snapshotNeedsReset;               // Next request must carry the full account set
+    uint64_t discardedLsn;                 // Journal entries up to here have been dropped
+
+    /**
+     * @brief Result of decoding one account record on a loader worker
+     */
+    struct DecodedAccount {
+        std::shared_ptr<Account> account;
+        std::string error;  // Non-empty if the record could not be decoded
+    };
 
     // Private constructor for Singleton
     BankManager();
@@ -25,49 +233,469 @@ private:
     BankManager(const BankManager&) = delete;
     BankManager& operator=(const BankManager&) = delete;
 
+    /**
+     * @brief Encode one shard's accounts in the text snapshot format
+     */
+    std::string encodeText(size_t shard, SaveStats& stats);
+
+    /**
+     * @brief Encode one shard's accounts in the binary snapshot format
+     */
+    std::string encodeBinary(size_t shard, SaveStats& stats);
+
+    /**
+     * @brief Encoded account record, re-encoded only if the account changed since it was cached
+     */
+    const std::string& encodedRecord(size_t shard, const Account& account, SnapshotFormat format,
+                                     SaveStats& stats);
+
+    /**
+     * @brief Stream a text snapshot into the account map, one buffer of blocks at a time
+     */
+    bool decodeText(FileManager::BlockReader& reader);
+
+    /**
+     * @brief Stream a binary snapshot into the account map, one buffer of records at a time
+     */
+    bool decodeBinary(FileManager::BlockReader& reader);
+
+    /**
+     * @brief Decode count account records on a worker pool
+     * @param decodeOne Decodes record i (may throw)
+     * @return Results in record order
+     */
+    std::vector<DecodedAccount> decodeAccounts(size_t count,
+        const std::function<std::shared_ptr<Account>(size_t)>& decodeOne) const;
+
+    /**
+     * @brief Map a snapshot and index its records without deserializing them
+     * @param next Receives the snapshot's next account number
+     * @param lsn Receives the snapshot's checkpoint LSN
+     * @return Mapped snapshot, or nullptr if the file is unreadable or corrupt
+     */
+    std::unique_ptr<LazySnapshot> mapSnapshot(const std::string& filename, int& next, uint64_t& lsn);
+
+    /**
+     * @brief Load a single snapshot file (either mode) into this instance, without the journal
+     */
+    bool loadSnapshot(const std::string& filename);
+
+    /**
+     * @brief Load every shard file in parallel and merge them
+     * @return false if any shard could not be loaded (the others are still merged)
+     */
+    bool loadShards(const std::vector<std::string>& files);
+
+    /**
+     * @brief Read a shard manifest
+     * @return false if filename is not a manifest
+     */
+    static bool readShardManifest(const std::string& filename, size_t& count, int& next);
+
+    /**
+     * @brief Name of one shard file of a sharded snapshot
+     */
+    static std::string shardFileName(const std::string& filename, size_t shard);
+
+    /**
+     * @brief Shard an account belongs to in the current layout
+     */
+    size_t shardOf(int accountNumber) const {
+        return static_cast<size_t>(accountNumber) % shards.size();
+    }
+
+    /**
+     * @brief Switch to a new shard layout, materializing any lazily loaded accounts
+     */
+    void reshard(size_t count);
+
+    /**
+     * @brief Deserialize every account still only in a lazy snapshot
+     */
+    void materializeAll();
+
+    /**
+     * @brief Recount map accounts that shadow a lazy snapshot record
+     */
+    void countMaterialized();
+
+    /**
+     * @brief Worker threads to use for load/save work
+     */
+    size_t workerCount() const;
+
+    /**
+     * @brief Deserialize one record taken from a snapshot of the given format
+     */
+    static std::shared_ptr<Account> decodeRecord(std::string_view record, SnapshotFormat format,
+                                                 AmountFormat amounts = AmountFormat::PAISE,
+                                                 TimestampFormat times = TimestampFormat::TICKS);
+
+    /**
+     * @brief Look up an account, materializing it from the lazy snapshot if needed
+     */
+    std::shared_ptr<Account> findAccount(int accountNumber);
+
+    /**
+     * @brief Visit every account of one shard in account-number order
+     *
+     * Materialized accounts are passed as objects; accounts still only in the
+     * shard's lazy snapshot are passed as their raw record.
+     */
+    void forEachAccount(size_t shard,
+        const std::function<void(int, const std::shared_ptr<Account>&, std::string_view)>& visit) const;
+
+    /**
+     * @brief Snapshot thread body: write requests until stopped and drained
+     */
+    void snapshotLoop();
+
+    /**
+     * @brief Apply a request to the writer instance and save it (snapshot thread)
+     */
+    bool writeSnapshot(const SnapshotRequest& request);
+
+    /**
+     * @brief Record a problem for takeDiagnostics() (thread-safe)
+     */
+    void report(std::string message);
+
+    /**
+     * @brief Drop journal entries covered by finished background snapshots
+     */
+    void collectSnapshots();
+
+    /**
+     * @brief Stop the snapshot thread after it has written any pending request
+     */
+    void stopSnapshotThread();
+
+    /**
+     * @brief Apply journal entries newer than the snapshot's checkpoint LSN
+     * @return Number of entries replayed
+     */
+    size_t replayJournal();
+
 public:
     /**
      * @brief Get singleton instance
      */
     static BankManager* getInstance();
 
+    /**
+     * @brief Destructor - finishes queued snapshots and detaches the journal from
+     * any accounts still referenced elsewhere
+     */
+    ~BankManager();
+
     /**
      * @brief Create a new account
-     * @return Account number of newly created account
+     * @param result Optional; receives why creation failed (or OK)
+     * @return Account number of newly created account, or -1 if the details are invalid
      */
-    int createAccount(const std::string& name, const std::string& password, double initialBalance);
+    int createAccount(const std::string& name, const std::string& password, Money initialBalance,
+                      BankResult* result = nullptr);
+
+    /**
+     * @brief Check new-account details without creating anything
+     */
+    static BankResult validateNewAccount(const std::string& name, const std::string& password,
+                                         Money initialBalance);
 
     /**
      * @brief Login to account
+     * @param result Optional; receives why login failed (or OK)
      * @return Shared pointer to account if successful, nullptr otherwise
      */
-    std::shared_ptr<Account> login(int accountNumber, const std::string& password);
+    std::shared_ptr<Account> login(int accountNumber, const std::string& password,
+                                   BankResult* result = nullptr);
 
     /**
      * @brief Get account by account number (for admin/testing)
      */
     std::shared_ptr<Account> getAccount(int accountNumber);
 
+    /**
+     * @brief Transfer money between two accounts atomically (no console output)
+     *
+     * Safe to call from many threads; transfers between disjoint account pairs
+     * do not contend. See Account::transfer.
+     */
+    TransferResult transfer(int fromAccount, int toAccount, Money amount);
+
+    /**
+     * @brief Apply a batch of deposits and withdrawals (no console output)
+     *
+     * Operations are grouped by account; groups run on a worker pool and each
+     * group is applied in input order under one account lock, so the result of
+     * every operation is the same as applying the batch sequentially.
+     * @return Result for each operation plus aggregate counts and timing
+     */
+    BatchReport applyBatch(const std::vector<BatchOperation>& operations);
+
+    /**
+     * @brief Parse and apply a CSV batch of "type,account,amount" lines
+     *
+     * type is DEPOSIT/D or WITHDRAWAL/W. Blank lines and a leading
+     * "type,account,amount" header are skipped; other malformed lines get
+     * BatchResult::PARSE_ERROR at their position in the results.
+     */
+    BatchReport applyBatch(std::istream& csv);
+
+    /**
+     * @brief Parse one CSV batch line
+     * @return false if the line is malformed
+     */
+    static bool parseBatchLine(std::string_view line, BatchOperation& op);
+
     /**
      * @brief Check if account exists
      */
     bool accountExists(int accountNumber) const;
 
     /**
-     * @brief Get total number of accounts
+     * @brief Get total number of accounts (including ones not yet materialized)
+     */
+    size_t getAccountCount() const;
+
+    /**
+     * @brief Get number of accounts currently deserialized in memory
+     */
+    size_t getMaterializedCount() const { return accounts.size(); }
+
+    /**
+     * @brief Get sum of all account balances
+     *
+     * Reports scan contiguous columns rather than the account objects. Lazily
+     * loaded accounts are materialized first, so the first report after a lazy
+     * load pays for deserializing them. Operations may run concurrently; each
+     * block of accounts is then read in a consistent state, but the report as a
+     * whole is not a point-in-time snapshot.
+     */
+    Money getTotalBalance();
+
+    /**
+     * @brief Get sum of the principal of all fixed deposits
+     */
+    Money getTotalFdPrincipal();
+
+    /**
+     * @brief Get bank-wide totals, balance extremes and a balance distribution
+     * @param bucketBounds Ascending upper bounds (exclusive) of the balance buckets
+     */
+    BalanceSummary getBalanceSummary(const std::vector<Money>& bucketBounds = {});
+
+    /**
+     * @brief Get the payout of the open FDs falling due in each coming month
+     *
+     * Scans the FD index of the columns on workerCount() threads. Open FDs
+     * whose maturity month is before the month containing from are reported
+     * as overdue; those that matured earlier in that month but have not been
+     * credited yet fall in months[0].
+     * @param months Number of monthly buckets, starting with the month containing from
+     * @param from Start of the projection
      */
-    size_t getAccountCount() const { return accounts.size(); }
+    MaturityProjection projectMaturities(size_t months,
+                                         std::chrono::system_clock::time_point from = std::chrono::system_clock::now());
 
     /**
      * @brief Save all accounts to file
+     *
+     * With more than one shard, filename becomes a small manifest and the
+     * accounts are written to filename.shard<N> files in parallel. Shard files
+     * whose accounts have not changed since they were last loaded or saved are
+     * not rewritten.
+     * @param format Snapshot encoding (text by default)
      */
-    bool saveToFile(const std::string& filename);
+    bool saveToFile(const std::string& filename, SnapshotFormat format = SnapshotFormat::TEXT);
 
     /**
-     * @brief Load all accounts from file
+     * @brief Load all accounts from file (format and sharding are detected from the file)
      */
     bool loadFromFile(const std::string& filename);
 
+    /**
+     * @brief Detect the encoding of an existing snapshot file
+     */
+    static SnapshotFormat detectFormat(std::string_view data);
+
+    /**
+     * @brief Convert a snapshot file from one format to another
+     * @param source Existing snapshot (either format)
+     * @param destination File to write
+     * @param format Encoding of the destination file
+     * @param shards Shard files to split the destination into
+     * @param diagnostics Optional; receives messages describing any failure
+     */
+    static bool convertSnapshot(const std::string& source, const std::string& destination,
+                                SnapshotFormat format, size_t shards = 1,
+                                std::vector<std::string>* diagnostics = nullptr);
+
+    /**
+     * @brief Record every operation in an append-only journal in the data directory
+     *
+     * Call before loadFromFile so that recovery replays the journal tail on
+     * top of the snapshot.
+     */
+    bool enableJournal(const std::string& filename);
+
+    /**
+     * @brief Keep the full transaction history of every account in a segmented log
+     *
+     * Accounts still keep their recent transactions in memory; every
+     * transaction made from now on is also appended to the log, and
+     * Account::getTransactionPage()/transactionsBetween() read from it.
+     * Call before loadFromFile so that journal replay does not log again
+     * what the log already holds.
+     * @param name Base name of the segment files in the data directory
+     * @param segmentBytes Size at which a segment is sealed and a new one started
+     */
+    bool enableTransactionLog(const std::string& name,
+                              size_t segmentBytes = TransactionLog::DEFAULT_SEGMENT_BYTES);
+
+    /**
+     * @brief Get the transaction log, or nullptr if full history is not kept
+     */
+    const TransactionLog* getTransactionLog() const { return transactionLog.get(); }
+
+    /**
+     * @brief Credit every fixed deposit that has matured by now
+     *
+     * Takes the due entries off the maturity schedule and credits each
+     * affected account's matured FDs in one batch (see
+     * Account::creditMaturedDeposits), so FDs that matured while the bank
+     * was down are caught up with their maturity dates. An account that
+     * still holds FDs afterwards is queued again at its earliest remaining
+     * maturity. Accounts still only in a lazy snapshot join the schedule
+     * when first accessed.
+     * @return Number of FDs credited
+     */
+    size_t creditMaturedDeposits(std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
+
+    /**
+     * @brief Get the schedule of upcoming FD maturities
+     */
+    const MaturityScheduler& getMaturityScheduler() const { return maturities; }
+
+    /**
+     * @brief Fold the journal into a snapshot and reset the journal
+     */
+    bool checkpoint(const std::string& filename, SnapshotFormat format = SnapshotFormat::TEXT);
+
+    /**
+     * @brief Checkpoint once the journal holds checkpointInterval entries
+     *
+     * With background snapshots the checkpoint is only queued, and skipped while
+     * an earlier one is still being written.
+     * @return true if a checkpoint was written or queued
+     */
+    bool checkpointIfDue(const std::string& filename, SnapshotFormat format = SnapshotFormat::TEXT);
+
+    /**
+     * @brief Queue a snapshot to be written by the background snapshot thread
+     *
+     * Only accounts changed since the previous request are copied; the thread
+     * encodes and writes from those copies while operations continue. Requests
+     * made while a snapshot is queued are merged into it.
+     */
+    void requestSnapshot(const std::string& filename, SnapshotFormat format = SnapshotFormat::TEXT);
+
+    /**
+     * @brief Block until every requested snapshot has been written
+     * @return true if the most recent snapshot was written successfully
+     */
+    bool waitForSnapshots();
+
+    /**
+     * @brief Route checkpoint()/checkpointIfDue() through the background snapshot thread
+     */
+    void setBackgroundSnapshots(bool enabled) { backgroundSnapshots = enabled; }
+
+    /**
+     * @brief Get number of background snapshots actually written
+     */
+    size_t getSnapshotsWritten() const;
+
+    /**
+     * @brief Set number of journaled operations between automatic checkpoints
+     */
+    void setCheckpointInterval(size_t operations) { checkpointInterval = operations; }
+
+    /**
+     * @brief Set how long a durable journal commit waits for other callers to join it
+     *
+     * Applies to depositAsync()/withdrawAsync(); takes effect on the current
+     * journal and any journal enabled later.
+     */
+    void setCommitDelay(std::chrono::microseconds delay);
+
+    /**
+     * @brief Set how many waiting callers end a commit window before its delay expires
+     */
+    void setCommitBatch(size_t callers);
+
+    /**
+     * @brief Get number of group commits (journal syncs) made so far, 0 without a journal
+     */
+    size_t getJournalCommits() const { return journal ? journal->getCommitCount() : 0; }
+
+    /**
+     * @brief Set number of worker threads used to load snapshots and write shards
+     * @param threads Thread count (0 = hardware concurrency, 1 = load serially)
+     */
+    void setLoadThreads(size_t threads) { loadThreads = threads; }
+
+    /**
+     * @brief Select eager or lazy loading for subsequent loadFromFile calls
+     */
+    void setLoadMode(LoadMode mode) { loadMode = mode; }
+
+    /**
+     * @brief Set number of shard files written by saveToFile (1 = single file)
+     */
+    void setShardCount(size_t count) { shardCount = count == 0 ? 1 : count; }
+
+    /**
+     * @brief Get configured number of shard files
+     */
+    size_t getShardCount() const { return shardCount; }
+
+    /**
+     * @brief Set streaming buffer size for loadFromFile
+     *
+     * Peak memory while loading is roughly this buffer plus the loaded accounts,
+     * independent of the file size.
+     */
+    void setLoadBufferSize(size_t bytes) { loadBufferSize = bytes; }
+
+    /**
+     * @brief Get configured number of load threads
+     */
+    size_t getLoadThreads() const { return loadThreads; }
+
+    /**
+     * @brief Get the cost breakdown of the most recent save
+     *
+     * Background snapshots are reflected once collected (by checkpoint() or
+     * checkpointIfDue()).
+     */
+    const SaveStats& getLastSaveStats() const { return lastSaveStats; }
+
+    /**
+     * @brief Get what the most recent loadFromFile call found
+     */
+    const LoadStats& getLastLoadStats() const { return lastLoadStats; }
+
+    /**
+     * @brief Take the messages about failures and skipped records reported since the last call
+     */
+    std::vector<std::string> takeDiagnostics();
+
+    /**
+     * @brief Get journal LSN covered by the current snapshot
+     */
+    uint64_t getCheckpointLsn() const { return checkpointLsn; }
+
     /**
      * @brief Get next account number (for testing)
      */
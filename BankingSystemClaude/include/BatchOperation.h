@@ -0,0 +1,60 @@
+#ifndef BATCH_OPERATION_H
+#define BATCH_OPERATION_H
+
+#include <cstddef>
+#include <vector>
+#include "Money.h"
+
+/**
+ * @brief One deposit or withdrawal in a bulk batch
+ */
+struct BatchOperation {
+    enum class Type {
+        DEPOSIT,
+        WITHDRAWAL
+    };
+
+    Type type = Type::DEPOSIT;
+    int accountNumber = 0;
+    Money amount;
+};
+
+/**
+ * @brief Outcome of one operation in a batch
+ */
+enum class BatchResult {
+    OK,
+    INVALID_AMOUNT,        // Amount is not positive
+    INSUFFICIENT_BALANCE,  // Withdrawal exceeds the balance at that point in the batch
+    ACCOUNT_NOT_FOUND,
+    PARSE_ERROR            // CSV line could not be parsed
+};
+
+/**
+ * @brief Human-readable message for a batch result
+ */
+inline const char* batchResultMessage(BatchResult result) {
+    switch (result) {
+        case BatchResult::OK: return "OK";
+        case BatchResult::INVALID_AMOUNT: return "Amount must be positive";
+        case BatchResult::INSUFFICIENT_BALANCE: return "Insufficient balance";
+        case BatchResult::ACCOUNT_NOT_FOUND: return "Account not found";
+        case BatchResult::PARSE_ERROR: return "Malformed operation";
+    }
+    return "Unknown result";
+}
+
+/**
+ * @brief Per-operation results and aggregate figures for one applied batch
+ */
+struct BatchReport {
+    std::vector<BatchResult> results;  // One per operation, in input order
+    size_t applied = 0;
+    size_t rejected = 0;
+    size_t accounts = 0;               // Distinct accounts touched
+    size_t threads = 0;                // Workers used to apply the groups
+    double parseMilliseconds = 0;      // CSV parsing (0 for vector input)
+    double applyMilliseconds = 0;
+};
+
+#endif // BATCH_OPERATION_H
@@ -0,0 +1,148 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "Money.h"
+
+/**
+ * @brief Appends fixed-width little-endian values to a byte buffer
+ *
+ * Values are copied with memcpy in host byte order; the snapshot format
+ * is defined as little-endian, which matches every platform we build on.
+ */
+class BinaryWriter {
+private:
+    std::string& out;
+
+    template <typename T>
+    void writeRaw(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+public:
+    explicit BinaryWriter(std::string& buffer) : out(buffer) {}
+
+    void writeU8(uint8_t value) { writeRaw(value); }
+    void writeU16(uint16_t value) { writeRaw(value); }
+    void writeU32(uint32_t value) { writeRaw(value); }
+    void writeI32(int32_t value) { writeRaw(value); }
+    void writeI64(int64_t value) { writeRaw(value); }
+    void writeF64(double value) { writeRaw(value); }
+
+    /**
+     * @brief Write an amount as i64 paise
+     */
+    void writeMoney(Money value) { writeI64(value.toPaise()); }
+
+    /**
+     * @brief Write raw bytes without a length prefix
+     */
+    void writeBytes(const char* data, size_t size) { out.append(data, size); }
+
+    /**
+     * @brief Current size of the underlying buffer
+     */
+    size_t position() const { return out.size(); }
+
+    /**
+     * @brief Overwrite a previously reserved 32-bit slot (used for length prefixes)
+     */
+    void patchU32(size_t offset, uint32_t value) {
+        std::memcpy(&out[offset], &value, sizeof(value));
+    }
+
+    /**
+     * @brief Overwrite a previously reserved 64-bit slot
+     */
+    void patchI64(size_t offset, int64_t value) {
+        std::memcpy(&out[offset], &value, sizeof(value));
+    }
+};
+
+/**
+ * @brief Reads fixed-width little-endian values from a byte range
+ *
+ * Throws std::runtime_error when a read would run past the end of the range.
+ */
+class BinaryReader {
+private:
+    const char* cur;
+    const char* end;
+
+    template <typename T>
+    T readRaw() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, cur, sizeof(T));
+        cur += sizeof(T);
+        return value;
+    }
+
+public:
+    BinaryReader(const char* data, size_t size) : cur(data), end(data + size) {}
+
+    uint8_t readU8() { return readRaw<uint8_t>(); }
+    uint16_t readU16() { return readRaw<uint16_t>(); }
+    uint32_t readU32() { return readRaw<uint32_t>(); }
+    int32_t readI32() { return readRaw<int32_t>(); }
+    int64_t readI64() { return readRaw<int64_t>(); }
+    double readF64() { return readRaw<double>(); }
+
+    /**
+     * @brief Read an amount stored in the given format
+     */
+    Money readMoney(AmountFormat format) {
+        if (format == AmountFormat::PAISE) {
+            return Money::fromPaise(readI64());
+        }
+        Money amount;
+        if (!Money::fromRupees(readF64(), amount)) {
+            throw std::runtime_error("Amount out of range");
+        }
+        return amount;
+    }
+
+    /**
+     * @brief Read a string of the given length
+     */
+    std::string readString(size_t size) {
+        require(size);
+        std::string value(cur, size);
+        cur += size;
+        return value;
+    }
+
+    /**
+     * @brief Pointer to the next unread byte
+     */
+    const char* data() const { return cur; }
+
+    /**
+     * @brief Number of unread bytes
+     */
+    size_t remaining() const { return static_cast<size_t>(end - cur); }
+
+    /**
+     * @brief Skip over bytes without reading them
+     */
+    void skip(size_t size) {
+        require(size);
+        cur += size;
+    }
+
+    /**
+     * @brief Throw if fewer than size bytes remain
+     */
+    void require(size_t size) const {
+        if (remaining() < size) {
+            throw std::runtime_error("Unexpected end of binary data");
+        }
+    }
+};
+
+#endif // BINARY_IO_H
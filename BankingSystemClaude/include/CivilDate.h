@@ -0,0 +1,106 @@
+#ifndef CIVIL_DATE_H
+#define CIVIL_DATE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Proleptic Gregorian calendar date with constexpr day arithmetic
+ *
+ * Converts between dates and days since 1970-01-01 with the closed-form
+ * era/year-of-era formulas, so month arithmetic needs no time-zone lookups,
+ * no shared state and no allocation, and can run in constant expressions.
+ */
+struct CivilDate {
+    int year = 1970;
+    unsigned month = 1;  // 1-12
+    unsigned day = 1;    // 1-31
+
+    /**
+     * @brief Days since 1970-01-01 (negative before)
+     *
+     * Days past the end of the month count on into the next ones, so
+     * 2023-02-31 is the same day as 2023-03-03.
+     */
+    constexpr int64_t toDays() const {
+        // Years start in March so the leap day is the last day of the year
+        int64_t y = static_cast<int64_t>(year) - (month <= 2 ? 1 : 0);
+        int64_t era = (y >= 0 ? y : y - 399) / 400;
+        int64_t yearOfEra = y - era * 400;                                     // [0, 399]
+        int64_t monthFromMarch = month > 2 ? month - 3 : month + 9;            // [0, 11]
+        int64_t dayOfYear = (153 * monthFromMarch + 2) / 5 + day - 1;          // [0, 365]
+        int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    /**
+     * @brief Date of a day counted from 1970-01-01
+     */
+    static constexpr CivilDate fromDays(int64_t days) {
+        days += 719468;
+        int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        int64_t dayOfEra = days - era * 146097;                                                      // [0, 146096]
+        int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;  // [0, 399]
+        int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);          // [0, 365]
+        int64_t monthFromMarch = (5 * dayOfYear + 2) / 153;                                          // [0, 11]
+        CivilDate date;
+        date.day = static_cast<unsigned>(dayOfYear - (153 * monthFromMarch + 2) / 5 + 1);
+        date.month = static_cast<unsigned>(monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9);
+        date.year = static_cast<int>(yearOfEra + era * 400 + (date.month <= 2 ? 1 : 0));
+        return date;
+    }
+
+    /**
+     * @brief The same day of the month a number of months later
+     *
+     * A day the target month does not have rolls over into the next month
+     * (2024-02-29 plus 12 months is 2025-03-01), as mktime would.
+     */
+    constexpr CivilDate plusMonths(int months) const {
+        int64_t index = static_cast<int64_t>(year) * 12 + (month - 1) + months;
+        int64_t targetYear = (index >= 0 ? index : index - 11) / 12;
+        CivilDate target;
+        target.year = static_cast<int>(targetYear);
+        target.month = static_cast<unsigned>(index - targetYear * 12 + 1);
+        target.day = day;
+        return fromDays(target.toDays());
+    }
+
+    /**
+     * @brief Month index: year * 12 + month - 1
+     */
+    constexpr int monthIndex() const { return year * 12 + static_cast<int>(month) - 1; }
+
+    /**
+     * @brief Write the date as YYYY-MM-DD (years 0-9999)
+     * @param out Buffer of at least FORMATTED_SIZE characters; not terminated
+     * @return Number of characters written
+     */
+    size_t format(char* out) const {
+        unsigned y = static_cast<unsigned>(year);
+        out[0] = static_cast<char>('0' + y / 1000 % 10);
+        out[1] = static_cast<char>('0' + y / 100 % 10);
+        out[2] = static_cast<char>('0' + y / 10 % 10);
+        out[3] = static_cast<char>('0' + y % 10);
+        out[4] = '-';
+        out[5] = static_cast<char>('0' + month / 10);
+        out[6] = static_cast<char>('0' + month % 10);
+        out[7] = '-';
+        out[8] = static_cast<char>('0' + day / 10);
+        out[9] = static_cast<char>('0' + day % 10);
+        return FORMATTED_SIZE;
+    }
+
+    static constexpr size_t FORMATTED_SIZE = 10;
+
+    constexpr bool operator==(const CivilDate& other) const {
+        return year == other.year && month == other.month && day == other.day;
+    }
+    constexpr bool operator!=(const CivilDate& other) const { return !(*this == other); }
+};
+
+static_assert(CivilDate{1970, 1, 1}.toDays() == 0, "The epoch is day 0");
+static_assert(CivilDate::fromDays(CivilDate{2000, 2, 29}.toDays()) == CivilDate{2000, 2, 29}, "Leap day round trip");
+static_assert(CivilDate{2024, 2, 29}.plusMonths(12) == CivilDate{2025, 3, 1}, "Missing day rolls over");
+
+#endif // CIVIL_DATE_H
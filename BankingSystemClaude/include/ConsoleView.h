@@ -0,0 +1,145 @@
+#ifndef CONSOLE_VIEW_H
+#define CONSOLE_VIEW_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Account.h"
+#include "BankManager.h"
+
+/**
+ * @brief Console presentation of banking results
+ *
+ * BankingLib only returns result codes, statistics and diagnostics; this class
+ * turns them into the messages shown by the interactive application. Keeping
+ * all formatting here means operations never pay for I/O and tests can render
+ * into a string stream.
+ */
+class ConsoleView {
+private:
+    std::ostream& out;
+
+    /**
+     * @brief Print a horizontal rule of the given width
+     */
+    void rule(size_t width) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param stream Stream to render into
+     */
+    explicit ConsoleView(std::ostream& stream = std::cout);
+
+    /**
+     * @brief Display the main menu and the choice prompt
+     */
+    void showMainMenu() const;
+
+    /**
+     * @brief Display the menu of a logged-in account and the choice prompt
+     */
+    void showAccountMenu(const std::string& accountHolder) const;
+
+    /**
+     * @brief Display the fixed deposit rate card
+     */
+    void showFixedDepositRates() const;
+
+    /**
+     * @brief Display a section heading
+     */
+    void showHeading(const std::string& title) const;
+
+    /**
+     * @brief Display an error message
+     */
+    void showError(const std::string& message) const;
+
+    /**
+     * @brief Display the outcome of creating an account
+     * @param accountNumber Number returned by BankManager::createAccount
+     */
+    void showAccountCreated(BankResult result, int accountNumber, const std::string& name,
+                            Money initialBalance) const;
+
+    /**
+     * @brief Display the outcome of a login attempt
+     * @param account Logged-in account, or nullptr on failure
+     */
+    void showLogin(BankResult result, const Account* account) const;
+
+    /**
+     * @brief Display the outcome of a deposit
+     */
+    void showDeposit(OperationResult result, Money amount, const Account& account) const;
+
+    /**
+     * @brief Display the outcome of a withdrawal
+     */
+    void showWithdrawal(OperationResult result, Money amount, const Account& account) const;
+
+    /**
+     * @brief Display the outcome of opening a fixed deposit (details of the newest FD on success)
+     */
+    void showFixedDepositOpened(OperationResult result, const Account& account) const;
+
+    /**
+     * @brief Display the outcome of a transfer
+     */
+    void showTransfer(TransferResult result, Money amount, int toAccount, const Account& from) const;
+
+    /**
+     * @brief Display current balance
+     */
+    void showBalance(const Account& account) const;
+
+    /**
+     * @brief Display account details
+     */
+    void showAccountDetails(const Account& account) const;
+
+    /**
+     * @brief Display last transactions
+     */
+    void showTransactionHistory(const Account& account) const;
+
+    /**
+     * @brief Display one page of the account's full history, oldest first
+     * @param first Index of the first transaction on the page
+     * @param count Page size
+     */
+    void showTransactionPage(const Account& account, size_t first, size_t count) const;
+
+    /**
+     * @brief Display all fixed deposits
+     */
+    void showFixedDeposits(const Account& account) const;
+
+    /**
+     * @brief Display how many matured FDs were credited (nothing when none were)
+     */
+    void showMaturedDeposits(size_t credited) const;
+
+    /**
+     * @brief Display what a load found
+     */
+    void showLoadStats(const BankManager::LoadStats& stats) const;
+
+    /**
+     * @brief Display the cost breakdown of a successful save
+     */
+    void showSaveStats(const BankManager::SaveStats& stats) const;
+
+    /**
+     * @brief Display diagnostics collected by BankManager::takeDiagnostics()
+     */
+    void showDiagnostics(const std::vector<std::string>& diagnostics) const;
+
+    /**
+     * @brief Display the farewell banner
+     */
+    void showGoodbye() const;
+};
+
+#endif // CONSOLE_VIEW_H
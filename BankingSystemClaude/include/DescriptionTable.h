@@ -0,0 +1,56 @@
+#ifndef DESCRIPTION_TABLE_H
+#define DESCRIPTION_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Process-wide table of interned transaction descriptions
+ *
+ * Transactions store a 32-bit id instead of their own copy of the text, so
+ * the handful of descriptions that make up nearly all transactions are held
+ * once. The common descriptions have fixed ids and need no lookup. Interned
+ * strings are never removed and never move, so lookup() references stay
+ * valid for the life of the process. All methods are thread-safe.
+ *
+ * Per-record details such as a transfer's counterparty live in the
+ * Transaction, not in the text, so the table stays small.
+ */
+class DescriptionTable {
+public:
+    static constexpr uint32_t CAPACITY = 1u << 24;  // Ids fit the 24-bit Transaction field
+
+    /**
+     * @brief Ids of the descriptions interned at startup
+     */
+    enum : uint32_t {
+        NONE = 0,  // Empty description
+        INITIAL_DEPOSIT,
+        CASH_DEPOSIT,
+        CASH_WITHDRAWAL,
+        FD_OPENED_12_MONTHS,
+        FD_OPENED_24_MONTHS,
+        FD_MATURED,
+        TRANSFER_TO,   // Followed by the counterparty when rendered
+        TRANSFER_FROM
+    };
+
+    /**
+     * @brief Get the id of a description, adding it to the table if new
+     * @return NONE for a new description once the table holds CAPACITY entries
+     */
+    static uint32_t intern(std::string_view description);
+
+    /**
+     * @brief Get the text of an interned description (empty for unknown ids)
+     */
+    static const std::string& lookup(uint32_t id);
+
+    /**
+     * @brief Get number of distinct descriptions interned so far
+     */
+    static size_t size();
+};
+
+#endif // DESCRIPTION_TABLE_H
@@ -2,8 +2,10 @@
 #define FILE_MANAGER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
+#include <memory>
 
 /**
  * @brief FileManager class for handling file I/O operations
@@ -14,6 +16,134 @@ private:
     std::string dataDirectory;
 
 public:
+    /**
+     * @brief Reads a file through a fixed-size buffer and yields complete records
+     *
+     * Memory use is bounded by the buffer size (the buffer only grows when a
+     * single record is larger than it). Views returned by any method stay
+     * valid until the next call on the reader.
+     */
+    class BlockReader {
+    private:
+        std::ifstream file;
+        std::vector<char> buffer;
+        size_t begin;     // First unconsumed byte
+        size_t end;       // One past the last buffered byte
+        bool atEof;
+
+        /**
+         * @brief Compact unconsumed bytes to the front and read more
+         * @return false once the file is exhausted
+         */
+        bool fill();
+
+        /**
+         * @brief fill() for line-oriented reads; terminates an unterminated final line
+         */
+        bool fillLines();
+
+        /**
+         * @brief Find the next newline in [from, end)
+         */
+        size_t findNewline(size_t from) const;
+
+        /**
+         * @brief Check if the line starting at pos and ending at newline equals text
+         */
+        bool lineEquals(size_t pos, size_t newline, std::string_view text) const;
+
+    public:
+        /**
+         * @brief Open a file for streaming
+         * @param filepath Full path of the file
+         * @param bufferSize Initial buffer size in bytes
+         */
+        BlockReader(const std::string& filepath, size_t bufferSize);
+
+        /**
+         * @brief Check if the file was opened
+         */
+        bool isOpen() const { return file.is_open(); }
+
+        /**
+         * @brief View the next size bytes without consuming them
+         * @return false if fewer bytes remain
+         */
+        bool peek(size_t size, std::string_view& out);
+
+        /**
+         * @brief Consume the next size bytes
+         * @return false if fewer bytes remain
+         */
+        bool read(size_t size, std::string_view& out);
+
+        /**
+         * @brief Consume the next line (without its newline)
+         * @return false at end of file
+         */
+        bool nextLine(std::string_view& line);
+
+        /**
+         * @brief Consume every complete startLine ... endLine block currently buffered
+         *
+         * Block views exclude the marker lines. Lines outside blocks are skipped.
+         * A block left open at end of file runs to the end of the file.
+         * @return Number of blocks (0 at end of file)
+         */
+        size_t nextBlocks(std::string_view startLine, std::string_view endLine,
+                          std::vector<std::string_view>& blocks);
+
+        /**
+         * @brief Consume complete u32-length-prefixed records currently buffered
+         *
+         * Record views include their length prefix.
+         * @param maxRecords Stop after this many records
+         * @return Number of records (0 at end of file or on a truncated record)
+         */
+        size_t nextRecords(size_t maxRecords, std::vector<std::string_view>& records);
+    };
+
+    /**
+     * @brief Read-only memory mapping of a whole file
+     *
+     * Falls back to reading the file into memory where mmap is unavailable.
+     */
+    class MappedFile {
+    private:
+        const char* address;
+        size_t length;
+        std::string fallback;  // Contents when the file could not be mapped
+
+    public:
+        /**
+         * @brief Map a file (check isOpen() for success)
+         */
+        explicit MappedFile(const std::string& filepath);
+
+        /**
+         * @brief Destructor - unmaps the file
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Check if the file was mapped or read
+         */
+        bool isOpen() const { return address != nullptr; }
+
+        /**
+         * @brief View of the whole file
+         */
+        std::string_view view() const { return std::string_view(address, length); }
+    };
+
+    /**
+     * @brief Default buffer size for streaming readers
+     */
+    static const size_t DEFAULT_STREAM_BUFFER = 4 * 1024 * 1024;
+
     /**
      * @brief Constructor
      */
@@ -25,7 +155,10 @@ public:
     bool ensureDataDirectory();
 
     /**
-     * @brief Write data to file
+     * @brief Write data to file atomically
+     *
+     * The data is written to a temporary file, synced to disk and renamed over
+     * the target, so readers and crashes only ever see a complete file.
      */
     bool writeToFile(const std::string& filename, const std::string& data);
 
@@ -34,6 +167,17 @@ public:
      */
     std::string readFromFile(const std::string& filename);
 
+    /**
+     * @brief Open a file in the data directory for chunked streaming
+     */
+    std::unique_ptr<BlockReader> openBlockReader(const std::string& filename,
+                                                 size_t bufferSize = DEFAULT_STREAM_BUFFER) const;
+
+    /**
+     * @brief Memory-map a file in the data directory
+     */
+    std::unique_ptr<MappedFile> mapFile(const std::string& filename) const;
+
     /**
      * @brief Check if file exists
      */
@@ -2,17 +2,32 @@
 #define FIXED_DEPOSIT_H
 
 #include <chrono>
+#include <memory>
 #include <string>
+#include <string_view>
+#include "TextScanner.h"
+#include "CivilDate.h"
+#include "Money.h"
+
+class BinaryWriter;
+class BinaryReader;
 
 /**
  * @brief Fixed Deposit class to handle FD operations
  */
 class FixedDeposit {
 private:
-    double principal;
+    Money principal;
     int tenure; // in months (12 or 24)
     double interestRate;
     std::chrono::system_clock::time_point openDate;
+    std::chrono::system_clock::time_point maturityTime;  // Cached: the terms never change
+    CivilDate maturityDate;  // Local calendar
+
+    /**
+     * @brief Compute maturityTime and maturityDate from openDate and tenure
+     */
+    void computeMaturity();
 
 public:
     /**
@@ -20,13 +35,18 @@ public:
      * @param amount Principal amount
      * @param months Tenure in months (12 or 24)
      */
-    FixedDeposit(double amount, int months);
+    FixedDeposit(Money amount, int months);
+
+    /**
+     * @brief Constructor for an FD opened at a known time (journal replay)
+     */
+    FixedDeposit(Money amount, int months, std::chrono::system_clock::time_point opened);
 
     /**
      * @brief Calculate maturity amount
-     * @return Maturity amount with interest
+     * @return Maturity amount with simple interest, rounded to the nearest paisa
      */
-    double calculateMaturityAmount() const;
+    Money calculateMaturityAmount() const;
 
     /**
      * @brief Get tenure
@@ -36,7 +56,7 @@ public:
     /**
      * @brief Get principal amount
      */
-    double getPrincipal() const { return principal; }
+    Money getPrincipal() const { return principal; }
 
     /**
      * @brief Get interest rate
@@ -49,10 +69,35 @@ public:
     std::chrono::system_clock::time_point getOpenDate() const { return openDate; }
 
     /**
-     * @brief Get maturity date as string
+     * @brief Get the time the FD matures: the open time, tenure months later (local calendar)
+     */
+    std::chrono::system_clock::time_point getMaturityTime() const { return maturityTime; }
+
+    /**
+     * @brief Get the local calendar date the FD matures
+     */
+    CivilDate getMaturityCivilDate() const { return maturityDate; }
+
+    /**
+     * @brief Get the month index (year * 12 + month - 1) the FD matures in
+     */
+    int getMaturityMonth() const { return maturityDate.monthIndex(); }
+
+    /**
+     * @brief Get maturity date as string (YYYY-MM-DD)
      */
     std::string getMaturityDate() const;
 
+    /**
+     * @brief Local calendar date of a time
+     */
+    static CivilDate localDate(std::chrono::system_clock::time_point time);
+
+    /**
+     * @brief Calendar month containing a time, as year * 12 + month - 1 (local calendar)
+     */
+    static int monthIndex(std::chrono::system_clock::time_point time);
+
     /**
      * @brief Serialize FD to string
      */
@@ -62,6 +107,24 @@ public:
      * @brief Deserialize FD from string
      */
     static FixedDeposit deserialize(const std::string& data);
+
+    /**
+     * @brief Parse a serialized FD line without exceptions or temporaries
+     * @param data Line in serialize() format
+     * @param out Receives the new FD (unchanged on error)
+     */
+    static ParseError parse(std::string_view data, std::shared_ptr<FixedDeposit>& out);
+
+    /**
+     * @brief Append FD to a binary snapshot buffer (fixed 28-byte record)
+     */
+    void serializeBinary(BinaryWriter& out) const;
+
+    /**
+     * @brief Read FD from a binary snapshot buffer
+     * @param amounts Amount format of the containing file
+     */
+    static FixedDeposit deserializeBinary(BinaryReader& in, AmountFormat amounts = AmountFormat::PAISE);
 };
 
 #endif // FIXED_DEPOSIT_H
@@ -0,0 +1,126 @@
+#ifndef FIXED_DEPOSIT_COLUMNS_H
+#define FIXED_DEPOSIT_COLUMNS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+#include "Money.h"
+
+class FixedDeposit;
+
+/**
+ * @brief Open FDs falling due in one period
+ */
+struct MaturityBucket {
+    size_t deposits = 0;
+    Money principal;
+    Money payout;  // Principal plus interest
+
+    /**
+     * @brief Interest included in the payout
+     */
+    Money interest() const { return payout - principal; }
+};
+
+/**
+ * @brief Maturity payouts of the open FDs per calendar month
+ */
+struct MaturityProjection {
+    int firstMonth = 0;                  // Month index (year * 12 + month - 1) of months[0]
+    MaturityBucket overdue;              // Matured before firstMonth but not credited yet
+    std::vector<MaturityBucket> months;  // months[i] covers firstMonth + i
+    MaturityBucket later;                // Maturing after the last month
+    MaturityBucket total;                // All open FDs
+
+    /**
+     * @brief Calendar year of months[i]
+     */
+    int yearOf(size_t i) const { return (firstMonth + static_cast<int>(i)) / 12; }
+
+    /**
+     * @brief Calendar month (1-12) of months[i]
+     */
+    int monthOf(size_t i) const { return (firstMonth + static_cast<int>(i)) % 12 + 1; }
+};
+
+/**
+ * @brief Struct-of-arrays index of every open fixed deposit in the bank
+ *
+ * One row per FD, laid out in chunks like AccountColumns: the owning account,
+ * the principal, and the maturity month and payout computed once when the row
+ * is attached (an FD's terms never change). Maturity projections then scan
+ * plain arrays instead of calling into every FD under every account.
+ *
+ * Accounts attach a row when an FD is opened and release it when the FD
+ * matures. Writers share a chunk's lock and a scan takes it exclusively.
+ */
+class FixedDepositColumns {
+public:
+    static const size_t CHUNK_ROWS = 4096;
+
+    struct Chunk {
+        mutable std::shared_mutex mutex;       // Shared by row writers, exclusive for scans
+        bool occupied[CHUNK_ROWS] = {};        // False for a free row
+        int accountNumbers[CHUNK_ROWS] = {};
+        int64_t principal[CHUNK_ROWS] = {};    // Paise
+        int32_t maturityMonth[CHUNK_ROWS] = {};
+        int64_t payout[CHUNK_ROWS] = {};       // Paise
+    };
+
+    /**
+     * @brief Position of one FD's row
+     */
+    struct Cell {
+        Chunk* chunk = nullptr;
+        size_t row = 0;
+        size_t index = 0;  // chunk number * CHUNK_ROWS + row
+    };
+
+private:
+    mutable std::shared_mutex chunksMutex;  // Guards chunks, freeRows, nextRow and rows
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<size_t> freeRows;
+    size_t nextRow;
+    size_t rows;  // Rows currently attached
+
+    /**
+     * @brief Number of rows of a chunk handed out so far (chunksMutex held)
+     */
+    size_t usedRows(size_t chunk) const;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    FixedDepositColumns();
+
+    FixedDepositColumns(const FixedDepositColumns&) = delete;
+    FixedDepositColumns& operator=(const FixedDepositColumns&) = delete;
+
+    /**
+     * @brief Take a row and fill it with an FD's terms
+     */
+    Cell attach(int accountNumber, const FixedDeposit& fd);
+
+    /**
+     * @brief Zero a row and make it available again
+     */
+    void release(const Cell& cell);
+
+    /**
+     * @brief Number of attached rows
+     */
+    size_t size() const;
+
+    /**
+     * @brief Bucket the payouts of all open FDs by maturity month
+     * @param firstMonth Month index (year * 12 + month - 1) of the first bucket
+     * @param months Number of monthly buckets
+     * @param threads Chunks are split across this many threads (1 scans on the caller)
+     */
+    MaturityProjection project(int firstMonth, size_t months, size_t threads = 1) const;
+};
+
+#endif // FIXED_DEPOSIT_COLUMNS_H
@@ -0,0 +1,223 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Money.h"
+
+/**
+ * @brief One state-changing operation recorded in the journal
+ */
+struct JournalEntry {
+    enum class Operation {
+        CREATE_ACCOUNT,
+        DEPOSIT,
+        WITHDRAWAL,
+        FD_OPEN,
+        TRANSFER,     // From accountNumber to counterparty, journaled once for both sides
+        FD_MATURITY   // FD credited at maturity: its principal, tenure and open time (timestamp)
+    };
+
+    uint64_t lsn = 0;              // Log sequence number, assigned by Journal::append
+    Operation operation = Operation::DEPOSIT;
+    int accountNumber = 0;
+    Money amount;                  // Deposit/withdrawal/FD amount, or initial balance
+    int tenure = 0;                // FD tenure in months (FD_OPEN and FD_MATURITY)
+    int counterparty = 0;          // Receiving account (TRANSFER only)
+    std::time_t timestamp = 0;
+    std::string passwordHash;      // CREATE_ACCOUNT only
+    std::string holderName;        // CREATE_ACCOUNT only
+
+    /**
+     * @brief Serialize entry to a single journal line (without newline)
+     */
+    std::string serialize() const;
+
+    /**
+     * @brief Deserialize entry from a journal line
+     */
+    static JournalEntry deserialize(const std::string& line);
+};
+
+/**
+ * @brief Append-only write-ahead journal of account operations
+ *
+ * Every deposit, withdrawal, FD open and account creation is appended as one
+ * line, so the cost of an operation no longer depends on the number of
+ * accounts. A checkpoint takes a cut under pauseOperations(): the snapshot
+ * holds exactly the operations up to the last LSN at that moment. Once the
+ * snapshot is written, discardThrough() drops the entries it covers and keeps
+ * any journaled since. Recovery replays entries newer than the snapshot's LSN.
+ *
+ * append() only flushes to the OS. appendDurable() also fsyncs, through a
+ * group commit: a commit thread flushes and syncs everything appended so far
+ * in one go, after waiting up to the configured commit delay for more
+ * callers to join the batch. All methods are thread-safe.
+ */
+class Journal {
+private:
+    std::string filename;
+    std::string dataDirectory;
+    std::ofstream stream;
+    int syncFd;             // Descriptor used to fsync the file (-1 if unavailable)
+    uint64_t nextLsn;
+    size_t pendingEntries;  // Entries appended since the last reset
+    
+    mutable std::mutex mutex;
+    std::shared_mutex operationGate;  // Shared by operations that journal, exclusive for a snapshot cut
+    std::condition_variable commitCondition;  // Wakes the commit thread
+    std::condition_variable idleCondition;    // Signals that no commit is outstanding
+    std::thread committer;
+    std::vector<std::promise<bool>> waiting;  // appendDurable callers for the next commit
+    std::chrono::microseconds maxCommitDelay;
+    size_t maxCommitBatch;                    // Commit early once this many callers wait
+    bool committing;
+    bool stopping;
+    size_t commitCount;
+
+    /**
+     * @brief (Re)open the file for appending, optionally truncating it (mutex held)
+     */
+    bool openStream(bool truncate);
+
+    /**
+     * @brief Wait until every durable append has been committed (mutex held)
+     */
+    void drain(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Commit thread body
+     */
+    void commitLoop();
+
+public:
+    static const size_t DEFAULT_COMMIT_BATCH = 64;
+
+    /**
+     * @brief Constructor
+     * @param file Journal file name inside the data directory
+     */
+    explicit Journal(const std::string& file, const std::string& dataDir = "data");
+
+    /**
+     * @brief Destructor - commits outstanding durable appends and stops the commit thread
+     */
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /**
+     * @brief Open the journal for appending (creates it if missing)
+     */
+    bool open();
+
+    /**
+     * @brief Append an entry and flush it
+     * @return LSN assigned to the entry, or 0 if the journal is not open
+     */
+    uint64_t append(JournalEntry entry);
+
+    /**
+     * @brief Append several entries with a single flush
+     * @param entries Entries to append; their LSNs are assigned in order
+     * @return false if the journal is not open
+     */
+    bool appendBatch(std::vector<JournalEntry>& entries);
+
+    /**
+     * @brief Append an entry and have it fsynced by the next group commit
+     * @return Future that becomes true once the entry is on disk (false on I/O error)
+     */
+    std::future<bool> appendDurable(JournalEntry entry);
+
+    /**
+     * @brief Admit one journaled operation; hold the lock while applying and appending it
+     *
+     * Taken before the account locks, so a snapshot cut that holds the gate
+     * exclusively sees every operation either fully applied and journaled or
+     * not started.
+     */
+    std::shared_lock<std::shared_mutex> admitOperation() { return std::shared_lock<std::shared_mutex>(operationGate); }
+
+    /**
+     * @brief Hold off new journaled operations until the returned lock is released
+     *
+     * The last LSN read while holding it matches exactly the account state
+     * copied while holding it.
+     */
+    std::unique_lock<std::shared_mutex> pauseOperations() { return std::unique_lock<std::shared_mutex>(operationGate); }
+
+    /**
+     * @brief Set how long a commit waits for more entries before syncing
+     *
+     * Longer windows put more entries into each fsync at the cost of latency.
+     */
+    void setMaxCommitDelay(std::chrono::microseconds delay);
+
+    /**
+     * @brief Set number of waiting callers that triggers a commit before the delay expires
+     */
+    void setMaxCommitBatch(size_t callers);
+
+    /**
+     * @brief Number of group commits (fsyncs) performed so far
+     */
+    size_t getCommitCount() const;
+
+    /**
+     * @brief Read all complete entries currently in the journal file
+     *
+     * A torn final line (no trailing newline) left by a crash is ignored.
+     */
+    std::vector<JournalEntry> readEntries() const;
+
+    /**
+     * @brief Discard all entries (called after a checkpoint)
+     */
+    bool reset();
+
+    /**
+     * @brief Discard entries up to and including lsn, keeping any newer ones
+     *
+     * Used after a background snapshot, when operations may have been journaled
+     * while the snapshot was being written.
+     */
+    bool discardThrough(uint64_t lsn);
+
+    /**
+     * @brief Ensure future LSNs are at least lsn
+     */
+    void advanceLsn(uint64_t lsn);
+
+    /**
+     * @brief LSN of the most recently appended entry (0 if none)
+     */
+    uint64_t getLastLsn() const;
+
+    /**
+     * @brief Number of entries appended since the last reset
+     */
+    size_t getPendingEntries() const;
+
+    /**
+     * @brief Check if the journal is open for appending
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get full file path
+     */
+    std::string getFilePath() const;
+};
+
+#endif // JOURNAL_H
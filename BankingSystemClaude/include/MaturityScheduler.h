@@ -0,0 +1,64 @@
+#ifndef MATURITY_SCHEDULER_H
+#define MATURITY_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Bank-wide queue of fixed-deposit maturities, earliest first
+ *
+ * A binary min-heap of (maturity time, account number) pairs, so scheduling
+ * an FD and taking the next due one are O(log n) however many FDs are open.
+ * Entries only say which account to look at: the account decides which of
+ * its FDs have actually matured, so an entry whose FD is already gone is
+ * simply dropped when it comes due. Times are kept at full clock precision,
+ * as the account compares them. All methods are thread-safe.
+ */
+class MaturityScheduler {
+private:
+    struct Entry {
+        int64_t maturity;  // system_clock ticks since the epoch
+        int accountNumber;
+
+        // Inverted so std::push_heap/pop_heap keep the earliest entry on top
+        bool operator<(const Entry& other) const {
+            return maturity != other.maturity ? maturity > other.maturity : accountNumber > other.accountNumber;
+        }
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Entry> heap;
+
+public:
+    /**
+     * @brief Queue an account to be visited once one of its FDs matures
+     */
+    void schedule(int accountNumber, std::chrono::system_clock::time_point maturity);
+
+    /**
+     * @brief Remove every entry due at or before now
+     * @return Accounts with a due FD, each listed once, in order of their earliest maturity
+     */
+    std::vector<int> takeDue(std::chrono::system_clock::time_point now);
+
+    /**
+     * @brief Get the earliest scheduled maturity
+     * @return false if nothing is scheduled
+     */
+    bool nextMaturity(std::chrono::system_clock::time_point& when) const;
+
+    /**
+     * @brief Get number of scheduled entries
+     */
+    size_t size() const;
+
+    /**
+     * @brief Drop every entry
+     */
+    void clear();
+};
+
+#endif // MATURITY_SCHEDULER_H
@@ -0,0 +1,133 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Amount of money held as a whole number of paise
+ *
+ * Sums and differences are exact, and text I/O is exact decimal with two
+ * fraction digits, so balances never drift the way binary doubles do.
+ * Conversions from and to rupee doubles exist only for the edges that still
+ * speak doubles (user input, legacy binary records) and round to the
+ * nearest paisa.
+ */
+class Money {
+private:
+    int64_t paise;
+
+    constexpr explicit Money(int64_t minorUnits) : paise(minorUnits) {}
+
+public:
+    /**
+     * @brief Constructor for zero
+     */
+    constexpr Money() : paise(0) {}
+
+    /**
+     * @brief Amount of a whole number of paise
+     */
+    static constexpr Money fromPaise(int64_t minorUnits) { return Money(minorUnits); }
+
+    /**
+     * @brief Amount of a whole number of rupees
+     */
+    static constexpr Money rupees(int64_t whole) { return Money(whole * 100); }
+
+    /**
+     * @brief Amount nearest to a rupee value (halves round away from zero)
+     * @return false if value is not finite or the amount does not fit in int64 paise
+     */
+    static bool fromRupees(double value, Money& out);
+
+    /**
+     * @brief Amount nearest to a rupee value known to be in range
+     * @throws std::out_of_range if fromRupees(value, out) would fail
+     */
+    static Money fromRupees(double value);
+
+    /**
+     * @brief Parse a decimal amount such as "1234.56", "-0.5" or "1e+06"
+     *
+     * Up to two fraction digits are taken exactly; longer fractions and
+     * exponent forms written by older versions are rounded to the nearest paisa.
+     * @return false if text is not a number or is out of range
+     */
+    static bool parse(std::string_view text, Money& out);
+
+    /**
+     * @brief Get amount in paise
+     */
+    constexpr int64_t toPaise() const { return paise; }
+
+    /**
+     * @brief Get amount in rupees (for display and the binary snapshot fields)
+     */
+    constexpr double toRupees() const { return static_cast<double>(paise) / 100.0; }
+
+    static constexpr size_t FORMATTED_MAX = 24;  // Longest format() output: sign, 17 digits, point, 2 digits
+
+    /**
+     * @brief Exact decimal text with two fraction digits, e.g. "-1234.05"
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Write toString() text into a caller buffer without allocating
+     * @param out Buffer of at least FORMATTED_MAX characters; not terminated
+     * @return Number of characters written
+     */
+    size_t format(char* out) const;
+
+    /**
+     * @brief Multiply by numerator / denominator, rounding halves away from zero
+     *
+     * Used for interest; amount * numerator must fit in 64 bits.
+     */
+    Money scaled(int64_t numerator, int64_t denominator) const;
+
+    constexpr bool isPositive() const { return paise > 0; }
+    constexpr bool isNegative() const { return paise < 0; }
+    constexpr bool isZero() const { return paise == 0; }
+
+    constexpr Money operator-() const { return Money(-paise); }
+    constexpr Money operator+(Money other) const { return Money(paise + other.paise); }
+    constexpr Money operator-(Money other) const { return Money(paise - other.paise); }
+    constexpr Money operator*(int64_t factor) const { return Money(paise * factor); }
+    Money& operator+=(Money other) { paise += other.paise; return *this; }
+    Money& operator-=(Money other) { paise -= other.paise; return *this; }
+
+    constexpr bool operator==(Money other) const { return paise == other.paise; }
+    constexpr bool operator!=(Money other) const { return paise != other.paise; }
+    constexpr bool operator<(Money other) const { return paise < other.paise; }
+    constexpr bool operator<=(Money other) const { return paise <= other.paise; }
+    constexpr bool operator>(Money other) const { return paise > other.paise; }
+    constexpr bool operator>=(Money other) const { return paise >= other.paise; }
+};
+
+/**
+ * @brief Write the amount as toString() does
+ */
+std::ostream& operator<<(std::ostream& out, Money amount);
+
+/**
+ * @brief Read one whitespace-delimited amount; sets failbit if it does not parse
+ */
+std::istream& operator>>(std::istream& in, Money& amount);
+
+/**
+ * @brief How a binary record stores Money amounts
+ *
+ * Current records store whole paise. Snapshots before version 4 and TXNLOG01
+ * log segments stored f64 rupees; those are still read.
+ */
+enum class AmountFormat : uint8_t {
+    RUPEES,  // f64 rupees (legacy)
+    PAISE    // i64 paise
+};
+
+#endif // MONEY_H
@@ -0,0 +1,151 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Fixed-capacity circular buffer stored inline
+ *
+ * Keeps the most recent Capacity elements: appending to a full buffer
+ * replaces the oldest one. Elements are constructed in place in storage
+ * inside the object, so the buffer never allocates. Indexing and iteration
+ * run from oldest to newest.
+ */
+template <typename T, size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity > 0, "RingBuffer needs room for at least one element");
+
+private:
+    alignas(T) unsigned char storage[Capacity * sizeof(T)];
+    size_t head;   // Slot of the oldest element
+    size_t count;
+
+    T* slot(size_t s) { return std::launder(reinterpret_cast<T*>(storage) + s); }
+    const T* slot(size_t s) const { return std::launder(reinterpret_cast<const T*>(storage) + s); }
+
+    /**
+     * @brief Slot holding the element at a chronological position
+     */
+    size_t slotOf(size_t position) const {
+        size_t s = head + position;
+        return s < Capacity ? s : s - Capacity;
+    }
+
+public:
+    /**
+     * @brief Forward iterator from oldest to newest element
+     */
+    class const_iterator {
+    private:
+        const RingBuffer* buffer;
+        size_t position;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const RingBuffer* owner, size_t pos) : buffer(owner), position(pos) {}
+
+        reference operator*() const { return (*buffer)[position]; }
+        pointer operator->() const { return &(*buffer)[position]; }
+        const_iterator& operator++() { ++position; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++position; return old; }
+        bool operator==(const const_iterator& other) const { return position == other.position; }
+        bool operator!=(const const_iterator& other) const { return position != other.position; }
+    };
+
+    /**
+     * @brief Constructor for an empty buffer
+     */
+    RingBuffer() : head(0), count(0) {}
+
+    /**
+     * @brief Copy constructor (copies elements in chronological order)
+     */
+    RingBuffer(const RingBuffer& other) : head(0), count(0) {
+        for (const T& value : other) {
+            push_back(value);
+        }
+    }
+
+    /**
+     * @brief Copy assignment
+     */
+    RingBuffer& operator=(const RingBuffer& other) {
+        if (this != &other) {
+            clear();
+            for (const T& value : other) {
+                push_back(value);
+            }
+        }
+        return *this;
+    }
+
+    ~RingBuffer() { clear(); }
+
+    /**
+     * @brief Construct an element at the back, replacing the oldest when full
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        size_t s;
+        if (count == Capacity) {
+            s = head;
+            slot(s)->~T();
+            head = slotOf(1);
+        } else {
+            s = slotOf(count);
+            ++count;
+        }
+        return *::new (static_cast<void*>(slot(s))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Append a copy of an element, replacing the oldest when full
+     */
+    void push_back(const T& value) { emplace_back(value); }
+
+    /**
+     * @brief Destroy all elements
+     */
+    void clear() {
+        for (size_t i = 0; i < count; ++i) {
+            slot(slotOf(i))->~T();
+        }
+        head = 0;
+        count = 0;
+    }
+
+    /**
+     * @brief Element at a chronological position (0 is the oldest)
+     */
+    const T& operator[](size_t position) const { return *slot(slotOf(position)); }
+    T& operator[](size_t position) { return *slot(slotOf(position)); }
+
+    /**
+     * @brief Oldest element
+     */
+    const T& front() const { return (*this)[0]; }
+
+    /**
+     * @brief Newest element
+     */
+    const T& back() const { return (*this)[count - 1]; }
+    T& back() { return (*this)[count - 1]; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == Capacity; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,98 @@
+#ifndef TEXT_SCANNER_H
+#define TEXT_SCANNER_H
+
+#include <charconv>
+#include <string_view>
+#include <system_error>
+
+/**
+ * @brief Error codes reported by the allocation-free text parsers
+ */
+enum class ParseError {
+    NONE,
+    MISSING_FIELD,   // Record has fewer fields or lines than required
+    INVALID_NUMBER,  // Field is not a complete number
+    INVALID_VALUE    // Number parsed but is out of range for the field
+};
+
+/**
+ * @brief Human-readable message for a parse error
+ */
+inline const char* parseErrorMessage(ParseError error) {
+    switch (error) {
+        case ParseError::NONE: return "OK";
+        case ParseError::MISSING_FIELD: return "missing field";
+        case ParseError::INVALID_NUMBER: return "invalid number";
+        case ParseError::INVALID_VALUE: return "invalid value";
+    }
+    return "unknown error";
+}
+
+/**
+ * @brief Splits a string_view into lines and '|' separated fields without copying
+ *
+ * Returned views point into the scanned text, which must outlive them.
+ */
+class TextScanner {
+private:
+    std::string_view rest;
+
+public:
+    explicit TextScanner(std::string_view text) : rest(text) {}
+
+    /**
+     * @brief Check if all input has been consumed
+     */
+    bool atEnd() const { return rest.empty(); }
+
+    /**
+     * @brief Unconsumed input
+     */
+    std::string_view remaining() const { return rest; }
+
+    /**
+     * @brief Consume up to and including the next delimiter
+     * @return Text before the delimiter (or all remaining text if none)
+     */
+    std::string_view next(char delimiter) {
+        size_t pos = rest.find(delimiter);
+        std::string_view token = rest.substr(0, pos);
+        rest.remove_prefix(pos == std::string_view::npos ? rest.size() : pos + 1);
+        return token;
+    }
+
+    /**
+     * @brief Consume the next line (without its newline)
+     */
+    std::string_view nextLine() { return next('\n'); }
+
+    /**
+     * @brief Consume the next '|' separated field
+     */
+    std::string_view nextField() { return next('|'); }
+
+    /**
+     * @brief Parse an entire field as a number
+     * @return false unless every character of the field was consumed
+     */
+    template <typename T>
+    static bool parseNumber(std::string_view field, T& value) {
+        const char* end = field.data() + field.size();
+        std::from_chars_result result = std::from_chars(field.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end && !field.empty();
+    }
+
+    /**
+     * @brief Parse "<prefix><number>" (e.g. "TRANSACTIONS:3")
+     * @return false if the prefix does not match or the number is invalid
+     */
+    template <typename T>
+    static bool parsePrefixed(std::string_view line, std::string_view prefix, T& value) {
+        if (line.substr(0, prefix.size()) != prefix) {
+            return false;
+        }
+        return parseNumber(line.substr(prefix.size()), value);
+    }
+};
+
+#endif // TEXT_SCANNER_H
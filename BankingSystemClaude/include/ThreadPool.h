@@ -0,0 +1,73 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Fixed-size worker pool for CPU-bound batch work (loading, batch operations)
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable condition;
+    bool stopping;
+
+    /**
+     * @brief Worker loop - runs tasks until the pool is destroyed
+     */
+    void workerLoop();
+
+public:
+    /**
+     * @brief Constructor
+     * @param threadCount Number of workers (0 selects defaultThreadCount())
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Destructor - finishes queued tasks and joins all workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a task
+     * @return Future for the task's result (rethrows the task's exception)
+     */
+    template <typename F>
+    std::future<typename std::invoke_result<F>::type> submit(F&& task) {
+        typedef typename std::invoke_result<F>::type Result;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        condition.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Get number of worker threads
+     */
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Hardware concurrency, or 1 if it cannot be determined
+     */
+    static size_t defaultThreadCount();
+};
+
+#endif // THREAD_POOL_H
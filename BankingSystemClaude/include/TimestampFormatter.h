@@ -0,0 +1,43 @@
+#ifndef TIMESTAMP_FORMATTER_H
+#define TIMESTAMP_FORMATTER_H
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+
+/**
+ * @brief Local "YYYY-MM-DD HH:MM:SS" rendering of timestamps
+ *
+ * Every thread caches the local day it formatted last: the rendered date and
+ * the span of seconds it covers. Statement rows are nearly always close
+ * together in time, so most calls just copy the cached date and turn the
+ * seconds since local midnight into digits, with no time-zone lookup. Only a
+ * new day costs three thread-safe localtime calls. A day with a DST change
+ * is cached as two spans split at the change, which is found by bisection.
+ * The cache assumes the process time zone does not change.
+ */
+class TimestampFormatter {
+public:
+    static constexpr size_t FORMATTED_SIZE = 19;
+
+    /**
+     * @brief Write a timestamp as local "YYYY-MM-DD HH:MM:SS"
+     * @param out Buffer of at least FORMATTED_SIZE characters; not terminated
+     * @return Number of characters written
+     */
+    static size_t format(std::time_t time, char* out);
+
+    /**
+     * @brief Write a timestamp (whole seconds) as local "YYYY-MM-DD HH:MM:SS"
+     */
+    static size_t format(std::chrono::system_clock::time_point time, char* out) {
+        return format(std::chrono::system_clock::to_time_t(time), out);
+    }
+
+    /**
+     * @brief Get number of cache misses on the calling thread
+     */
+    static size_t getDayLookups();
+};
+
+#endif // TIMESTAMP_FORMATTER_H
@@ -3,15 +3,39 @@
 
 #include <string>
 #include <chrono>
-#include <sstream>
-#include <iomanip>
+#include <cstdint>
+#include <type_traits>
+#include <string_view>
+#include "TextScanner.h"
+#include "DescriptionTable.h"
+#include "Money.h"
+
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * @brief How a binary transaction record stores its timestamp
+ *
+ * Current records store raw system_clock ticks. Snapshots before version 5
+ * and TXNLOG01/TXNLOG02 log segments stored whole seconds; those are still read.
+ */
+enum class TimestampFormat : uint8_t {
+    SECONDS,  // time_t seconds (legacy)
+    TICKS     // system_clock ticks
+};
 
 /**
  * @brief Transaction class to store banking transaction details
+ *
+ * A fixed-size, trivially copyable record: amounts are Money (whole paise), the
+ * timestamp is raw system_clock ticks and the description is an id into
+ * the DescriptionTable. A transfer keeps the other account's number beside
+ * its fixed "Transfer to"/"Transfer from" id; the two are joined into one
+ * text only when the record is rendered or written out.
  */
 class Transaction {
 public:
-    enum class Type {
+    enum class Type : uint8_t {
         DEPOSIT,
         WITHDRAWAL,
         FD_OPEN,
@@ -19,49 +43,97 @@ public:
         TRANSFER
     };
 
+    static constexpr size_t TYPE_COUNT = 5;
+    static constexpr uint32_t ALL_TYPES = (1u << TYPE_COUNT) - 1;
+
+    /**
+     * @brief Bit for one type in a type mask (combine with |)
+     */
+    static constexpr uint32_t maskOf(Type t) { return 1u << static_cast<uint32_t>(t); }
+
 private:
-    Type type;
-    double amount;
-    double balanceAfter;
-    std::chrono::system_clock::time_point timestamp;
-    std::string description;
+    // Widest fields first so the record packs into 32 bytes
+    Money amount;
+    Money balanceAfter;
+    int64_t timestamp;            // system_clock ticks since the epoch
+    uint32_t descriptionId : 24;  // DescriptionTable id (below DescriptionTable::CAPACITY)
+    uint32_t typeCode : 8;        // Type
+    int32_t counterparty;         // Other account of a transfer, 0 otherwise
 
 public:
     /**
      * @brief Constructor for Transaction
      */
-    Transaction(Type t, double amt, double balance, const std::string& desc = "");
+    Transaction(Type t, Money amt, Money balance, const std::string& desc = "");
+
+    /**
+     * @brief Constructor for a transaction with a known timestamp (journal replay)
+     */
+    Transaction(Type t, Money amt, Money balance, const std::string& desc,
+                std::chrono::system_clock::time_point when);
+
+    /**
+     * @brief Constructor for a transaction with an already interned description
+     * @param counterparty Other account of a transfer, 0 otherwise
+     */
+    Transaction(Type t, Money amt, Money balance, uint32_t descId,
+                std::chrono::system_clock::time_point when, int counterparty = 0);
 
     /**
      * @brief Get transaction type
      */
-    Type getType() const { return type; }
+    Type getType() const { return static_cast<Type>(typeCode); }
 
     /**
      * @brief Get transaction amount
      */
-    double getAmount() const { return amount; }
+    Money getAmount() const { return amount; }
 
     /**
      * @brief Get balance after transaction
      */
-    double getBalanceAfter() const { return balanceAfter; }
+    Money getBalanceAfter() const { return balanceAfter; }
 
     /**
      * @brief Get timestamp
      */
-    std::chrono::system_clock::time_point getTimestamp() const { return timestamp; }
+    std::chrono::system_clock::time_point getTimestamp() const {
+        return std::chrono::system_clock::time_point(std::chrono::system_clock::duration(timestamp));
+    }
 
     /**
-     * @brief Get description
+     * @brief Get description, followed by the counterparty for a transfer
      */
-    std::string getDescription() const { return description; }
+    std::string getDescription() const;
+
+    /**
+     * @brief Append getDescription() to a caller-owned buffer
+     */
+    void appendDescription(std::string& out) const;
+
+    /**
+     * @brief Get the interned description id
+     */
+    uint32_t getDescriptionId() const { return descriptionId; }
+
+    /**
+     * @brief Get the other account of a transfer (0 for other types)
+     */
+    int getCounterparty() const { return counterparty; }
 
     /**
      * @brief Convert transaction to string format
      */
     std::string toString() const;
 
+    /**
+     * @brief Append the toString() text to a caller-owned buffer
+     *
+     * Reusing one buffer across rows renders a statement without allocating
+     * once the buffer has grown to the longest row.
+     */
+    void appendTo(std::string& out) const;
+
     /**
      * @brief Serialize transaction to string for file storage
      */
@@ -72,6 +144,26 @@ public:
      */
     static Transaction deserialize(const std::string& data);
 
+    /**
+     * @brief Parse a serialized transaction line without exceptions or temporaries
+     * @param data Line in serialize() format
+     * @param out Transaction to overwrite (unchanged on error)
+     */
+    static ParseError parse(std::string_view data, Transaction& out);
+
+    /**
+     * @brief Append transaction to a binary snapshot buffer
+     */
+    void serializeBinary(BinaryWriter& out) const;
+
+    /**
+     * @brief Read transaction from a binary snapshot buffer
+     * @param amounts Amount format of the containing file
+     * @param times Timestamp format of the containing file
+     */
+    static Transaction deserializeBinary(BinaryReader& in, AmountFormat amounts = AmountFormat::PAISE,
+                                         TimestampFormat times = TimestampFormat::TICKS);
+
     /**
      * @brief Convert transaction type to string
      */
@@ -83,4 +175,6 @@ public:
     static Type stringToType(const std::string& s);
 };
 
+static_assert(std::is_trivially_copyable<Transaction>::value, "Transaction must stay trivially copyable");
+
 #endif // TRANSACTION_H
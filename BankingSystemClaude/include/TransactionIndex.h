@@ -0,0 +1,74 @@
+#ifndef TRANSACTION_INDEX_H
+#define TRANSACTION_INDEX_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Transaction.h"
+
+/**
+ * @brief Time-ordered index of one account's logged transactions
+ *
+ * Record locations are kept sorted by timestamp, with one bitmap per
+ * transaction type over the same positions. A time-range query finds its
+ * bounds by binary search and, when filtering by type, ORs the bitmaps of
+ * the wanted types a word at a time, so it costs O(log n + k) plus one word
+ * per 64 transactions in the range instead of a walk over the whole history.
+ *
+ * Not thread-safe; TransactionLog guards its indexes with its own mutex.
+ */
+class TransactionIndex {
+public:
+    /**
+     * @brief Where one record lives in the transaction log
+     */
+    struct Location {
+        uint32_t segment;
+        uint32_t offset;    // Byte offset of the record inside the segment file
+        int64_t timestamp;  // Transaction time in system_clock ticks since the epoch
+    };
+
+private:
+    std::vector<Location> locations;  // Sorted by timestamp; equal timestamps keep append order
+    std::vector<uint64_t> typeBits[Transaction::TYPE_COUNT];  // Bit i set if locations[i] has that type
+
+    /**
+     * @brief Insert a bit at position, shifting later bits up by one
+     */
+    static void insertBit(std::vector<uint64_t>& words, size_t position, size_t bits, bool value);
+
+    /**
+     * @brief First position whose timestamp is not before when
+     */
+    size_t lowerBound(std::chrono::system_clock::time_point when) const;
+
+public:
+    /**
+     * @brief Add a record, keeping timestamp order
+     *
+     * Records normally arrive in time order and are appended; an earlier
+     * timestamp is inserted at its sorted position.
+     */
+    void add(const Location& location, Transaction::Type type);
+
+    /**
+     * @brief Number of indexed records
+     */
+    size_t size() const { return locations.size(); }
+
+    /**
+     * @brief Locations of count records starting at position first, oldest first
+     */
+    std::vector<Location> slice(size_t first, size_t count) const;
+
+    /**
+     * @brief Locations of records with from <= timestamp < to whose type is in typeMask, oldest first
+     * @param typeMask Bitwise OR of Transaction::maskOf() values
+     */
+    std::vector<Location> between(std::chrono::system_clock::time_point from,
+                                  std::chrono::system_clock::time_point to,
+                                  uint32_t typeMask = Transaction::ALL_TYPES) const;
+};
+
+#endif // TRANSACTION_INDEX_H
@@ -0,0 +1,172 @@
+#ifndef TRANSACTION_LOG_H
+#define TRANSACTION_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Transaction.h"
+#include "TransactionIndex.h"
+
+/**
+ * @brief Append-only, segmented store of every transaction of every account
+ *
+ * Accounts keep only their last few transactions in memory; the full history
+ * goes here. Records are appended to the active segment file until it reaches
+ * the segment size, then the segment is sealed: its offset index is written
+ * beside it and a new segment is started. Sealed segments are never modified.
+ *
+ * An in-memory TransactionIndex per account holds the location, time and
+ * type of each of its records, so a history query opens only the segments
+ * that hold the requested records. Opening an existing log loads the index files
+ * of sealed segments and scans only segments that were never sealed; those
+ * are then sealed, and appending always continues in a fresh segment, so a
+ * record torn by a crash is never appended after.
+ *
+ * All methods are thread-safe.
+ */
+class TransactionLog {
+public:
+    static const size_t DEFAULT_SEGMENT_BYTES = 16 * 1024 * 1024;
+
+    using Location = TransactionIndex::Location;
+
+private:
+    /**
+     * @brief One entry of a segment's index file
+     */
+    struct IndexRecord {
+        int accountNumber;
+        Location location;
+        Transaction::Type type;
+    };
+
+    std::string name;
+    std::string dataDirectory;
+    size_t segmentBytes;
+    std::ofstream stream;     // Active segment
+    uint32_t activeSegment;   // 0 until open() succeeds
+    uint32_t activeSize;
+    std::vector<IndexRecord> activeEntries;  // Index of the active segment, in append order
+    std::unordered_map<int, TransactionIndex> index;
+    size_t records;
+
+    mutable std::mutex mutex;
+    mutable std::atomic<size_t> segmentReads;
+    std::atomic<size_t> failedAppends;  // Not yet collected by takeFailedAppends()
+
+    /**
+     * @brief Write the active segment's index file and start the next segment (mutex held)
+     */
+    bool roll();
+
+    /**
+     * @brief Write a segment's index file
+     */
+    bool writeIndex(uint32_t segment, const std::vector<IndexRecord>& entries) const;
+
+    /**
+     * @brief Load a sealed segment's index file into the in-memory index
+     */
+    bool loadIndex(uint32_t segment);
+
+    /**
+     * @brief Index an unsealed segment by scanning its complete records, then seal it
+     */
+    bool recoverSegment(uint32_t segment);
+
+    /**
+     * @brief Add one record to the in-memory index
+     */
+    void addToIndex(const IndexRecord& record);
+
+    /**
+     * @brief Read records in the given order, opening each segment once per run of locations
+     */
+    std::vector<Transaction> readAt(const std::vector<Location>& locations) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param logName Base name of the segment files inside the data directory
+     * @param segmentSize Size at which the active segment is sealed
+     */
+    explicit TransactionLog(const std::string& logName, const std::string& dataDir = "data",
+                            size_t segmentSize = DEFAULT_SEGMENT_BYTES);
+
+    /**
+     * @brief Destructor - seals the active segment
+     */
+    ~TransactionLog();
+
+    TransactionLog(const TransactionLog&) = delete;
+    TransactionLog& operator=(const TransactionLog&) = delete;
+
+    /**
+     * @brief Index existing segments and start a new active segment
+     */
+    bool open();
+
+    /**
+     * @brief Append one transaction of an account and flush it
+     * @return false if the log is not open or the write failed; the failure is
+     *         also counted for takeFailedAppends()
+     */
+    bool append(int accountNumber, const Transaction& trans);
+
+    /**
+     * @brief Number of transactions recorded for an account
+     */
+    size_t count(int accountNumber) const;
+
+    /**
+     * @brief Read a page of an account's history in time order
+     * @param first Position of the first transaction (0 is the oldest)
+     * @param limit Maximum number of transactions to return
+     */
+    std::vector<Transaction> readPage(int accountNumber, size_t first, size_t limit) const;
+
+    /**
+     * @brief Read an account's transactions with from <= timestamp < to, oldest first
+     * @param typeMask Bitwise OR of Transaction::maskOf() values to include
+     */
+    std::vector<Transaction> readRange(int accountNumber, std::chrono::system_clock::time_point from,
+                                       std::chrono::system_clock::time_point to,
+                                       uint32_t typeMask = Transaction::ALL_TYPES) const;
+
+    /**
+     * @brief Total number of records in the log
+     */
+    size_t size() const;
+
+    /**
+     * @brief Number of segment files, including the active one
+     */
+    size_t getSegmentCount() const;
+
+    /**
+     * @brief Number of times a query has opened a segment file
+     */
+    size_t getSegmentReads() const { return segmentReads; }
+
+    /**
+     * @brief Number of appends that failed since the last call
+     */
+    size_t takeFailedAppends() { return failedAppends.exchange(0); }
+
+    /**
+     * @brief Check if the log is open for appending
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get full path of a segment file
+     */
+    std::string getSegmentPath(uint32_t segment) const;
+};
+
+#endif // TRANSACTION_LOG_H
@@ -1,25 +1,55 @@
 #include "Account.h"
-#include <iostream>
-#include <iomanip>
+#include "BinaryIO.h"
+#include "TransactionLog.h"
+#include "MaturityScheduler.h"
 #include <algorithm>
 #include <sstream>
 #include <functional>
 
-Account::Account(int accNum, const std::string& name, const std::string& pass, double initialBalance)
-    : accountNumber(accNum), accountHolderName(name), balance(initialBalance) {
+std::atomic<uint64_t> Account::versionClock(0);
+
+Account::Account(int accNum, const std::string& name, const std::string& pass, Money initialBalance)
+    : accountNumber(accNum), accountHolderName(name), balance(initialBalance), journal(nullptr),
+      transactionLog(nullptr), maturities(nullptr), version(++versionClock), columns(nullptr) {
     
-    if (initialBalance < 0) {
+    if (initialBalance.isNegative()) {
         throw std::invalid_argument("Initial balance cannot be negative");
     }
     
     passwordHash = hashPassword(pass);
     
     // Add initial deposit transaction
-    if (initialBalance > 0) {
-        addTransaction(Transaction::Type::DEPOSIT, initialBalance, "Initial deposit");
+    if (initialBalance.isPositive()) {
+        addTransaction(Transaction::Type::DEPOSIT, initialBalance, DescriptionTable::INITIAL_DEPOSIT);
     }
 }
 
+Account::Account(Restored, int accNum, std::string_view name, std::string_view hash, Money currentBalance)
+    : accountNumber(accNum), accountHolderName(name), passwordHash(hash),
+      balance(currentBalance), journal(nullptr), transactionLog(nullptr), maturities(nullptr), version(0),
+      columns(nullptr) {}
+
+Account::Account(const Account& other)
+    : accountNumber(other.accountNumber), accountHolderName(other.accountHolderName),
+      passwordHash(other.passwordHash), journal(other.journal),
+      transactionLog(nullptr), maturities(nullptr), columns(nullptr) {
+    std::lock_guard<std::mutex> lock(other.mutex);
+    balance = other.balance;
+    transactionHistory = other.transactionHistory;
+    fixedDeposits = other.fixedDeposits;
+    version = other.version;
+}
+
+uint64_t Account::getVersion() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return version;
+}
+
+Money Account::getBalance() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return balance;
+}
+
 std::string Account::hashPassword(const std::string& password) const {
     // Simple hash for demonstration (in production, use proper hashing like bcrypt)
     std::hash<std::string> hasher;
@@ -33,170 +63,501 @@ bool Account::verifyPassword(const std::string& pass) const {
     return hashPassword(pass) == passwordHash;
 }
 
-void Account::addTransaction(Transaction::Type type, double amount, const std::string& desc) {
-    Transaction trans(type, amount, balance, desc);
-    transactionHistory.push_back(trans);
+void Account::addTransaction(Transaction::Type type, Money amount, uint32_t description,
+                             std::chrono::system_clock::time_point when, int counterparty) {
+    // Every balance change records a transaction, so this is the one place to stamp
+    version = ++versionClock;
+    
+    // Constructed in place; a full history drops its oldest entry
+    transactionHistory.emplace_back(type, amount, balance, description, when, counterparty);
+    if (transactionLog != nullptr) {
+        // A failed append is counted by the log and reported by BankManager::takeDiagnostics()
+        transactionLog->append(accountNumber, transactionHistory.back());
+    }
     
-    // Keep only last 5 transactions
-    if (transactionHistory.size() > MAX_TRANSACTION_HISTORY) {
-        transactionHistory.pop_front();
+    publishColumns();
+}
+
+size_t Account::getTransactionCount() const {
+    if (transactionLog != nullptr) {
+        return transactionLog->count(accountNumber);
     }
+    std::lock_guard<std::mutex> lock(mutex);
+    return transactionHistory.size();
 }
 
-bool Account::deposit(double amount) {
-    if (amount <= 0) {
-        std::cout << "❌ Deposit amount must be positive!" << std::endl;
-        return false;
+std::vector<Transaction> Account::getTransactionPage(size_t first, size_t count) const {
+    if (transactionLog != nullptr) {
+        return transactionLog->readPage(accountNumber, first, count);
     }
     
-    balance += amount;
-    addTransaction(Transaction::Type::DEPOSIT, amount, "Cash deposit");
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Transaction> page;
+    for (size_t i = first; i < transactionHistory.size() && page.size() < count; ++i) {
+        page.push_back(transactionHistory[i]);
+    }
+    return page;
+}
+
+std::vector<Transaction> Account::transactionsBetween(std::chrono::system_clock::time_point from,
+                                                      std::chrono::system_clock::time_point to,
+                                                      uint32_t typeMask) const {
+    if (transactionLog != nullptr) {
+        return transactionLog->readRange(accountNumber, from, to, typeMask);
+    }
+    
+    // Only the few recent transactions are in memory, so a scan is cheapest
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Transaction> matches;
+    for (const auto& trans : transactionHistory) {
+        if (trans.getTimestamp() >= from && trans.getTimestamp() < to &&
+            (typeMask & Transaction::maskOf(trans.getType())) != 0) {
+            matches.push_back(trans);
+        }
+    }
+    return matches;
+}
+
+void Account::publishColumns() {
+    if (columns != nullptr) {
+        AccountColumns::publish(columnCell, balance, fixedDepositPrincipal(),
+                                static_cast<uint32_t>(fixedDeposits.size()));
+    }
+}
+
+void Account::addFixedDeposit(std::shared_ptr<FixedDeposit> fd) {
+    if (maturities != nullptr) {
+        maturities->schedule(accountNumber, fd->getMaturityTime());
+    }
+    if (columns != nullptr) {
+        depositCells.push_back(columns->deposits().attach(accountNumber, *fd));
+    }
+    fixedDeposits.push_back(std::move(fd));
+}
+
+std::shared_ptr<FixedDeposit> Account::removeFixedDeposit(size_t index) {
+    std::shared_ptr<FixedDeposit> fd = fixedDeposits[index];
+    fixedDeposits.erase(fixedDeposits.begin() + static_cast<std::ptrdiff_t>(index));
+    if (columns != nullptr) {
+        columns->deposits().release(depositCells[index]);
+        depositCells.erase(depositCells.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+    return fd;
+}
+
+Money Account::fixedDepositPrincipal() const {
+    Money total;
+    for (const auto& fd : fixedDeposits) {
+        total += fd->getPrincipal();
+    }
+    return total;
+}
+
+void Account::attachColumns(AccountColumns* target) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (columns == target) {
+        return;
+    }
+    if (columns != nullptr) {
+        for (const auto& cell : depositCells) {
+            columns->deposits().release(cell);
+        }
+        depositCells.clear();
+        columns->release(columnCell);
+    }
+    columns = target;
+    if (columns != nullptr) {
+        columnCell = columns->attach(accountNumber, balance, fixedDepositPrincipal(),
+                                     static_cast<uint32_t>(fixedDeposits.size()));
+        for (const auto& fd : fixedDeposits) {
+            depositCells.push_back(columns->deposits().attach(accountNumber, *fd));
+        }
+    }
+}
+
+void Account::detachColumns(AccountColumns* from) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (columns != nullptr && columns == from) {
+        for (const auto& cell : depositCells) {
+            columns->deposits().release(cell);
+        }
+        depositCells.clear();
+        columns->release(columnCell);
+        columns = nullptr;
+    }
+}
+
+JournalEntry Account::operationEntry(JournalEntry::Operation op, Money amount, int tenure) const {
+    JournalEntry entry;
+    entry.operation = op;
+    entry.accountNumber = accountNumber;
+    entry.amount = amount;
+    entry.tenure = tenure;
+    entry.timestamp = std::chrono::system_clock::to_time_t(transactionHistory.back().getTimestamp());
+    return entry;
+}
+
+JournalEntry Account::maturityEntry(const FixedDeposit& fd) const {
+    JournalEntry entry = operationEntry(JournalEntry::Operation::FD_MATURITY, fd.getPrincipal(), fd.getTenure());
+    entry.timestamp = std::chrono::system_clock::to_time_t(fd.getOpenDate());
+    return entry;
+}
+
+std::shared_lock<std::shared_mutex> Account::admitOperation() const {
+    return journal != nullptr ? journal->admitOperation() : std::shared_lock<std::shared_mutex>();
+}
+
+void Account::recordOperation(JournalEntry::Operation op, Money amount, int tenure) {
+    if (journal == nullptr) {
+        return;
+    }
+    
+    journal->append(operationEntry(op, amount, tenure));
+}
+
+namespace {
+std::future<bool> readyFuture(bool value) {
+    std::promise<bool> result;
+    result.set_value(value);
+    return result.get_future();
+}
+
+/**
+ * Description id for an FD opening; the standard tenures are interned up front
+ */
+uint32_t fdOpenedDescription(int tenure) {
+    switch (tenure) {
+        case 12: return DescriptionTable::FD_OPENED_12_MONTHS;
+        case 24: return DescriptionTable::FD_OPENED_24_MONTHS;
+        default: return DescriptionTable::intern("FD opened for " + std::to_string(tenure) + " months");
+    }
+}
+}
+
+std::future<bool> Account::recordOperationDurable(JournalEntry::Operation op, Money amount) {
+    if (journal == nullptr) {
+        return readyFuture(true);
+    }
     
-    std::cout << "✅ Successfully deposited ₹" << std::fixed << std::setprecision(2) 
-              << amount << std::endl;
-    std::cout << "Current balance: ₹" << balance << std::endl;
+    return journal->appendDurable(operationEntry(op, amount));
+}
+
+OperationResult Account::deposit(Money amount) {
+    std::shared_lock<std::shared_mutex> gate = admitOperation();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!amount.isPositive()) {
+        return OperationResult::INVALID_AMOUNT;
+    }
     
-    return true;
+    balance += amount;
+    addTransaction(Transaction::Type::DEPOSIT, amount, DescriptionTable::CASH_DEPOSIT);
+    recordOperation(JournalEntry::Operation::DEPOSIT, amount);
+    return OperationResult::OK;
 }
 
-bool Account::withdraw(double amount) {
-    if (amount <= 0) {
-        std::cout << "❌ Withdrawal amount must be positive!" << std::endl;
-        return false;
+OperationResult Account::withdraw(Money amount) {
+    std::shared_lock<std::shared_mutex> gate = admitOperation();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!amount.isPositive()) {
+        return OperationResult::INVALID_AMOUNT;
     }
     
     if (amount > balance) {
-        std::cout << "❌ Insufficient balance! Available: ₹" << std::fixed 
-                  << std::setprecision(2) << balance << std::endl;
-        return false;
+        return OperationResult::INSUFFICIENT_BALANCE;
     }
     
     balance -= amount;
-    addTransaction(Transaction::Type::WITHDRAWAL, amount, "Cash withdrawal");
+    addTransaction(Transaction::Type::WITHDRAWAL, amount, DescriptionTable::CASH_WITHDRAWAL);
+    recordOperation(JournalEntry::Operation::WITHDRAWAL, amount);
+    return OperationResult::OK;
+}
+
+std::future<bool> Account::depositAsync(Money amount) {
+    std::shared_lock<std::shared_mutex> gate = admitOperation();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!amount.isPositive()) {
+        return readyFuture(false);
+    }
     
-    std::cout << "✅ Successfully withdrawn ₹" << std::fixed << std::setprecision(2) 
-              << amount << std::endl;
-    std::cout << "Current balance: ₹" << balance << std::endl;
+    balance += amount;
+    addTransaction(Transaction::Type::DEPOSIT, amount, DescriptionTable::CASH_DEPOSIT);
+    return recordOperationDurable(JournalEntry::Operation::DEPOSIT, amount);
+}
+
+std::future<bool> Account::withdrawAsync(Money amount) {
+    std::shared_lock<std::shared_mutex> gate = admitOperation();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!amount.isPositive() || amount > balance) {
+        return readyFuture(false);
+    }
     
-    return true;
+    balance -= amount;
+    addTransaction(Transaction::Type::WITHDRAWAL, amount, DescriptionTable::CASH_WITHDRAWAL);
+    return recordOperationDurable(JournalEntry::Operation::WITHDRAWAL, amount);
 }
 
-void Account::displayBalance() const {
-    std::cout << "\n" << std::string(50, '=') << std::endl;
-    std::cout << "💰 BALANCE ENQUIRY" << std::endl;
-    std::cout << std::string(50, '=') << std::endl;
-    std::cout << "Account Number: " << accountNumber << std::endl;
-    std::cout << "Account Holder: " << accountHolderName << std::endl;
-    std::cout << "Current Balance: ₹" << std::fixed << std::setprecision(2) 
-              << balance << std::endl;
-    std::cout << std::string(50, '=') << std::endl;
-}
-
-void Account::displayAccountDetails() const {
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "📋 ACCOUNT DETAILS" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
-    std::cout << "Account Number    : " << accountNumber << std::endl;
-    std::cout << "Account Holder    : " << accountHolderName << std::endl;
-    std::cout << "Current Balance   : ₹" << std::fixed << std::setprecision(2) 
-              << balance << std::endl;
-    std::cout << "Active FDs        : " << fixedDeposits.size() << std::endl;
-    
-    if (!fixedDeposits.empty()) {
-        double totalFDAmount = 0;
-        for (const auto& fd : fixedDeposits) {
-            totalFDAmount += fd->getPrincipal();
+size_t Account::applyBatch(const std::vector<BatchOperation>& operations, const std::vector<size_t>& indices,
+                           std::vector<BatchResult>& results) {
+    std::shared_lock<std::shared_mutex> gate = admitOperation();
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<JournalEntry> entries;
+    size_t applied = 0;
+    
+    for (size_t index : indices) {
+        const BatchOperation& op = operations[index];
+        if (!op.amount.isPositive()) {
+            results[index] = BatchResult::INVALID_AMOUNT;
+            continue;
+        }
+        
+        if (op.type == BatchOperation::Type::DEPOSIT) {
+            balance += op.amount;
+            addTransaction(Transaction::Type::DEPOSIT, op.amount, DescriptionTable::CASH_DEPOSIT);
+            if (journal != nullptr) {
+                entries.push_back(operationEntry(JournalEntry::Operation::DEPOSIT, op.amount));
+            }
+        } else {
+            if (op.amount > balance) {
+                results[index] = BatchResult::INSUFFICIENT_BALANCE;
+                continue;
+            }
+            balance -= op.amount;
+            addTransaction(Transaction::Type::WITHDRAWAL, op.amount, DescriptionTable::CASH_WITHDRAWAL);
+            if (journal != nullptr) {
+                entries.push_back(operationEntry(JournalEntry::Operation::WITHDRAWAL, op.amount));
+            }
         }
-        std::cout << "Total FD Amount   : ₹" << std::fixed << std::setprecision(2) 
-                  << totalFDAmount << std::endl;
+        results[index] = BatchResult::OK;
+        ++applied;
     }
     
-    std::cout << std::string(60, '=') << std::endl;
+    if (!entries.empty()) {
+        journal->appendBatch(entries);
+    }
+    return applied;
 }
 
-void Account::displayTransactionHistory() const {
-    std::cout << "\n" << std::string(80, '=') << std::endl;
-    std::cout << "📜 TRANSACTION HISTORY (Last " << transactionHistory.size() << " transactions)" << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
+TransferResult Account::transfer(Account& from, Account& to, Money amount) {
+    if (!amount.isPositive()) {
+        return TransferResult::INVALID_AMOUNT;
+    }
+    if (&from == &to || from.accountNumber == to.accountNumber) {
+        return TransferResult::SAME_ACCOUNT;
+    }
+    
+    Journal* journal = from.journal != nullptr ? from.journal : to.journal;
+    std::shared_lock<std::shared_mutex> gate;
+    if (journal != nullptr) {
+        gate = journal->admitOperation();
+    }
+    std::unique_lock<std::mutex> fromLock(from.mutex, std::defer_lock);
+    std::unique_lock<std::mutex> toLock(to.mutex, std::defer_lock);
     
-    if (transactionHistory.empty()) {
-        std::cout << "No transactions yet." << std::endl;
-    } else {
-        int count = 1;
-        for (const auto& trans : transactionHistory) {
-            std::cout << count++ << ". " << trans.toString() << std::endl;
+    // Fast path: take both locks without waiting; on contention fall back to
+    // blocking in account-number order, which no opposing transfer can invert
+    if (fromLock.try_lock() && !toLock.try_lock()) {
+        fromLock.unlock();
+    }
+    if (!toLock.owns_lock()) {
+        if (from.accountNumber < to.accountNumber) {
+            fromLock.lock();
+            toLock.lock();
+        } else {
+            toLock.lock();
+            fromLock.lock();
         }
     }
     
-    std::cout << std::string(80, '=') << std::endl;
+    if (amount > from.balance) {
+        return TransferResult::INSUFFICIENT_BALANCE;
+    }
+    
+    auto now = std::chrono::system_clock::now();
+    from.balance -= amount;
+    from.addTransaction(Transaction::Type::TRANSFER, amount, DescriptionTable::TRANSFER_TO, now, to.accountNumber);
+    to.balance += amount;
+    to.addTransaction(Transaction::Type::TRANSFER, amount, DescriptionTable::TRANSFER_FROM, now, from.accountNumber);
+    
+    if (journal != nullptr) {
+        JournalEntry entry = from.operationEntry(JournalEntry::Operation::TRANSFER, amount);
+        entry.counterparty = to.accountNumber;
+        journal->append(entry);
+    }
+    
+    return TransferResult::OK;
 }
 
-bool Account::openFixedDeposit(double amount, int tenure) {
-    if (amount <= 0) {
-        std::cout << "❌ FD amount must be positive!" << std::endl;
-        return false;
+OperationResult Account::openFixedDeposit(Money amount, int tenure) {
+    std::shared_lock<std::shared_mutex> gate = admitOperation();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!amount.isPositive()) {
+        return OperationResult::INVALID_AMOUNT;
     }
     
     if (tenure != 12 && tenure != 24) {
-        std::cout << "❌ FD tenure must be 12 or 24 months!" << std::endl;
-        return false;
+        return OperationResult::INVALID_TENURE;
     }
     
     if (amount > balance) {
-        std::cout << "❌ Insufficient balance! Available: ₹" << std::fixed 
-                  << std::setprecision(2) << balance << std::endl;
-        return false;
+        return OperationResult::INSUFFICIENT_BALANCE;
     }
     
-    try {
-        auto fd = std::make_shared<FixedDeposit>(amount, tenure);
-        fixedDeposits.push_back(fd);
-        
-        balance -= amount;
-        std::stringstream desc;
-        desc << "FD opened for " << tenure << " months";
-        addTransaction(Transaction::Type::FD_OPEN, amount, desc.str());
-        
-        std::cout << "\n✅ Fixed Deposit opened successfully!" << std::endl;
-        std::cout << "FD Amount         : ₹" << std::fixed << std::setprecision(2) 
-                  << amount << std::endl;
-        std::cout << "Tenure            : " << tenure << " months" << std::endl;
-        std::cout << "Interest Rate     : " << fd->getInterestRate() << "%" << std::endl;
-        std::cout << "Maturity Amount   : ₹" << fd->calculateMaturityAmount() << std::endl;
-        std::cout << "Maturity Date     : " << fd->getMaturityDate() << std::endl;
-        std::cout << "Remaining Balance : ₹" << balance << std::endl;
-        
-        return true;
-    } catch (const std::exception& e) {
-        std::cout << "❌ Error opening FD: " << e.what() << std::endl;
-        return false;
+    auto fd = std::make_shared<FixedDeposit>(amount, tenure);
+    addFixedDeposit(fd);
+    
+    balance -= amount;
+    addTransaction(Transaction::Type::FD_OPEN, amount, fdOpenedDescription(tenure), fd->getOpenDate());
+    recordOperation(JournalEntry::Operation::FD_OPEN, amount, tenure);
+    return OperationResult::OK;
+}
+
+void Account::setMaturityScheduler(MaturityScheduler* scheduler) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (maturities == scheduler) {
+        return;
+    }
+    maturities = scheduler;
+    if (maturities != nullptr) {
+        for (const auto& fd : fixedDeposits) {
+            maturities->schedule(accountNumber, fd->getMaturityTime());
+        }
     }
 }
 
-void Account::displayFixedDeposits() const {
-    std::cout << "\n" << std::string(80, '=') << std::endl;
-    std::cout << "💎 FIXED DEPOSITS" << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
+size_t Account::creditMaturedDeposits(std::chrono::system_clock::time_point now) {
+    std::shared_lock<std::shared_mutex> gate = admitOperation();
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::shared_ptr<FixedDeposit>> matured;
+    for (size_t i = fixedDeposits.size(); i-- > 0;) {
+        if (fixedDeposits[i]->getMaturityTime() <= now) {
+            matured.push_back(removeFixedDeposit(i));
+        }
+    }
+    std::reverse(matured.begin(), matured.end());
+    
+    // Credit in maturity order so the history reads the way it happened
+    std::stable_sort(matured.begin(), matured.end(),
+        [](const std::shared_ptr<FixedDeposit>& a, const std::shared_ptr<FixedDeposit>& b) {
+            return a->getMaturityTime() < b->getMaturityTime();
+        });
+    
+    std::vector<JournalEntry> entries;
+    for (const auto& fd : matured) {
+        Money credit = fd->calculateMaturityAmount();
+        balance += credit;
+        addTransaction(Transaction::Type::FD_MATURITY, credit, DescriptionTable::FD_MATURED, fd->getMaturityTime());
+        if (journal != nullptr) {
+            entries.push_back(maturityEntry(*fd));
+        }
+    }
     
+    if (!entries.empty()) {
+        journal->appendBatch(entries);
+    }
+    return matured.size();
+}
+
+bool Account::nextMaturity(std::chrono::system_clock::time_point& when) const {
+    std::lock_guard<std::mutex> lock(mutex);
     if (fixedDeposits.empty()) {
-        std::cout << "No active fixed deposits." << std::endl;
-    } else {
-        int count = 1;
-        for (const auto& fd : fixedDeposits) {
-            std::cout << "\nFD #" << count++ << ":" << std::endl;
-            std::cout << "  Principal        : ₹" << std::fixed << std::setprecision(2) 
-                      << fd->getPrincipal() << std::endl;
-            std::cout << "  Tenure           : " << fd->getTenure() << " months" << std::endl;
-            std::cout << "  Interest Rate    : " << fd->getInterestRate() << "%" << std::endl;
-            std::cout << "  Maturity Amount  : ₹" << fd->calculateMaturityAmount() << std::endl;
-            std::cout << "  Maturity Date    : " << fd->getMaturityDate() << std::endl;
+        return false;
+    }
+    when = fixedDeposits.front()->getMaturityTime();
+    for (const auto& fd : fixedDeposits) {
+        when = std::min(when, fd->getMaturityTime());
+    }
+    return true;
+}
+
+JournalEntry Account::creationEntry() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    JournalEntry entry;
+    entry.operation = JournalEntry::Operation::CREATE_ACCOUNT;
+    entry.accountNumber = accountNumber;
+    entry.amount = balance;
+    entry.timestamp = transactionHistory.empty()
+        ? std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())
+        : std::chrono::system_clock::to_time_t(transactionHistory.front().getTimestamp());
+    entry.passwordHash = passwordHash;
+    entry.holderName = accountHolderName;
+    return entry;
+}
+
+void Account::replay(const JournalEntry& entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto when = std::chrono::system_clock::from_time_t(entry.timestamp);
+    if (entry.operation == JournalEntry::Operation::CREATE_ACCOUNT) {
+        throw std::runtime_error("CREATE_ACCOUNT cannot be replayed onto an existing account");
+    }
+    
+    // The transaction log already holds whatever it received before the restart
+    TransactionLog* log = transactionLog;
+    transactionLog = nullptr;
+    
+    switch (entry.operation) {
+        case JournalEntry::Operation::DEPOSIT:
+            balance += entry.amount;
+            addTransaction(Transaction::Type::DEPOSIT, entry.amount, DescriptionTable::CASH_DEPOSIT, when);
+            break;
+        case JournalEntry::Operation::WITHDRAWAL:
+            balance -= entry.amount;
+            addTransaction(Transaction::Type::WITHDRAWAL, entry.amount, DescriptionTable::CASH_WITHDRAWAL, when);
+            break;
+        case JournalEntry::Operation::FD_OPEN: {
+            addFixedDeposit(std::make_shared<FixedDeposit>(entry.amount, entry.tenure, when));
+            balance -= entry.amount;
+            addTransaction(Transaction::Type::FD_OPEN, entry.amount, fdOpenedDescription(entry.tenure), when);
+            break;
         }
+        case JournalEntry::Operation::FD_MATURITY: {
+            auto matured = std::find_if(fixedDeposits.begin(), fixedDeposits.end(),
+                [&entry](const std::shared_ptr<FixedDeposit>& fd) {
+                    return fd->getPrincipal() == entry.amount && fd->getTenure() == entry.tenure &&
+                           std::chrono::system_clock::to_time_t(fd->getOpenDate()) == entry.timestamp;
+                });
+            if (matured != fixedDeposits.end()) {
+                std::shared_ptr<FixedDeposit> fd =
+                    removeFixedDeposit(static_cast<size_t>(matured - fixedDeposits.begin()));
+                Money credit = fd->calculateMaturityAmount();
+                balance += credit;
+                addTransaction(Transaction::Type::FD_MATURITY, credit, DescriptionTable::FD_MATURED,
+                               fd->getMaturityTime());
+            }
+            break;
+        }
+        case JournalEntry::Operation::TRANSFER:
+            if (entry.accountNumber == accountNumber) {
+                balance -= entry.amount;
+                addTransaction(Transaction::Type::TRANSFER, entry.amount, DescriptionTable::TRANSFER_TO, when,
+                               entry.counterparty);
+            } else {
+                balance += entry.amount;
+                addTransaction(Transaction::Type::TRANSFER, entry.amount, DescriptionTable::TRANSFER_FROM, when,
+                               entry.accountNumber);
+            }
+            break;
+        case JournalEntry::Operation::CREATE_ACCOUNT:
+            break;
     }
     
-    std::cout << std::string(80, '=') << std::endl;
+    transactionLog = log;
+}
+
+std::shared_ptr<Account> Account::restore(const JournalEntry& entry) {
+    std::shared_ptr<Account> account(
+        new Account(Restored(), entry.accountNumber, entry.holderName, entry.passwordHash, entry.amount));
+    account->version = ++versionClock;  // Not in any snapshot yet
+    
+    if (entry.amount.isPositive()) {
+        account->addTransaction(Transaction::Type::DEPOSIT, entry.amount, DescriptionTable::INITIAL_DEPOSIT,
+                                std::chrono::system_clock::from_time_t(entry.timestamp));
+    }
+    
+    return account;
 }
 
 std::string Account::serialize() const {
+    std::lock_guard<std::mutex> lock(mutex);
     std::stringstream ss;
     
     // Format: accNum|name|passwordHash|balance
@@ -221,59 +582,144 @@ std::string Account::serialize() const {
 }
 
 std::shared_ptr<Account> Account::deserialize(const std::string& data) {
-    std::stringstream ss(data);
-    std::string line;
-    
-    // Parse account info
-    std::getline(ss, line);
-    std::stringstream lineStream(line);
-    std::string token;
-    std::vector<std::string> tokens;
-    
-    while (std::getline(lineStream, token, '|')) {
-        tokens.push_back(token);
+    std::shared_ptr<Account> account;
+    ParseError error = parse(data, account);
+    if (error != ParseError::NONE) {
+        throw std::runtime_error(std::string("Invalid account data: ") + parseErrorMessage(error));
     }
-    
-    if (tokens.size() < 4) {
-        throw std::runtime_error("Invalid account data");
+    return account;
+}
+
+ParseError Account::parse(std::string_view data, std::shared_ptr<Account>& out) {
+    TextScanner lines(data);
+    
+    // Parse account info: accNum|name|passwordHash|balance
+    TextScanner fields(lines.nextLine());
+    std::string_view numberField = fields.nextField();
+    std::string_view name = fields.nextField();
+    std::string_view passHash = fields.nextField();
+    if (fields.atEnd()) {
+        return ParseError::MISSING_FIELD;
     }
+    std::string_view balanceField = fields.nextField();
     
-    int accNum = std::stoi(tokens[0]);
-    std::string name = tokens[1];
-    std::string passHash = tokens[2];
-    double balance = std::stod(tokens[3]);
+    int accNum;
+    Money balance;
+    if (!TextScanner::parseNumber(numberField, accNum) ||
+        !Money::parse(balanceField, balance)) {
+        return ParseError::INVALID_NUMBER;
+    }
     
-    // Create account with dummy password (hash is stored)
-    auto account = std::make_shared<Account>(accNum, name, "dummy", 0);
-    account->passwordHash = passHash;
-    account->balance = balance;
-    account->transactionHistory.clear(); // Remove initial transaction
+    // Constructed directly: make_shared cannot reach the private restore constructor
+    std::shared_ptr<Account> account(new Account(Restored(), accNum, name, passHash, balance));
     
     // Parse transactions
-    std::getline(ss, line);
-    if (line.find("TRANSACTIONS:") == 0) {
-        int transCount = std::stoi(line.substr(13));
-        for (int i = 0; i < transCount; ++i) {
-            std::getline(ss, line);
-            if (!line.empty()) {
-                account->transactionHistory.push_back(Transaction::deserialize(line));
+    std::string_view line = lines.nextLine();
+    size_t count;
+    if (TextScanner::parsePrefixed(line, "TRANSACTIONS:", count)) {
+        for (size_t i = 0; i < count; ++i) {
+            line = lines.nextLine();
+            if (line.empty()) {
+                continue;
+            }
+            account->transactionHistory.emplace_back(Transaction::Type::DEPOSIT, Money(), Money(), DescriptionTable::NONE,
+                                                     std::chrono::system_clock::time_point());
+            ParseError error = Transaction::parse(line, account->transactionHistory.back());
+            if (error != ParseError::NONE) {
+                return error;
             }
         }
     }
     
     // Parse FDs
-    std::getline(ss, line);
-    if (line.find("FDS:") == 0) {
-        int fdCount = std::stoi(line.substr(4));
-        for (int i = 0; i < fdCount; ++i) {
-            std::getline(ss, line);
-            if (!line.empty()) {
-                account->fixedDeposits.push_back(
-                    std::make_shared<FixedDeposit>(FixedDeposit::deserialize(line))
-                );
+    line = lines.nextLine();
+    if (TextScanner::parsePrefixed(line, "FDS:", count)) {
+        account->fixedDeposits.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            line = lines.nextLine();
+            if (line.empty()) {
+                continue;
+            }
+            std::shared_ptr<FixedDeposit> fd;
+            ParseError error = FixedDeposit::parse(line, fd);
+            if (error != ParseError::NONE) {
+                return error;
             }
+            account->fixedDeposits.push_back(std::move(fd));
         }
     }
     
+    out = std::move(account);
+    return ParseError::NONE;
+}
+
+void Account::serializeBinary(BinaryWriter& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Record: u32 recordLength, then a fixed-width header
+    // i32 accNum | i64 balance | u32 txCount | u32 fdCount | u16 nameLen | u16 hashLen
+    // followed by name, hash and the length-prefixed transaction and FD sections.
+    size_t recordStart = out.position();
+    out.writeU32(0);
+
+    out.writeI32(accountNumber);
+    out.writeMoney(balance);
+    out.writeU32(static_cast<uint32_t>(transactionHistory.size()));
+    out.writeU32(static_cast<uint32_t>(fixedDeposits.size()));
+    out.writeU16(static_cast<uint16_t>(accountHolderName.size()));
+    out.writeU16(static_cast<uint16_t>(passwordHash.size()));
+    out.writeBytes(accountHolderName.data(), accountHolderName.size());
+    out.writeBytes(passwordHash.data(), passwordHash.size());
+
+    size_t sectionStart = out.position();
+    out.writeU32(0);
+    for (const auto& trans : transactionHistory) {
+        trans.serializeBinary(out);
+    }
+    out.patchU32(sectionStart, static_cast<uint32_t>(out.position() - sectionStart - 4));
+
+    sectionStart = out.position();
+    out.writeU32(0);
+    for (const auto& fd : fixedDeposits) {
+        fd->serializeBinary(out);
+    }
+    out.patchU32(sectionStart, static_cast<uint32_t>(out.position() - sectionStart - 4));
+
+    out.patchU32(recordStart, static_cast<uint32_t>(out.position() - recordStart - 4));
+}
+
+std::shared_ptr<Account> Account::deserializeBinary(BinaryReader& in, AmountFormat amounts, TimestampFormat times) {
+    uint32_t recordLength = in.readU32();
+    in.require(recordLength);
+    BinaryReader record(in.data(), recordLength);
+    in.skip(recordLength);
+
+    int accNum = record.readI32();
+    Money balance = record.readMoney(amounts);
+    uint32_t transCount = record.readU32();
+    uint32_t fdCount = record.readU32();
+    uint16_t nameLength = record.readU16();
+    uint16_t hashLength = record.readU16();
+    std::string name = record.readString(nameLength);
+    std::string passHash = record.readString(hashLength);
+
+    std::shared_ptr<Account> account(new Account(Restored(), accNum, name, passHash, balance));
+
+    uint32_t sectionLength = record.readU32();
+    BinaryReader transSection(record.data(), sectionLength);
+    record.skip(sectionLength);
+    for (uint32_t i = 0; i < transCount; ++i) {
+        account->transactionHistory.emplace_back(Transaction::deserializeBinary(transSection, amounts, times));
+    }
+
+    sectionLength = record.readU32();
+    BinaryReader fdSection(record.data(), sectionLength);
+    record.skip(sectionLength);
+    account->fixedDeposits.reserve(fdCount);
+    for (uint32_t i = 0; i < fdCount; ++i) {
+        account->fixedDeposits.push_back(
+            std::make_shared<FixedDeposit>(FixedDeposit::deserializeBinary(fdSection, amounts))
+        );
+    }
+
     return account;
 }
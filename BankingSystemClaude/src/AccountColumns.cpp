@@ -0,0 +1,171 @@
+#include "AccountColumns.h"
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * Sum a paise column. Integer addition is associative, so the lanes can be
+ * added in any order and the result is exact: AVX2 adds four values per
+ * instruction, SSE2 two, and the portable loop keeps four independent
+ * accumulators so consecutive additions do not wait on each other.
+ */
+int64_t sumColumn(const int64_t* values, size_t count) {
+    size_t i = 0;
+    int64_t lanes[4] = {0, 0, 0, 0};
+#if defined(__AVX2__)
+    __m256i sum = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        sum = _mm256_add_epi64(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sum);
+#elif defined(__SSE2__)
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        sum0 = _mm_add_epi64(sum0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+        sum1 = _mm_add_epi64(sum1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 2)));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 2), sum1);
+#else
+    for (; i + 4 <= count; i += 4) {
+        lanes[0] += values[i];
+        lanes[1] += values[i + 1];
+        lanes[2] += values[i + 2];
+        lanes[3] += values[i + 3];
+    }
+#endif
+    for (; i < count; ++i) {
+        lanes[0] += values[i];
+    }
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+}
+
+AccountColumns::AccountColumns() : nextRow(0), rows(0) {}
+
+size_t AccountColumns::usedRows(size_t chunk) const {
+    size_t used = nextRow - chunk * CHUNK_ROWS;
+    return used < CHUNK_ROWS ? used : CHUNK_ROWS;
+}
+
+AccountColumns::Cell AccountColumns::attach(int accountNumber, Money balance, Money fdPrincipal,
+                                            uint32_t fdCount) {
+    Cell cell;
+    {
+        std::unique_lock<std::shared_mutex> lock(chunksMutex);
+        if (!freeRows.empty()) {
+            cell.index = freeRows.back();
+            freeRows.pop_back();
+        } else {
+            cell.index = nextRow++;
+            if (cell.index / CHUNK_ROWS == chunks.size()) {
+                chunks.emplace_back(new Chunk());
+            }
+        }
+        cell.chunk = chunks[cell.index / CHUNK_ROWS].get();
+        cell.row = cell.index % CHUNK_ROWS;
+        ++rows;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(cell.chunk->mutex);
+    cell.chunk->occupied[cell.row] = true;
+    cell.chunk->accountNumbers[cell.row] = accountNumber;
+    cell.chunk->balances[cell.row] = balance.toPaise();
+    cell.chunk->fdPrincipal[cell.row] = fdPrincipal.toPaise();
+    cell.chunk->fdCounts[cell.row] = fdCount;
+    return cell;
+}
+
+void AccountColumns::publish(const Cell& cell, Money balance, Money fdPrincipal, uint32_t fdCount) {
+    // Rows are disjoint, so writers only need to keep scans out
+    std::shared_lock<std::shared_mutex> lock(cell.chunk->mutex);
+    cell.chunk->balances[cell.row] = balance.toPaise();
+    cell.chunk->fdPrincipal[cell.row] = fdPrincipal.toPaise();
+    cell.chunk->fdCounts[cell.row] = fdCount;
+}
+
+void AccountColumns::release(const Cell& cell) {
+    {
+        std::unique_lock<std::shared_mutex> lock(cell.chunk->mutex);
+        cell.chunk->occupied[cell.row] = false;
+        cell.chunk->accountNumbers[cell.row] = 0;
+        cell.chunk->balances[cell.row] = 0;
+        cell.chunk->fdPrincipal[cell.row] = 0;
+        cell.chunk->fdCounts[cell.row] = 0;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(chunksMutex);
+    freeRows.push_back(cell.index);
+    --rows;
+}
+
+size_t AccountColumns::size() const {
+    std::shared_lock<std::shared_mutex> lock(chunksMutex);
+    return rows;
+}
+
+Money AccountColumns::totalBalance() const {
+    std::shared_lock<std::shared_mutex> lock(chunksMutex);
+    int64_t total = 0;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        std::unique_lock<std::shared_mutex> chunkLock(chunks[c]->mutex);
+        total += sumColumn(chunks[c]->balances, usedRows(c));
+    }
+    return Money::fromPaise(total);
+}
+
+Money AccountColumns::totalFdPrincipal() const {
+    std::shared_lock<std::shared_mutex> lock(chunksMutex);
+    int64_t total = 0;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        std::unique_lock<std::shared_mutex> chunkLock(chunks[c]->mutex);
+        total += sumColumn(chunks[c]->fdPrincipal, usedRows(c));
+    }
+    return Money::fromPaise(total);
+}
+
+BalanceSummary AccountColumns::summarize(const std::vector<Money>& bucketBounds) const {
+    BalanceSummary summary;
+    summary.bucketBounds = bucketBounds;
+    summary.bucketCounts.assign(bucketBounds.size() + 1, 0);
+    bool first = true;
+
+    std::shared_lock<std::shared_mutex> lock(chunksMutex);
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        const Chunk& chunk = *chunks[c];
+        size_t used = usedRows(c);
+        std::unique_lock<std::shared_mutex> chunkLock(chunk.mutex);
+
+        // Free rows are zeroed, so sums can run over every row
+        summary.totalBalance += Money::fromPaise(sumColumn(chunk.balances, used));
+        summary.totalFdPrincipal += Money::fromPaise(sumColumn(chunk.fdPrincipal, used));
+        for (size_t i = 0; i < used; ++i) {
+            summary.fixedDeposits += chunk.fdCounts[i];
+        }
+
+        for (size_t i = 0; i < used; ++i) {
+            if (!chunk.occupied[i]) {
+                continue;
+            }
+            Money balance = Money::fromPaise(chunk.balances[i]);
+            if (first || balance < summary.minBalance) {
+                summary.minBalance = balance;
+            }
+            if (first || balance > summary.maxBalance) {
+                summary.maxBalance = balance;
+            }
+            first = false;
+            ++summary.accounts;
+            size_t bucket = static_cast<size_t>(
+                std::upper_bound(bucketBounds.begin(), bucketBounds.end(), balance) - bucketBounds.begin());
+            ++summary.bucketCounts[bucket];
+        }
+    }
+    return summary;
+}
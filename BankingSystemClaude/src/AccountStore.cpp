@@ -0,0 +1,202 @@
+#include "AccountStore.h"
+#include <algorithm>
+#include <mutex>
+
+AccountStore::AccountStore(size_t stripeCount, int firstAccountNumber, AccountColumns* accountColumns)
+    : stripes(std::max<size_t>(stripeCount, 1)), base(std::max(firstAccountNumber, 0)), columns(accountColumns),
+      count(0) {
+    // Slot 0 of each stripe holds the stripe's first number at or above the base
+    size_t n = stripes.size();
+    for (size_t i = 0; i < n; ++i) {
+        size_t offset = (i + n - static_cast<unsigned int>(base) % n) % n;
+        stripes[i].first = static_cast<long long>(base) + static_cast<long long>(offset);
+    }
+}
+
+AccountStore::~AccountStore() {
+    clear();
+}
+
+AccountStore::Stripe& AccountStore::stripeFor(int accountNumber) {
+    return stripes[static_cast<unsigned int>(accountNumber) % stripes.size()];
+}
+
+const AccountStore::Stripe& AccountStore::stripeFor(int accountNumber) const {
+    return stripes[static_cast<unsigned int>(accountNumber) % stripes.size()];
+}
+
+long long AccountStore::slotOf(int accountNumber) const {
+    if (accountNumber < base) {
+        return -1;
+    }
+    return (static_cast<long long>(accountNumber) - base) / static_cast<long long>(stripes.size());
+}
+
+const std::shared_ptr<Account>* AccountStore::lookup(const Stripe& stripe, int accountNumber) const {
+    long long slot = slotOf(accountNumber);
+    if (slot >= 0 && static_cast<size_t>(slot) < stripe.dense.size()) {
+        return &stripe.dense[static_cast<size_t>(slot)];
+    }
+    auto it = stripe.sparse.find(accountNumber);
+    return it != stripe.sparse.end() ? &it->second : nullptr;
+}
+
+std::shared_ptr<Account>& AccountStore::slotFor(Stripe& stripe, int accountNumber) {
+    long long slot = slotOf(accountNumber);
+    if (slot >= 0 && static_cast<size_t>(slot) < stripe.dense.size() + MAX_DENSE_GAP) {
+        if (static_cast<size_t>(slot) >= stripe.dense.size()) {
+            growDense(stripe, static_cast<size_t>(slot) + 1);
+        }
+        return stripe.dense[static_cast<size_t>(slot)];
+    }
+    return stripe.sparse[accountNumber];
+}
+
+void AccountStore::growDense(Stripe& stripe, size_t slots) {
+    stripe.dense.resize(slots);
+    
+    // Sparse numbers are sorted, so the ones now covered form a prefix from the base
+    auto it = stripe.sparse.lower_bound(base);
+    while (it != stripe.sparse.end() && static_cast<size_t>(slotOf(it->first)) < slots) {
+        stripe.dense[static_cast<size_t>(slotOf(it->first))] = std::move(it->second);
+        it = stripe.sparse.erase(it);
+    }
+}
+
+std::shared_ptr<Account> AccountStore::find(int accountNumber) const {
+    const Stripe& stripe = stripeFor(accountNumber);
+    std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+    const std::shared_ptr<Account>* stored = lookup(stripe, accountNumber);
+    return stored ? *stored : nullptr;
+}
+
+bool AccountStore::contains(int accountNumber) const {
+    const Stripe& stripe = stripeFor(accountNumber);
+    std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+    const std::shared_ptr<Account>* stored = lookup(stripe, accountNumber);
+    return stored && *stored;
+}
+
+bool AccountStore::insert(int accountNumber, std::shared_ptr<Account>& account) {
+    Stripe& stripe = stripeFor(accountNumber);
+    std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+    std::shared_ptr<Account>& stored = slotFor(stripe, accountNumber);
+    if (stored) {
+        account = stored;
+        return false;
+    }
+    stored = account;
+    ++stripe.live;
+    ++count;
+    if (columns && stored) {
+        stored->attachColumns(columns);
+    }
+    return true;
+}
+
+void AccountStore::assign(int accountNumber, std::shared_ptr<Account> account) {
+    Stripe& stripe = stripeFor(accountNumber);
+    std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+    std::shared_ptr<Account>& stored = slotFor(stripe, accountNumber);
+    if (!stored) {
+        ++stripe.live;
+        ++count;
+    } else if (columns && stored != account) {
+        stored->detachColumns(columns);
+    }
+    stored = std::move(account);
+    if (columns && stored) {
+        stored->attachColumns(columns);
+    }
+}
+
+bool AccountStore::erase(int accountNumber) {
+    Stripe& stripe = stripeFor(accountNumber);
+    std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+    long long slot = slotOf(accountNumber);
+    if (slot >= 0 && static_cast<size_t>(slot) < stripe.dense.size()) {
+        std::shared_ptr<Account>& stored = stripe.dense[static_cast<size_t>(slot)];
+        if (!stored) {
+            return false;
+        }
+        if (columns) {
+            stored->detachColumns(columns);
+        }
+        stored.reset();  // Tombstone: the slot stays, so later numbers keep their positions
+    } else {
+        auto it = stripe.sparse.find(accountNumber);
+        if (it == stripe.sparse.end()) {
+            return false;
+        }
+        if (columns && it->second) {
+            it->second->detachColumns(columns);
+        }
+        stripe.sparse.erase(it);
+    }
+    --stripe.live;
+    --count;
+    return true;
+}
+
+size_t AccountStore::sparseSize() const {
+    size_t total = 0;
+    for (const auto& stripe : stripes) {
+        std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+        total += stripe.sparse.size();
+    }
+    return total;
+}
+
+void AccountStore::clear() {
+    for (auto& stripe : stripes) {
+        std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+        if (columns) {
+            for (const auto& account : stripe.dense) {
+                if (account) {
+                    account->detachColumns(columns);
+                }
+            }
+            for (const auto& pair : stripe.sparse) {
+                if (pair.second) {
+                    pair.second->detachColumns(columns);
+                }
+            }
+        }
+        count -= stripe.live;
+        stripe.live = 0;
+        stripe.dense.clear();
+        stripe.sparse.clear();
+    }
+}
+
+void AccountStore::forEach(const std::function<void(int, const std::shared_ptr<Account>&)>& visit) const {
+    long long step = static_cast<long long>(stripes.size());
+    for (const auto& stripe : stripes) {
+        std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+        long long accountNumber = stripe.first;
+        for (const auto& account : stripe.dense) {
+            if (account) {
+                visit(static_cast<int>(accountNumber), account);
+            }
+            accountNumber += step;
+        }
+        for (const auto& pair : stripe.sparse) {
+            visit(pair.first, pair.second);
+        }
+    }
+}
+
+std::vector<AccountStore::Entry> AccountStore::sorted(const std::function<bool(int)>& filter) const {
+    std::vector<Entry> result;
+    result.reserve(filter ? 0 : size());
+    forEach([&result, &filter](int accountNumber, const std::shared_ptr<Account>& account) {
+        if (!filter || filter(accountNumber)) {
+            result.emplace_back(accountNumber, account);
+        }
+    });
+    
+    // Stripes interleave account numbers; sorting the concatenation is cheap enough for saves
+    std::sort(result.begin(), result.end(),
+              [](const Entry& a, const Entry& b) { return a.first < b.first; });
+    return result;
+}
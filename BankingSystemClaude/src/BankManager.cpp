@@ -1,13 +1,34 @@
 #include "BankManager.h"
 #include "FileManager.h"
-#include <iostream>
+#include "BinaryIO.h"
+#include "ThreadPool.h"
+#include "TextScanner.h"
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 
 // Initialize static members
 std::unique_ptr<BankManager> BankManager::instance = nullptr;
 std::mutex BankManager::mutex_;
 
-BankManager::BankManager() : nextAccountNumber(1001) {}
+BankManager::BankManager()
+    : accounts(AccountStore::DEFAULT_STRIPES, FIRST_ACCOUNT_NUMBER, &columns), nextAccountNumber(FIRST_ACCOUNT_NUMBER),
+      checkpointLsn(0), checkpointInterval(1000), commitDelay(0),
+      commitBatch(Journal::DEFAULT_COMMIT_BATCH), loadThreads(0),
+      loadBufferSize(FileManager::DEFAULT_STREAM_BUFFER), loadMode(LoadMode::EAGER), shardCount(1),
+      shards(1), shardFormat(SnapshotFormat::TEXT), materializedFromSnapshot(0),
+      backgroundSnapshots(false), snapshotRunning(false), stopSnapshots(false), lastSnapshotOk(true),
+      snapshotsWritten(0), completedSnapshotLsn(0), handedOffVersion(0), snapshotNeedsReset(true),
+      discardedLsn(0) {}
+
+BankManager::~BankManager() {
+    stopSnapshotThread();
+    accounts.forEach([](int, const std::shared_ptr<Account>& account) {
+        account->setJournal(nullptr);
+        account->setTransactionLog(nullptr);
+        account->setMaturityScheduler(nullptr);
+    });
+}
 
 BankManager* BankManager::getInstance() {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -17,152 +38,1476 @@ BankManager* BankManager::getInstance() {
     return instance.get();
 }
 
-int BankManager::createAccount(const std::string& name, const std::string& password, double initialBalance) {
-    if (name.empty()) {
-        std::cout << "❌ Account holder name cannot be empty!" << std::endl;
+int BankManager::createAccount(const std::string& name, const std::string& password, Money initialBalance,
+                               BankResult* result) {
+    BankResult status = validateNewAccount(name, password, initialBalance);
+    if (result) {
+        *result = status;
+    }
+    if (status != BankResult::OK) {
         return -1;
     }
     
+    int accNum;
+    {
+        std::lock_guard<std::mutex> lock(creationMutex);
+        accNum = nextAccountNumber++;
+    }
+    auto account = std::make_shared<Account>(accNum, name, password, initialBalance);
+    
+    // Journal the creation before publishing, so it precedes any operation on the account;
+    // a snapshot cut sees the account either journaled and published or neither
+    std::shared_lock<std::shared_mutex> gate;
+    if (journal) {
+        gate = journal->admitOperation();
+        account->setJournal(journal.get());
+        journal->append(account->creationEntry());
+    }
+    if (transactionLog) {
+        account->setTransactionLog(transactionLog.get());
+        for (const auto& trans : account->getTransactionHistory()) {
+            transactionLog->append(accNum, trans);  // The initial deposit, made before the log was attached
+        }
+    }
+    account->setMaturityScheduler(&maturities);
+    accounts.assign(accNum, account);
+    
+    return accNum;
+}
+
+BankResult BankManager::validateNewAccount(const std::string& name, const std::string& password,
+                                           Money initialBalance) {
+    if (name.empty()) {
+        return BankResult::EMPTY_NAME;
+    }
     if (password.length() < 4) {
-        std::cout << "❌ Password must be at least 4 characters long!" << std::endl;
-        return -1;
+        return BankResult::SHORT_PASSWORD;
+    }
+    if (initialBalance.isNegative()) {
+        return BankResult::NEGATIVE_BALANCE;
+    }
+    return BankResult::OK;
+}
+
+std::shared_ptr<Account> BankManager::login(int accountNumber, const std::string& password, BankResult* result) {
+    auto account = findAccount(accountNumber);
+    BankResult status = BankResult::OK;
+    if (account == nullptr) {
+        status = BankResult::ACCOUNT_NOT_FOUND;
+    } else if (!account->verifyPassword(password)) {
+        status = BankResult::INVALID_PASSWORD;
+        account.reset();
     }
     
-    if (initialBalance < 0) {
-        std::cout << "❌ Initial balance cannot be negative!" << std::endl;
-        return -1;
+    if (result) {
+        *result = status;
+    }
+    return account;
+}
+
+std::shared_ptr<Account> BankManager::getAccount(int accountNumber) {
+    return findAccount(accountNumber);
+}
+
+TransferResult BankManager::transfer(int fromAccount, int toAccount, Money amount) {
+    if (fromAccount == toAccount) {
+        return TransferResult::SAME_ACCOUNT;
     }
     
-    try {
-        int accNum = nextAccountNumber++;
-        auto account = std::make_shared<Account>(accNum, name, password, initialBalance);
-        accounts[accNum] = account;
-        
-        std::cout << "\n✅ Account created successfully!" << std::endl;
-        std::cout << "Account Number: " << accNum << std::endl;
-        std::cout << "Account Holder: " << name << std::endl;
-        std::cout << "Initial Balance: ₹" << std::fixed << std::setprecision(2) 
-                  << initialBalance << std::endl;
-        std::cout << "\n⚠️  Please remember your account number and password!" << std::endl;
-        
-        return accNum;
-    } catch (const std::exception& e) {
-        std::cout << "❌ Error creating account: " << e.what() << std::endl;
-        return -1;
+    auto from = findAccount(fromAccount);
+    auto to = findAccount(toAccount);
+    if (from == nullptr || to == nullptr) {
+        return TransferResult::ACCOUNT_NOT_FOUND;
     }
+    
+    return Account::transfer(*from, *to, amount);
+}
+
+bool BankManager::accountExists(int accountNumber) const {
+    size_t position;
+    const LazySnapshot* snapshot = shards[shardOf(accountNumber)].snapshot.get();
+    return accounts.contains(accountNumber) ||
+           (snapshot && snapshot->find(accountNumber, position));
+}
+
+size_t BankManager::getAccountCount() const {
+    size_t indexed = 0;
+    for (const auto& shard : shards) {
+        indexed += shard.snapshot ? shard.snapshot->indexSize : 0;
+    }
+    return accounts.size() + indexed - materializedFromSnapshot;
+}
+
+Money BankManager::getTotalBalance() {
+    materializeAll();
+    return columns.totalBalance();
+}
+
+Money BankManager::getTotalFdPrincipal() {
+    materializeAll();
+    return columns.totalFdPrincipal();
+}
+
+BalanceSummary BankManager::getBalanceSummary(const std::vector<Money>& bucketBounds) {
+    materializeAll();
+    return columns.summarize(bucketBounds);
 }
 
-std::shared_ptr<Account> BankManager::login(int accountNumber, const std::string& password) {
-    auto it = accounts.find(accountNumber);
+MaturityProjection BankManager::projectMaturities(size_t months, std::chrono::system_clock::time_point from) {
+    materializeAll();
+    return columns.deposits().project(FixedDeposit::monthIndex(from), months, workerCount());
+}
+
+std::shared_ptr<Account> BankManager::findAccount(int accountNumber) {
+    auto found = accounts.find(accountNumber);
+    if (found != nullptr) {
+        return found;
+    }
     
-    if (it == accounts.end()) {
-        std::cout << "❌ Account not found!" << std::endl;
+    size_t position;
+    const LazySnapshot* snapshot = shards[shardOf(accountNumber)].snapshot.get();
+    if (!snapshot || !snapshot->find(accountNumber, position)) {
         return nullptr;
     }
     
-    if (!it->second->verifyPassword(password)) {
-        std::cout << "❌ Invalid password!" << std::endl;
+    // First access: deserialize from the mapped snapshot and cache
+    auto account = decodeRecord(snapshot->recordAt(position), snapshot->format, snapshot->amounts, snapshot->times);
+    if (account == nullptr) {
+        report("Error loading account " + std::to_string(accountNumber));
         return nullptr;
     }
+    if (journal) {
+        account->setJournal(journal.get());
+    }
+    account->setTransactionLog(transactionLog.get());
+    
+    // Another thread may have materialized the same record meanwhile; keep the first
+    if (accounts.insert(accountNumber, account)) {
+        ++materializedFromSnapshot;
+        account->setMaturityScheduler(&maturities);
+        return account;
+    }
+    return accounts.find(accountNumber);
+}
+
+namespace {
+// Binary snapshot header: 8-byte magic | u32 version | i32 nextAccount | u64 accountCount
+// | u64 checkpointLsn (version 2+)
+const char BINARY_MAGIC[8] = {'B', 'A', 'N', 'K', 'S', 'N', 'A', 'P'};
+
+// Version 4+ records store amounts as i64 paise, older ones as f64 rupees
+AmountFormat amountFormatOf(uint32_t version) {
+    return version >= 4 ? AmountFormat::PAISE : AmountFormat::RUPEES;
+}
+
+// Version 5+ records store transaction times as clock ticks, older ones as seconds
+TimestampFormat timestampFormatOf(uint32_t version) {
+    return version >= 5 ? TimestampFormat::TICKS : TimestampFormat::SECONDS;
+}
+
+// Version 3+ trailer after the account index: u64 indexOffset | 8-byte magic
+const char INDEX_MAGIC[8] = {'B', 'A', 'N', 'K', 'I', 'D', 'X', '\0'};
+const size_t INDEX_TRAILER_SIZE = 16;
+
+// Below this many records a worker pool costs more than it saves
+const size_t MIN_PARALLEL_RECORDS = 256;
+
+// Records handed to a worker per task; small enough to balance uneven records
+const size_t RECORDS_PER_TASK = 512;
+
+// First line of a sharded snapshot's manifest, followed by the shard count
+const char SHARD_MANIFEST_PREFIX[] = "SHARDS:";
+}
+
+BankManager::SnapshotIndexEntry BankManager::LazySnapshot::entryAt(size_t i) const {
+    static_assert(sizeof(SnapshotIndexEntry) == 16, "Index entries are stored as 16-byte records");
+    SnapshotIndexEntry entry;
+    std::memcpy(&entry, index + i * sizeof(SnapshotIndexEntry), sizeof(entry));
+    return entry;
+}
+
+std::string_view BankManager::LazySnapshot::recordAt(size_t i) const {
+    SnapshotIndexEntry entry = entryAt(i);
+    std::string_view data = file->view();
+    if (entry.offset > data.size() || entry.length > data.size() - entry.offset) {
+        return std::string_view();
+    }
+    return data.substr(entry.offset, entry.length);
+}
+
+bool BankManager::LazySnapshot::find(int accountNumber, size_t& position) const {
+    // Binary search directly over the (possibly mapped) index
+    size_t low = 0;
+    size_t high = indexSize;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int current = entryAt(mid).accountNumber;
+        if (current == accountNumber) {
+            position = mid;
+            return true;
+        }
+        if (current < accountNumber) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return false;
+}
+
+void BankManager::forEachAccount(size_t shard,
+    const std::function<void(int, const std::shared_ptr<Account>&, std::string_view)>& visit) const {
+    static const std::shared_ptr<Account> notMaterialized;
+    const LazySnapshot* snapshot = shards[shard].snapshot.get();
+    size_t indexed = snapshot ? snapshot->indexSize : 0;
+    size_t i = 0;
+    std::vector<AccountStore::Entry> materialized =
+        accounts.sorted([this, shard](int accNum) { return shardOf(accNum) == shard; });
+    auto it = materialized.begin();
     
-    std::cout << "\n✅ Login successful!" << std::endl;
-    std::cout << "Welcome, " << it->second->getAccountHolderName() << "!" << std::endl;
+    // Merge the materialized accounts with the snapshot index; both are sorted
+    while (true) {
+        if (it == materialized.end() && i == indexed) {
+            break;
+        }
+        
+        if (i < indexed) {
+            int accNum = snapshot->entryAt(i).accountNumber;
+            if (it == materialized.end() || accNum < it->first) {
+                visit(accNum, notMaterialized, snapshot->recordAt(i));
+                ++i;
+                continue;
+            }
+            if (accNum == it->first) {
+                ++i;  // The materialized copy supersedes the record
+            }
+        }
+        visit(it->first, it->second, std::string_view());
+        ++it;
+    }
+}
+
+std::shared_ptr<Account> BankManager::decodeRecord(std::string_view record, SnapshotFormat format,
+                                                  AmountFormat amounts, TimestampFormat times) {
+    if (format == SnapshotFormat::TEXT) {
+        std::shared_ptr<Account> account;
+        return Account::parse(record, account) == ParseError::NONE ? account : nullptr;
+    }
     
-    return it->second;
+    try {
+        BinaryReader in(record.data(), record.size());
+        return Account::deserializeBinary(in, amounts, times);
+    } catch (const std::exception&) {
+        return nullptr;
+    }
 }
 
-std::shared_ptr<Account> BankManager::getAccount(int accountNumber) {
-    auto it = accounts.find(accountNumber);
-    if (it != accounts.end()) {
-        return it->second;
+const std::string& BankManager::encodedRecord(size_t shard, const Account& account, SnapshotFormat format,
+                                              SaveStats& stats) {
+    CachedRecord& cached = shards[shard].records[account.getAccountNumber()];
+    if (!cached.data.empty() && cached.version == account.getVersion() && cached.format == format) {
+        ++stats.accountsReused;
+        return cached.data;
     }
-    return nullptr;
+    
+    cached.data.clear();
+    if (format == SnapshotFormat::TEXT) {
+        cached.data = account.serialize();
+    } else {
+        BinaryWriter out(cached.data);
+        account.serializeBinary(out);
+    }
+    cached.version = account.getVersion();
+    cached.format = format;
+    ++stats.accountsSerialized;
+    return cached.data;
 }
 
-bool BankManager::accountExists(int accountNumber) const {
-    return accounts.find(accountNumber) != accounts.end();
+std::string BankManager::encodeText(size_t shard, SaveStats& stats) {
+    const LazySnapshot* snapshot = shards[shard].snapshot.get();
+    std::stringstream body;
+    size_t count = 0;
+    
+    // Save the shard's accounts; untouched text records are copied through verbatim
+    forEachAccount(shard, [this, shard, snapshot, &body, &count, &stats](
+                              int, const std::shared_ptr<Account>& account, std::string_view record) {
+        if (account) {
+            body << "ACCOUNT_START\n" << encodedRecord(shard, *account, SnapshotFormat::TEXT, stats)
+                 << "ACCOUNT_END\n";
+            ++count;
+            return;
+        }
+        if (snapshot->format == SnapshotFormat::TEXT) {
+            body << "ACCOUNT_START\n" << record << "ACCOUNT_END\n";
+            ++stats.accountsReused;
+            ++count;
+            return;
+        }
+        if (auto decoded = decodeRecord(record, snapshot->format, snapshot->amounts, snapshot->times)) {
+            body << "ACCOUNT_START\n" << decoded->serialize() << "ACCOUNT_END\n";
+            ++stats.accountsSerialized;
+            ++count;
+        }
+    });
+    
+    std::stringstream ss;
+    ss << "NEXT_ACCOUNT:" << nextAccountNumber << "\n";
+    ss << "ACCOUNT_COUNT:" << count << "\n";
+    ss << "CHECKPOINT_LSN:" << checkpointLsn << "\n";
+    ss << "---ACCOUNTS---\n";
+    ss << body.rdbuf();
+    
+    return ss.str();
+}
+
+std::string BankManager::encodeBinary(size_t shard, SaveStats& stats) {
+    const LazySnapshot* snapshot = shards[shard].snapshot.get();
+    std::string data;
+    BinaryWriter out(data);
+    
+    out.writeBytes(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    out.writeU32(BINARY_SNAPSHOT_VERSION);
+    out.writeI32(nextAccountNumber);
+    size_t countOffset = out.position();
+    out.writeI64(0);
+    out.writeI64(static_cast<int64_t>(checkpointLsn));
+    
+    // Save the shard's accounts; untouched records of this version are copied through verbatim
+    std::vector<SnapshotIndexEntry> index;
+    forEachAccount(shard, [this, shard, snapshot, &out, &index, &stats](
+                              int accNum, const std::shared_ptr<Account>& account, std::string_view record) {
+        size_t offset = out.position();
+        if (account) {
+            const std::string& encoded = encodedRecord(shard, *account, SnapshotFormat::BINARY, stats);
+            out.writeBytes(encoded.data(), encoded.size());
+        } else if (snapshot->format == SnapshotFormat::BINARY && snapshot->amounts == AmountFormat::PAISE &&
+                   snapshot->times == TimestampFormat::TICKS) {
+            out.writeBytes(record.data(), record.size());
+            ++stats.accountsReused;
+        } else if (auto decoded = decodeRecord(record, snapshot->format, snapshot->amounts, snapshot->times)) {
+            decoded->serializeBinary(out);
+            ++stats.accountsSerialized;
+        } else {
+            return;
+        }
+        
+        SnapshotIndexEntry entry;
+        entry.accountNumber = accNum;
+        entry.length = static_cast<uint32_t>(out.position() - offset);
+        entry.offset = offset;
+        index.push_back(entry);
+    });
+    out.patchI64(countOffset, static_cast<int64_t>(index.size()));
+    
+    // Sorted account index followed by the trailer that locates it
+    size_t indexOffset = out.position();
+    for (const auto& entry : index) {
+        out.writeI32(entry.accountNumber);
+        out.writeU32(entry.length);
+        out.writeI64(static_cast<int64_t>(entry.offset));
+    }
+    out.writeI64(static_cast<int64_t>(indexOffset));
+    out.writeBytes(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    
+    return data;
 }
 
-bool BankManager::saveToFile(const std::string& filename) {
+bool BankManager::saveToFile(const std::string& filename, SnapshotFormat format) {
+    auto started = std::chrono::steady_clock::now();
+    lastSaveStats = SaveStats();
     FileManager fileManager;
     if (!fileManager.ensureDataDirectory()) {
-        std::cout << "❌ Error creating data directory!" << std::endl;
+        report("Error creating data directory");
         return false;
     }
     
-    std::stringstream ss;
+    // Whatever survives of a shard that failed to load must not replace its file
+    if (filename == shardSource) {
+        for (size_t i = 0; i < shards.size(); ++i) {
+            if (shards[i].damaged) {
+                report("Shard " + std::to_string(i) + " of " + filename +
+                       " was not loaded; refusing to overwrite it");
+                return false;
+            }
+        }
+    }
     
-    // Save next account number
-    ss << "NEXT_ACCOUNT:" << nextAccountNumber << "\n";
-    ss << "ACCOUNT_COUNT:" << accounts.size() << "\n";
-    ss << "---ACCOUNTS---\n";
+    if (shardCount != shards.size()) {
+        reshard(shardCount);
+    }
     
-    // Save all accounts
-    for (const auto& pair : accounts) {
-        ss << "ACCOUNT_START\n";
-        ss << pair.second->serialize();
-        ss << "ACCOUNT_END\n";
+    // Everything journaled so far is reflected in the shards written below, and nothing later:
+    // journaled operations wait until the shards are encoded
+    std::unique_lock<std::shared_mutex> cut;
+    if (journal) {
+        cut = journal->pauseOperations();
+        checkpointLsn = journal->getLastLsn();
     }
+    uint64_t version = Account::currentVersion();
     
-    if (fileManager.writeToFile(filename, ss.str())) {
-        std::cout << "✅ Data saved successfully!" << std::endl;
-        return true;
+    // Rewrite only shards holding accounts changed since their file was last read or written
+    std::vector<bool> changed(shards.size(), filename != shardSource || format != shardFormat);
+    accounts.forEach([this, &changed](int accNum, const std::shared_ptr<Account>& account) {
+        if (account->getVersion() > shards[shardOf(accNum)].savedVersion) {
+            changed[shardOf(accNum)] = true;
+        }
+    });
+    
+    std::vector<std::string> files(shards.size());
+    std::vector<size_t> dirty;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        files[i] = shards.size() == 1 ? filename : shardFileName(filename, i);
+        if (changed[i] || !fileManager.fileExists(files[i])) {
+            dirty.push_back(i);
+        }
+    }
+    
+    // Shards are independent files, so they are encoded and written concurrently. Only the
+    // encoding needs the cut; operations resume before any file is written.
+    std::vector<std::string> encoded(dirty.size());
+    std::vector<char> written(dirty.size(), 0);
+    std::vector<SaveStats> shardStats(dirty.size());
+    auto encodeShard = [this, format, &dirty, &encoded, &shardStats](size_t i) {
+        encoded[i] = (format == SnapshotFormat::BINARY) ? encodeBinary(dirty[i], shardStats[i])
+                                                        : encodeText(dirty[i], shardStats[i]);
+        shardStats[i].bytesWritten = encoded[i].size();
+    };
+    auto writeShard = [&files, &dirty, &encoded, &written](size_t i) {
+        FileManager writer;
+        written[i] = writer.writeToFile(files[dirty[i]], encoded[i]);
+        std::string().swap(encoded[i]);
+    };
+    size_t threads = std::min(workerCount(), dirty.size());
+    std::unique_ptr<ThreadPool> pool(threads > 1 ? new ThreadPool(threads) : nullptr);
+    auto forEachDirty = [&pool, &dirty](const std::function<void(size_t)>& task) {
+        if (!pool) {
+            for (size_t i = 0; i < dirty.size(); ++i) {
+                task(i);
+            }
+            return;
+        }
+        std::vector<std::future<void>> pending;
+        for (size_t i = 0; i < dirty.size(); ++i) {
+            pending.push_back(pool->submit([&task, i]() { task(i); }));
+        }
+        for (auto& result : pending) {
+            result.get();
+        }
+    };
+    forEachDirty(encodeShard);
+    if (cut.owns_lock()) {
+        cut.unlock();
+    }
+    forEachDirty(writeShard);
+    
+    bool ok = true;
+    for (size_t i = 0; i < dirty.size(); ++i) {
+        ShardState& shard = shards[dirty[i]];
+        lastSaveStats.accountsSerialized += shardStats[i].accountsSerialized;
+        lastSaveStats.accountsReused += shardStats[i].accountsReused;
+        if (!written[i]) {
+            report("Error saving " + files[dirty[i]]);
+            ok = false;
+            continue;
+        }
+        ++lastSaveStats.shardsWritten;
+        lastSaveStats.bytesWritten += shardStats[i].bytesWritten;
+        shard.checkpointLsn = checkpointLsn;
+        shard.savedVersion = version;
+        
+        // The old mapping no longer matches the file; every account is now in it
+        if (shard.snapshot && shard.snapshot->filename == files[dirty[i]]) {
+            int next;
+            uint64_t lsn;
+            shard.snapshot = mapSnapshot(files[dirty[i]], next, lsn);
+            if (!shard.snapshot) {
+                report("Error re-indexing " + files[dirty[i]]);
+                ok = false;
+            }
+        }
+    }
+    countMaterialized();
+    
+    // The manifest is written last; each shard file carries its own checkpoint LSN
+    if (ok && shards.size() > 1) {
+        std::stringstream manifest;
+        manifest << SHARD_MANIFEST_PREFIX << shards.size() << "\n";
+        manifest << "NEXT_ACCOUNT:" << nextAccountNumber << "\n";
+        ok = fileManager.writeToFile(filename, manifest.str());
+        lastSaveStats.bytesWritten += manifest.str().size();
+    }
+    lastSaveStats.shards = shards.size();
+    lastSaveStats.milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    
+    if (!ok) {
+        report("Error saving data");
+        shardSource.clear();  // Rewrite everything next time
+        return false;
+    }
+    
+    shardSource = filename;
+    shardFormat = format;
+    return true;
+}
+
+std::string BankManager::shardFileName(const std::string& filename, size_t shard) {
+    return filename + ".shard" + std::to_string(shard);
+}
+
+void BankManager::reshard(size_t count) {
+    // Records stay in the old layout's files, so bring every account into the map first
+    materializeAll();
+    
+    shards.clear();
+    shards.resize(count);
+    materializedFromSnapshot = 0;
+    shardSource.clear();
+}
+
+void BankManager::materializeAll() {
+    if (getAccountCount() == accounts.size()) {
+        return;
+    }
+    for (size_t s = 0; s < shards.size(); ++s) {
+        const LazySnapshot* snapshot = shards[s].snapshot.get();
+        for (size_t i = 0; snapshot && i < snapshot->indexSize; ++i) {
+            findAccount(snapshot->entryAt(i).accountNumber);
+        }
+    }
+}
+
+void BankManager::countMaterialized() {
+    materializedFromSnapshot = 0;
+    size_t position;
+    accounts.forEach([this, &position](int accNum, const std::shared_ptr<Account>&) {
+        const LazySnapshot* snapshot = shards[shardOf(accNum)].snapshot.get();
+        if (snapshot && snapshot->find(accNum, position)) {
+            ++materializedFromSnapshot;
+        }
+    });
+}
+
+size_t BankManager::workerCount() const {
+    return loadThreads == 0 ? ThreadPool::defaultThreadCount() : loadThreads;
+}
+
+BankManager::SnapshotFormat BankManager::detectFormat(std::string_view data) {
+    if (data.substr(0, sizeof(BINARY_MAGIC)) == std::string_view(BINARY_MAGIC, sizeof(BINARY_MAGIC))) {
+        return SnapshotFormat::BINARY;
+    }
+    return SnapshotFormat::TEXT;
+}
+
+std::vector<BankManager::DecodedAccount> BankManager::decodeAccounts(size_t count,
+    const std::function<std::shared_ptr<Account>(size_t)>& decodeOne) const {
+    std::vector<DecodedAccount> results(count);
+    
+    auto decodeRange = [&results, &decodeOne](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            try {
+                results[i].account = decodeOne(i);
+            } catch (const std::exception& e) {
+                results[i].error = e.what();
+            }
+        }
+    };
+    
+    size_t threads = workerCount();
+    if (threads <= 1 || count < MIN_PARALLEL_RECORDS) {
+        decodeRange(0, count);
+        return results;
+    }
+    
+    ThreadPool pool(std::min(threads, (count + RECORDS_PER_TASK - 1) / RECORDS_PER_TASK));
+    std::vector<std::future<void>> pending;
+    for (size_t begin = 0; begin < count; begin += RECORDS_PER_TASK) {
+        size_t end = std::min(count, begin + RECORDS_PER_TASK);
+        pending.push_back(pool.submit([&decodeRange, begin, end]() { decodeRange(begin, end); }));
+    }
+    for (auto& task : pending) {
+        task.get();
+    }
+    
+    return results;
+}
+
+BatchReport BankManager::applyBatch(const std::vector<BatchOperation>& operations) {
+    auto start = std::chrono::steady_clock::now();
+    BatchReport report;
+    report.results.assign(operations.size(), BatchResult::OK);
+    
+    // Group positions by account, keeping each account's operations in input order
+    std::unordered_map<int, size_t> groupOf;
+    std::vector<std::pair<int, std::vector<size_t>>> groups;
+    for (size_t i = 0; i < operations.size(); ++i) {
+        auto inserted = groupOf.emplace(operations[i].accountNumber, groups.size());
+        if (inserted.second) {
+            groups.emplace_back(operations[i].accountNumber, std::vector<size_t>());
+        }
+        groups[inserted.first->second].second.push_back(i);
+    }
+    report.accounts = groups.size();
+    
+    // Groups touch disjoint accounts and disjoint result slots, so they can run in parallel
+    std::atomic<size_t> applied(0);
+    auto applyGroups = [this, &operations, &groups, &report, &applied](size_t begin, size_t end) {
+        size_t count = 0;
+        for (size_t g = begin; g < end; ++g) {
+            auto account = findAccount(groups[g].first);
+            if (account == nullptr) {
+                for (size_t index : groups[g].second) {
+                    report.results[index] = BatchResult::ACCOUNT_NOT_FOUND;
+                }
+                continue;
+            }
+            count += account->applyBatch(operations, groups[g].second, report.results);
+        }
+        applied += count;
+    };
+    
+    size_t threads = workerCount();
+    if (threads <= 1 || operations.size() < MIN_PARALLEL_RECORDS) {
+        report.threads = 1;
+        applyGroups(0, groups.size());
+    } else {
+        // Each task takes a run of whole groups holding about RECORDS_PER_TASK operations
+        std::vector<std::pair<size_t, size_t>> runs;
+        size_t begin = 0;
+        size_t pendingOps = 0;
+        for (size_t g = 0; g < groups.size(); ++g) {
+            pendingOps += groups[g].second.size();
+            if (pendingOps >= RECORDS_PER_TASK || g + 1 == groups.size()) {
+                runs.emplace_back(begin, g + 1);
+                begin = g + 1;
+                pendingOps = 0;
+            }
+        }
+        
+        report.threads = std::min(threads, runs.size());
+        ThreadPool pool(report.threads);
+        std::vector<std::future<void>> pending;
+        for (const auto& run : runs) {
+            pending.push_back(pool.submit([&applyGroups, run]() { applyGroups(run.first, run.second); }));
+        }
+        for (auto& task : pending) {
+            task.get();
+        }
+    }
+    
+    report.applied = applied.load();
+    report.rejected = operations.size() - report.applied;
+    report.applyMilliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+BatchReport BankManager::applyBatch(std::istream& csv) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<BatchOperation> operations;
+    std::vector<size_t> malformed;
+    std::string line;
+    bool firstLine = true;
+    
+    while (std::getline(csv, line)) {
+        std::string_view view(line);
+        if (!view.empty() && view.back() == '\r') {
+            view.remove_suffix(1);
+        }
+        if (view.empty()) {
+            continue;
+        }
+        if (firstLine && view.substr(0, 5) == "type,") {
+            firstLine = false;
+            continue;
+        }
+        firstLine = false;
+        
+        BatchOperation op;
+        if (!parseBatchLine(view, op)) {
+            // Kept in place so results line up with the input; a zero amount is never applied
+            malformed.push_back(operations.size());
+            op = BatchOperation();
+        }
+        operations.push_back(op);
+    }
+    double parseMilliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    
+    BatchReport report = applyBatch(operations);
+    for (size_t index : malformed) {
+        report.results[index] = BatchResult::PARSE_ERROR;
+    }
+    report.parseMilliseconds = parseMilliseconds;
+    return report;
+}
+
+bool BankManager::parseBatchLine(std::string_view line, BatchOperation& op) {
+    TextScanner fields(line);
+    std::string_view type = fields.next(',');
+    std::string_view account = fields.next(',');
+    if (fields.atEnd()) {
+        return false;
+    }
+    std::string_view amount = fields.next(',');
+    
+    if (type == "DEPOSIT" || type == "D") {
+        op.type = BatchOperation::Type::DEPOSIT;
+    } else if (type == "WITHDRAWAL" || type == "W") {
+        op.type = BatchOperation::Type::WITHDRAWAL;
     } else {
-        std::cout << "❌ Error saving data!" << std::endl;
         return false;
     }
+    
+    return fields.atEnd() && TextScanner::parseNumber(account, op.accountNumber) &&
+           Money::parse(amount, op.amount);
 }
 
-bool BankManager::loadFromFile(const std::string& filename) {
+bool BankManager::decodeText(FileManager::BlockReader& reader) {
+    std::string_view line;
+    
+    // Parse header lines up to the separator
+    while (reader.nextLine(line) && line != "---ACCOUNTS---") {
+        if (!TextScanner::parsePrefixed(line, "NEXT_ACCOUNT:", nextAccountNumber)) {
+            TextScanner::parsePrefixed(line, "CHECKPOINT_LSN:", checkpointLsn);
+        }
+    }
+    
+    // Each batch is every complete block in the reader's buffer; the views point
+    // into that buffer, so a batch is fully merged before the next one is read
+    std::vector<std::string_view> blocks;
+    while (reader.nextBlocks("ACCOUNT_START", "ACCOUNT_END", blocks) > 0) {
+        std::vector<DecodedAccount> decoded = decodeAccounts(blocks.size(), [&blocks](size_t i) {
+            std::shared_ptr<Account> account;
+            ParseError error = Account::parse(blocks[i], account);
+            if (error != ParseError::NONE) {
+                throw std::runtime_error(std::string("Invalid account data: ") + parseErrorMessage(error));
+            }
+            return account;
+        });
+        
+        for (auto& result : decoded) {
+            if (!result.error.empty()) {
+                report("Error loading account: " + result.error);
+                continue;
+            }
+            int accNum = result.account->getAccountNumber();
+            accounts.assign(accNum, std::move(result.account));
+        }
+    }
+    
+    return true;
+}
+
+bool BankManager::decodeBinary(FileManager::BlockReader& reader) {
+    try {
+        std::string_view header;
+        if (!reader.read(sizeof(BINARY_MAGIC) + 4 + 4 + 8, header)) {
+            throw std::runtime_error("Truncated header");
+        }
+        BinaryReader in(header.data(), header.size());
+        in.skip(sizeof(BINARY_MAGIC));
+        
+        uint32_t version = in.readU32();
+        if (version < 1 || version > BINARY_SNAPSHOT_VERSION) {
+            report("Unsupported snapshot version: " + std::to_string(version));
+            return false;
+        }
+        
+        nextAccountNumber = in.readI32();
+        uint64_t count = static_cast<uint64_t>(in.readI64());
+        AmountFormat amounts = amountFormatOf(version);
+        TimestampFormat times = timestampFormatOf(version);
+        if (version >= 2) {
+            std::string_view lsn;
+            if (!reader.read(8, lsn)) {
+                throw std::runtime_error("Truncated header");
+            }
+            BinaryReader lsnReader(lsn.data(), lsn.size());
+            checkpointLsn = static_cast<uint64_t>(lsnReader.readI64());
+        }
+        
+        // Records are length-prefixed, so each buffer's worth is framed without decoding
+        std::vector<std::string_view> records;
+        uint64_t loaded = 0;
+        while (loaded < count && reader.nextRecords(static_cast<size_t>(count - loaded), records) > 0) {
+            std::vector<DecodedAccount> decoded = decodeAccounts(records.size(), [&records, amounts, times](size_t i) {
+                BinaryReader record(records[i].data(), records[i].size());
+                return Account::deserializeBinary(record, amounts, times);
+            });
+            
+            for (auto& result : decoded) {
+                if (!result.error.empty()) {
+                    throw std::runtime_error(result.error);
+                }
+                int accNum = result.account->getAccountNumber();
+                accounts.assign(accNum, std::move(result.account));
+            }
+            loaded += records.size();
+        }
+        
+        if (loaded < count) {
+            throw std::runtime_error("Unexpected end of binary data");
+        }
+    } catch (const std::exception& e) {
+        // Records are length-prefixed, so a damaged record cannot be skipped safely
+        report(std::string("Corrupt binary snapshot: ") + e.what());
+        return false;
+    }
+    
+    return true;
+}
+
+std::unique_ptr<BankManager::LazySnapshot> BankManager::mapSnapshot(const std::string& filename, int& next,
+                                                                    uint64_t& lsn) {
+    FileManager fileManager;
+    std::unique_ptr<LazySnapshot> snapshot(new LazySnapshot());
+    snapshot->file = fileManager.mapFile(filename);
+    if (!snapshot->file->isOpen()) {
+        return nullptr;
+    }
+    
+    std::string_view data = snapshot->file->view();
+    snapshot->filename = filename;
+    snapshot->format = detectFormat(data);
+    snapshot->amounts = AmountFormat::PAISE;
+    snapshot->times = TimestampFormat::TICKS;
+    snapshot->index = nullptr;
+    snapshot->indexSize = 0;
+    
+    if (snapshot->format == SnapshotFormat::BINARY) {
+        try {
+            BinaryReader in(data.data(), data.size());
+            in.skip(sizeof(BINARY_MAGIC));
+            uint32_t version = in.readU32();
+            if (version < 1 || version > BINARY_SNAPSHOT_VERSION) {
+                report("Unsupported snapshot version: " + std::to_string(version));
+                return nullptr;
+            }
+            next = in.readI32();
+            uint64_t count = static_cast<uint64_t>(in.readI64());
+            snapshot->amounts = amountFormatOf(version);
+            snapshot->times = timestampFormatOf(version);
+            if (version >= 2) {
+                lsn = static_cast<uint64_t>(in.readI64());
+            }
+            
+            if (version >= 3) {
+                // Use the stored index in place: nothing is read until it is searched
+                if (data.size() < INDEX_TRAILER_SIZE) {
+                    throw std::runtime_error("Missing index trailer");
+                }
+                BinaryReader trailer(data.data() + data.size() - INDEX_TRAILER_SIZE, INDEX_TRAILER_SIZE);
+                uint64_t indexOffset = static_cast<uint64_t>(trailer.readI64());
+                if (std::string_view(trailer.data(), sizeof(INDEX_MAGIC)) !=
+                        std::string_view(INDEX_MAGIC, sizeof(INDEX_MAGIC)) ||
+                    indexOffset + count * sizeof(SnapshotIndexEntry) != data.size() - INDEX_TRAILER_SIZE) {
+                    throw std::runtime_error("Invalid account index");
+                }
+                snapshot->index = data.data() + indexOffset;
+                snapshot->indexSize = static_cast<size_t>(count);
+            } else {
+                // Older versions have no index: frame the records to build one
+                for (uint64_t i = 0; i < count; ++i) {
+                    size_t offset = data.size() - in.remaining();
+                    uint32_t length = in.readU32();
+                    in.require(length);
+                    BinaryReader record(in.data(), length);
+                    SnapshotIndexEntry entry;
+                    entry.accountNumber = record.readI32();
+                    entry.length = length + 4;
+                    entry.offset = offset;
+                    snapshot->ownedIndex.push_back(entry);
+                    in.skip(length);
+                }
+            }
+        } catch (const std::exception& e) {
+            report(std::string("Corrupt binary snapshot: ") + e.what());
+            return nullptr;
+        }
+    } else {
+        TextScanner lines(data);
+        while (!lines.atEnd()) {
+            std::string_view line = lines.nextLine();
+            if (line == "---ACCOUNTS---") {
+                break;
+            }
+            if (!TextScanner::parsePrefixed(line, "NEXT_ACCOUNT:", next)) {
+                TextScanner::parsePrefixed(line, "CHECKPOINT_LSN:", lsn);
+            }
+        }
+        
+        // Index each block by the account number at the start of its body
+        while (!lines.atEnd()) {
+            if (lines.nextLine() != "ACCOUNT_START") {
+                continue;
+            }
+            const char* body = lines.remaining().data();
+            const char* bodyEnd = data.data() + data.size();
+            while (!lines.atEnd()) {
+                std::string_view line = lines.nextLine();
+                if (line == "ACCOUNT_END") {
+                    bodyEnd = line.data();
+                    break;
+                }
+            }
+            
+            TextScanner fields(std::string_view(body, static_cast<size_t>(bodyEnd - body)));
+            SnapshotIndexEntry entry;
+            if (!TextScanner::parseNumber(fields.nextField(), entry.accountNumber)) {
+                report(std::string("Error loading account: ") + parseErrorMessage(ParseError::INVALID_NUMBER));
+                continue;
+            }
+            entry.length = static_cast<uint32_t>(bodyEnd - body);
+            entry.offset = static_cast<uint64_t>(body - data.data());
+            snapshot->ownedIndex.push_back(entry);
+        }
+    }
+    
+    if (snapshot->index == nullptr) {
+        // Keep the last record for duplicate account numbers, as the eager loader does
+        auto byAccount = [](const SnapshotIndexEntry& a, const SnapshotIndexEntry& b) {
+            return a.accountNumber < b.accountNumber;
+        };
+        std::vector<SnapshotIndexEntry>& index = snapshot->ownedIndex;
+        std::stable_sort(index.begin(), index.end(), byAccount);
+        auto last = index.begin();
+        for (auto it = index.begin(); it != index.end(); ++it) {
+            if (last != index.begin() && (last - 1)->accountNumber == it->accountNumber) {
+                *(last - 1) = *it;
+            } else {
+                *last++ = *it;
+            }
+        }
+        index.erase(last, index.end());
+        snapshot->index = reinterpret_cast<const char*>(index.data());
+        snapshot->indexSize = index.size();
+    }
+    
+    return snapshot;
+}
+
+bool BankManager::loadSnapshot(const std::string& filename) {
     FileManager fileManager;
     
-    if (!fileManager.fileExists(filename)) {
-        std::cout << "ℹ️  No existing data file found. Starting fresh." << std::endl;
+    if (loadMode == LoadMode::LAZY) {
+        shards[0].snapshot = mapSnapshot(filename, nextAccountNumber, checkpointLsn);
+        if (!shards[0].snapshot) {
+            return false;
+        }
+        shardFormat = shards[0].snapshot->format;
         return true;
     }
     
-    std::string data = fileManager.readFromFile(filename);
-    if (data.empty()) {
-        std::cout << "❌ Error reading data file!" << std::endl;
+    // Stream the file so peak memory does not grow with the file size
+    auto reader = fileManager.openBlockReader(filename, loadBufferSize);
+    std::string_view magic;
+    if (!reader->isOpen() || !reader->peek(1, magic)) {
         return false;
     }
     
-    std::stringstream ss(data);
-    std::string line;
+    reader->peek(sizeof(BINARY_MAGIC), magic);
+    shardFormat = detectFormat(magic);
+    return (shardFormat == SnapshotFormat::BINARY) ? decodeBinary(*reader) : decodeText(*reader);
+}
+
+bool BankManager::readShardManifest(const std::string& filename, size_t& count, int& next) {
+    FileManager fileManager;
+    auto reader = fileManager.openBlockReader(filename, 256);
+    std::string_view line;
+    if (!reader->isOpen() || !reader->nextLine(line) ||
+        !TextScanner::parsePrefixed(line, SHARD_MANIFEST_PREFIX, count) || count == 0) {
+        return false;
+    }
+    
+    while (reader->nextLine(line)) {
+        TextScanner::parsePrefixed(line, "NEXT_ACCOUNT:", next);
+    }
+    return true;
+}
+
+bool BankManager::loadShards(const std::vector<std::string>& files) {
+    // Each shard is read by a private instance so the files load independently
+    std::vector<std::unique_ptr<BankManager>> parts(files.size());
+    std::vector<char> loaded(files.size(), 0);
+    auto loadPart = [this, &files, &parts, &loaded](size_t i) {
+        parts[i].reset(new BankManager());
+        parts[i]->loadMode = loadMode;
+        parts[i]->loadBufferSize = loadBufferSize;
+        parts[i]->loadThreads = files.size() > 1 ? 1 : loadThreads;  // Parallel across shards instead
+        loaded[i] = parts[i]->loadSnapshot(files[i]);
+    };
+    
+    size_t threads = std::min(workerCount(), files.size());
+    if (threads <= 1) {
+        for (size_t i = 0; i < files.size(); ++i) {
+            loadPart(i);
+        }
+    } else {
+        ThreadPool pool(threads);
+        std::vector<std::future<void>> pending;
+        for (size_t i = 0; i < files.size(); ++i) {
+            pending.push_back(pool.submit([&loadPart, i]() { loadPart(i); }));
+        }
+        for (auto& task : pending) {
+            task.get();
+        }
+    }
+    
+    shards.clear();
+    shards.resize(files.size());
+    uint64_t version = Account::currentVersion();
+    bool ok = true;
+    for (size_t i = 0; i < files.size(); ++i) {
+        BankManager& part = *parts[i];
+        for (auto& message : part.takeDiagnostics()) {
+            report(std::move(message));
+        }
+        if (!loaded[i]) {
+            report("Error reading " + files[i]);
+            shards[i].damaged = true;
+            ok = false;
+            continue;
+        }
+        
+        part.accounts.forEach([this](int accNum, const std::shared_ptr<Account>& account) {
+            accounts.assign(accNum, account);
+        });
+        part.accounts.clear();
+        shards[i].snapshot = std::move(part.shards[0].snapshot);
+        shards[i].checkpointLsn = part.checkpointLsn;
+        shards[i].savedVersion = version;
+        shardFormat = part.shardFormat;
+        nextAccountNumber = std::max(nextAccountNumber, part.nextAccountNumber);
+        checkpointLsn = std::max(checkpointLsn, part.checkpointLsn);
+    }
+    countMaterialized();
     
-    // Parse next account number
-    std::getline(ss, line);
-    if (line.find("NEXT_ACCOUNT:") == 0) {
-        nextAccountNumber = std::stoi(line.substr(13));
+    return ok;
+}
+
+bool BankManager::loadFromFile(const std::string& filename) {
+    FileManager fileManager;
+    bool ok = true;
+    
+    // The snapshot thread may be writing the files about to be read
+    if (snapshotThread.joinable()) {
+        waitForSnapshots();
     }
+    snapshotNeedsReset = true;
     
-    // Skip account count line
-    std::getline(ss, line);
+    lastLoadStats = LoadStats();
+    if (fileManager.fileExists(filename)) {
+        lastLoadStats.fileFound = true;
+        size_t count = 1;
+        int next = nextAccountNumber;
+        std::vector<std::string> files;
+        if (readShardManifest(filename, count, next)) {
+            for (size_t i = 0; i < count; ++i) {
+                files.push_back(shardFileName(filename, i));
+            }
+        } else {
+            files.push_back(filename);
+        }
+        
+        // A damaged shard is reported, but the others are still loaded and usable
+        ok = loadShards(files);
+        shardSource = filename;
+        if (!ok && files.size() == 1) {
+            report("Error reading data file");
+            return false;
+        }
+        nextAccountNumber = std::max(nextAccountNumber, next);
+        lastLoadStats.indexed = loadMode == LoadMode::LAZY;
+        lastLoadStats.files = files.size();
+        lastLoadStats.accounts = getAccountCount();
+    }
+    
+    if (journal) {
+        lastLoadStats.replayed = replayJournal();
+    }
+    if (transactionLog) {
+        accounts.forEach([this](int, const std::shared_ptr<Account>& account) {
+            account->setTransactionLog(transactionLog.get());
+        });
+    }
+    accounts.forEach([this](int, const std::shared_ptr<Account>& account) {
+        account->setMaturityScheduler(&maturities);
+    });
     
-    // Skip separator
-    std::getline(ss, line);
+    return ok;
+}
+
+size_t BankManager::replayJournal() {
+    size_t replayed = 0;
+    auto replayOn = [this](int accNum, const JournalEntry& entry) {
+        auto account = findAccount(accNum);
+        if (account == nullptr) {
+            report("Journal entry " + std::to_string(entry.lsn) + " refers to unknown account " +
+                   std::to_string(accNum));
+            return false;
+        }
+        account->replay(entry);
+        return true;
+    };
     
-    // Parse accounts
-    while (std::getline(ss, line)) {
-        if (line == "ACCOUNT_START") {
-            std::stringstream accountData;
-            while (std::getline(ss, line) && line != "ACCOUNT_END") {
-                accountData << line << "\n";
+    for (const auto& entry : journal->readEntries()) {
+        if (entry.operation == JournalEntry::Operation::TRANSFER) {
+            // The two sides may live in shards checkpointed at different LSNs
+            bool applied = false;
+            for (int accNum : {entry.accountNumber, entry.counterparty}) {
+                if (entry.lsn > shards[shardOf(accNum)].checkpointLsn) {
+                    applied = replayOn(accNum, entry) || applied;
+                }
             }
-            
-            try {
-                auto account = Account::deserialize(accountData.str());
-                accounts[account->getAccountNumber()] = account;
-            } catch (const std::exception& e) {
-                std::cout << "⚠️  Error loading account: " << e.what() << std::endl;
+            replayed += applied ? 1 : 0;
+            continue;
+        }
+        
+        const ShardState& shard = shards[shardOf(entry.accountNumber)];
+        if (entry.lsn <= shard.checkpointLsn) {
+            continue;  // Already folded into the account's shard file
+        }
+        
+        if (entry.operation == JournalEntry::Operation::CREATE_ACCOUNT) {
+            size_t position;
+            if (!accounts.contains(entry.accountNumber) && shard.snapshot &&
+                shard.snapshot->find(entry.accountNumber, position)) {
+                ++materializedFromSnapshot;  // Shadows a record that was never materialized
+            }
+            accounts.assign(entry.accountNumber, Account::restore(entry));
+            if (entry.accountNumber >= nextAccountNumber) {
+                nextAccountNumber = entry.accountNumber + 1;
             }
+        } else if (!replayOn(entry.accountNumber, entry)) {
+            continue;
         }
+        ++replayed;
     }
     
-    std::cout << "✅ Loaded " << accounts.size() << " account(s) from file." << std::endl;
+    // New entries must sort after everything the snapshot already covers
+    journal->advanceLsn(checkpointLsn + 1);
+    accounts.forEach([this](int, const std::shared_ptr<Account>& account) {
+        account->setJournal(journal.get());
+    });
+    
+    return replayed;
+}
+
+size_t BankManager::creditMaturedDeposits(std::chrono::system_clock::time_point now) {
+    size_t credited = 0;
+    for (int accNum : maturities.takeDue(now)) {
+        auto account = accounts.find(accNum);
+        if (account == nullptr) {
+            continue;
+        }
+        credited += account->creditMaturedDeposits(now);
+        
+        // Re-queue the account for the FDs it still holds, so none is lost with the entries just taken
+        std::chrono::system_clock::time_point next;
+        if (account->nextMaturity(next)) {
+            maturities.schedule(accNum, next);
+        }
+    }
+    return credited;
+}
+
+bool BankManager::enableJournal(const std::string& filename) {
+    journal.reset(new Journal(filename));
+    if (!journal->open()) {
+        report("Error opening journal " + journal->getFilePath());
+        journal.reset();
+        return false;
+    }
+    
+    journal->advanceLsn(checkpointLsn + 1);
+    journal->setMaxCommitDelay(commitDelay);
+    journal->setMaxCommitBatch(commitBatch);
+    accounts.forEach([this](int, const std::shared_ptr<Account>& account) {
+        account->setJournal(journal.get());
+    });
+    return true;
+}
+
+bool BankManager::enableTransactionLog(const std::string& name, size_t segmentBytes) {
+    std::unique_ptr<TransactionLog> log(new TransactionLog(name, "data", segmentBytes));
+    if (!log->open()) {
+        report("Error opening transaction log " + log->getSegmentPath(1));
+        return false;
+    }
+    
+    transactionLog = std::move(log);
+    accounts.forEach([this](int, const std::shared_ptr<Account>& account) {
+        account->setTransactionLog(transactionLog.get());
+    });
+    return true;
+}
+
+void BankManager::setCommitDelay(std::chrono::microseconds delay) {
+    commitDelay = delay;
+    if (journal) {
+        journal->setMaxCommitDelay(delay);
+    }
+}
+
+void BankManager::setCommitBatch(size_t callers) {
+    commitBatch = callers;
+    if (journal) {
+        journal->setMaxCommitBatch(callers);
+    }
+}
+
+bool BankManager::checkpoint(const std::string& filename, SnapshotFormat format) {
+    if (backgroundSnapshots) {
+        requestSnapshot(filename, format);
+        return waitForSnapshots();
+    }
+    
+    if (!saveToFile(filename, format)) {
+        return false;
+    }
+    
+    // Operations journaled after the snapshot's cut stay in the journal.
+    // A crash before the discard is harmless: replay skips entries <= checkpointLsn
+    if (journal && !journal->discardThrough(checkpointLsn)) {
+        report("Error compacting journal");
+        return false;
+    }
+    return true;
+}
+
+bool BankManager::checkpointIfDue(const std::string& filename, SnapshotFormat format) {
+    collectSnapshots();
+    if (!journal || journal->getPendingEntries() < checkpointInterval) {
+        return false;
+    }
+    if (!backgroundSnapshots) {
+        return checkpoint(filename, format);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        if (pendingSnapshot || snapshotRunning) {
+            return false;  // The journal shrinks once the running snapshot is collected
+        }
+    }
+    requestSnapshot(filename, format);
     return true;
 }
 
+void BankManager::requestSnapshot(const std::string& filename, SnapshotFormat format) {
+    collectSnapshots();
+    
+    std::unique_ptr<SnapshotRequest> request(new SnapshotRequest());
+    request->filename = filename;
+    request->format = format;
+    request->shardCount = shardCount;
+    request->nextAccountNumber = nextAccountNumber;
+    // The LSN and the copies below form one cut: journaled operations wait until the copy is done
+    std::unique_lock<std::shared_mutex> cut;
+    if (journal) {
+        cut = journal->pauseOperations();
+    }
+    request->checkpointLsn = journal ? journal->getLastLsn() : checkpointLsn;
+    request->reset = snapshotNeedsReset;
+    if (request->reset) {
+        for (const auto& shard : shards) {
+            ShardState state;
+            state.snapshot = shard.snapshot;
+            state.checkpointLsn = shard.checkpointLsn;
+            state.savedVersion = shard.savedVersion;
+            state.damaged = shard.damaged;
+            request->shards.push_back(std::move(state));
+        }
+        request->shardSource = shardSource;
+        request->shardFormat = shardFormat;
+    }
+    
+    // Copy-on-write: the writer already holds copies of every account unchanged since the last request.
+    // The stamp is taken first so that accounts changed during the copy are handed off again next time.
+    uint64_t handOff = Account::currentVersion();
+    accounts.forEach([this, &request](int accNum, const std::shared_ptr<Account>& account) {
+        if (request->reset || account->getVersion() > handedOffVersion) {
+            auto copy = std::make_shared<Account>(*account);
+            copy->setJournal(nullptr);
+            request->accounts.emplace(accNum, std::move(copy));
+        }
+    });
+    handedOffVersion = handOff;
+    snapshotNeedsReset = false;
+    if (cut.owns_lock()) {
+        cut.unlock();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        if (pendingSnapshot) {
+            // Not picked up yet: fold the older request's copies and reset into this one
+            request->accounts.insert(pendingSnapshot->accounts.begin(), pendingSnapshot->accounts.end());
+            if (pendingSnapshot->reset && !request->reset) {
+                request->reset = true;
+                request->shards = std::move(pendingSnapshot->shards);
+                request->shardSource = pendingSnapshot->shardSource;
+                request->shardFormat = pendingSnapshot->shardFormat;
+            }
+        }
+        pendingSnapshot = std::move(request);
+        if (!snapshotThread.joinable()) {
+            stopSnapshots = false;
+            snapshotThread = std::thread(&BankManager::snapshotLoop, this);
+        }
+    }
+    snapshotCondition.notify_all();
+}
+
+void BankManager::snapshotLoop() {
+    std::unique_lock<std::mutex> lock(snapshotMutex);
+    while (true) {
+        snapshotCondition.wait(lock, [this]() { return pendingSnapshot || stopSnapshots; });
+        if (!pendingSnapshot) {
+            break;  // Stopped with nothing left to write
+        }
+        
+        std::unique_ptr<SnapshotRequest> request = std::move(pendingSnapshot);
+        snapshotRunning = true;
+        lock.unlock();
+        bool ok = writeSnapshot(*request);
+        lock.lock();
+        
+        snapshotRunning = false;
+        lastSnapshotOk = ok;
+        if (ok) {
+            ++snapshotsWritten;
+            completedSnapshotLsn = std::max(completedSnapshotLsn, request->checkpointLsn);
+            completedSaveStats = snapshotWriter->lastSaveStats;
+        }
+        snapshotCondition.notify_all();
+    }
+}
+
+bool BankManager::writeSnapshot(const SnapshotRequest& request) {
+    if (!snapshotWriter || request.reset) {
+        snapshotWriter.reset(new BankManager());
+        snapshotWriter->shards.clear();
+        for (const auto& shard : request.shards) {
+            ShardState state;
+            state.snapshot = shard.snapshot;
+            state.checkpointLsn = shard.checkpointLsn;
+            state.savedVersion = shard.savedVersion;
+            state.damaged = shard.damaged;
+            snapshotWriter->shards.push_back(std::move(state));
+        }
+        snapshotWriter->shardSource = request.shardSource;
+        snapshotWriter->shardFormat = request.shardFormat;
+    }
+    
+    BankManager& writer = *snapshotWriter;
+    writer.shardCount = request.shardCount;
+    writer.loadThreads = loadThreads;
+    writer.nextAccountNumber = request.nextAccountNumber;
+    writer.checkpointLsn = request.checkpointLsn;
+    for (const auto& pair : request.accounts) {
+        writer.accounts.assign(pair.first, pair.second);
+    }
+    writer.countMaterialized();
+    
+    bool ok = writer.saveToFile(request.filename, request.format);
+    for (auto& message : writer.takeDiagnostics()) {
+        report(std::move(message));
+    }
+    return ok;
+}
+
+void BankManager::collectSnapshots() {
+    uint64_t lsn;
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        lsn = completedSnapshotLsn;
+        if (lsn > discardedLsn) {
+            lastSaveStats = completedSaveStats;
+        }
+    }
+    if (lsn <= discardedLsn) {
+        return;
+    }
+    
+    checkpointLsn = std::max(checkpointLsn, lsn);
+    if (journal && !journal->discardThrough(lsn)) {
+        report("Error compacting journal");
+        return;
+    }
+    discardedLsn = lsn;
+}
+
+bool BankManager::waitForSnapshots() {
+    bool ok;
+    {
+        std::unique_lock<std::mutex> lock(snapshotMutex);
+        snapshotCondition.wait(lock, [this]() { return !pendingSnapshot && !snapshotRunning; });
+        ok = lastSnapshotOk;
+    }
+    collectSnapshots();
+    return ok;
+}
+
+size_t BankManager::getSnapshotsWritten() const {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    return snapshotsWritten;
+}
+
+void BankManager::stopSnapshotThread() {
+    if (!snapshotThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        stopSnapshots = true;
+    }
+    snapshotCondition.notify_all();
+    snapshotThread.join();
+}
+
+bool BankManager::convertSnapshot(const std::string& source, const std::string& destination,
+                                  SnapshotFormat format, size_t shards,
+                                  std::vector<std::string>* diagnostics) {
+    FileManager fileManager;
+    if (!fileManager.fileExists(source)) {
+        if (diagnostics) {
+            diagnostics->push_back("Snapshot not found: " + source);
+        }
+        return false;
+    }
+    
+    // A private instance keeps the conversion independent of the singleton's state
+    BankManager converter;
+    converter.setShardCount(shards);
+    bool ok = converter.loadFromFile(source) && converter.saveToFile(destination, format);
+    if (diagnostics) {
+        for (auto& message : converter.takeDiagnostics()) {
+            diagnostics->push_back(std::move(message));
+        }
+    }
+    return ok;
+}
+
+void BankManager::report(std::string message) {
+    std::lock_guard<std::mutex> lock(diagnosticsMutex);
+    diagnostics.push_back(std::move(message));
+}
+
+std::vector<std::string> BankManager::takeDiagnostics() {
+    size_t failed = transactionLog ? transactionLog->takeFailedAppends() : 0;
+    if (failed > 0) {
+        report("Error writing " + std::to_string(failed) + " transaction(s) to the transaction log; "
+               "the full history is missing them");
+    }
+    
+    std::lock_guard<std::mutex> lock(diagnosticsMutex);
+    std::vector<std::string> taken;
+    taken.swap(diagnostics);
+    return taken;
+}
+
 void BankManager::resetInstance() {
     std::lock_guard<std::mutex> lock(mutex_);
     instance.reset();
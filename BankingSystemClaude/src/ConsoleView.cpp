@@ -0,0 +1,294 @@
+#include "ConsoleView.h"
+#include <iomanip>
+
+ConsoleView::ConsoleView(std::ostream& stream) : out(stream) {}
+
+void ConsoleView::rule(size_t width) const {
+    out << std::string(width, '=') << std::endl;
+}
+
+void ConsoleView::showMainMenu() const {
+    out << "\n";
+    rule(60);
+    out << "           🏦 WELCOME TO SECURE BANK 🏦" << std::endl;
+    rule(60);
+    out << "1. Create New Account" << std::endl;
+    out << "2. Login to Existing Account" << std::endl;
+    out << "3. Exit" << std::endl;
+    rule(60);
+    out << "Enter your choice: ";
+}
+
+void ConsoleView::showAccountMenu(const std::string& accountHolder) const {
+    out << "\n";
+    rule(60);
+    out << "           ACCOUNT MENU - " << accountHolder << std::endl;
+    rule(60);
+    out << "1. Deposit Money" << std::endl;
+    out << "2. Withdraw Money" << std::endl;
+    out << "3. Balance Enquiry" << std::endl;
+    out << "4. Account Details" << std::endl;
+    out << "5. Transaction History" << std::endl;
+    out << "6. Open Fixed Deposit" << std::endl;
+    out << "7. View Fixed Deposits" << std::endl;
+    out << "8. Transfer Money" << std::endl;
+    out << "9. Logout" << std::endl;
+    rule(60);
+    out << "Enter your choice: ";
+}
+
+void ConsoleView::showFixedDepositRates() const {
+    out << "\n";
+    rule(50);
+    out << "OPEN FIXED DEPOSIT" << std::endl;
+    rule(50);
+    out << "Interest Rates:" << std::endl;
+    out << "  12 months - 6.5% p.a." << std::endl;
+    out << "  24 months - 7.5% p.a." << std::endl;
+    rule(50);
+}
+
+void ConsoleView::showHeading(const std::string& title) const {
+    out << "\n";
+    rule(60);
+    out << "           " << title << std::endl;
+    rule(60);
+}
+
+void ConsoleView::showError(const std::string& message) const {
+    out << "❌ " << message << "!" << std::endl;
+}
+
+void ConsoleView::showAccountCreated(BankResult result, int accountNumber, const std::string& name,
+                                     Money initialBalance) const {
+    if (result != BankResult::OK) {
+        showError(bankResultMessage(result));
+        return;
+    }
+
+    out << "\n✅ Account created successfully!" << std::endl;
+    out << "Account Number: " << accountNumber << std::endl;
+    out << "Account Holder: " << name << std::endl;
+    out << "Initial Balance: ₹" << std::fixed << std::setprecision(2) << initialBalance << std::endl;
+    out << "\n⚠️  Please remember your account number and password!" << std::endl;
+}
+
+void ConsoleView::showLogin(BankResult result, const Account* account) const {
+    if (result != BankResult::OK || account == nullptr) {
+        showError(bankResultMessage(result));
+        return;
+    }
+
+    out << "\n✅ Login successful!" << std::endl;
+    out << "Welcome, " << account->getAccountHolderName() << "!" << std::endl;
+}
+
+void ConsoleView::showDeposit(OperationResult result, Money amount, const Account& account) const {
+    if (result != OperationResult::OK) {
+        showError(result == OperationResult::INVALID_AMOUNT ? "Deposit amount must be positive"
+                                                            : operationResultMessage(result));
+        return;
+    }
+
+    out << "✅ Successfully deposited ₹" << std::fixed << std::setprecision(2) << amount << std::endl;
+    out << "Current balance: ₹" << account.getBalance() << std::endl;
+}
+
+void ConsoleView::showWithdrawal(OperationResult result, Money amount, const Account& account) const {
+    if (result == OperationResult::INSUFFICIENT_BALANCE) {
+        out << "❌ Insufficient balance! Available: ₹" << std::fixed << std::setprecision(2)
+            << account.getBalance() << std::endl;
+        return;
+    }
+    if (result != OperationResult::OK) {
+        showError(result == OperationResult::INVALID_AMOUNT ? "Withdrawal amount must be positive"
+                                                            : operationResultMessage(result));
+        return;
+    }
+
+    out << "✅ Successfully withdrawn ₹" << std::fixed << std::setprecision(2) << amount << std::endl;
+    out << "Current balance: ₹" << account.getBalance() << std::endl;
+}
+
+void ConsoleView::showFixedDepositOpened(OperationResult result, const Account& account) const {
+    Account snapshot(account);
+    if (result == OperationResult::INSUFFICIENT_BALANCE) {
+        out << "❌ Insufficient balance! Available: ₹" << std::fixed << std::setprecision(2)
+            << snapshot.getBalance() << std::endl;
+        return;
+    }
+    if (result != OperationResult::OK || snapshot.getFixedDeposits().empty()) {
+        showError(result == OperationResult::INVALID_AMOUNT ? "FD amount must be positive"
+                                                            : operationResultMessage(result));
+        return;
+    }
+
+    const auto& fd = snapshot.getFixedDeposits().back();
+    out << "\n✅ Fixed Deposit opened successfully!" << std::endl;
+    out << "FD Amount         : ₹" << std::fixed << std::setprecision(2) << fd->getPrincipal() << std::endl;
+    out << "Tenure            : " << fd->getTenure() << " months" << std::endl;
+    out << "Interest Rate     : " << fd->getInterestRate() << "%" << std::endl;
+    out << "Maturity Amount   : ₹" << fd->calculateMaturityAmount() << std::endl;
+    out << "Maturity Date     : " << fd->getMaturityDate() << std::endl;
+    out << "Remaining Balance : ₹" << snapshot.getBalance() << std::endl;
+}
+
+void ConsoleView::showTransfer(TransferResult result, Money amount, int toAccount, const Account& from) const {
+    if (result != TransferResult::OK) {
+        showError(transferResultMessage(result));
+        return;
+    }
+
+    out << "✅ Successfully transferred ₹" << std::fixed << std::setprecision(2)
+        << amount << " to account " << toAccount << std::endl;
+    out << "Current balance: ₹" << from.getBalance() << std::endl;
+}
+
+void ConsoleView::showBalance(const Account& account) const {
+    out << "\n";
+    rule(50);
+    out << "💰 BALANCE ENQUIRY" << std::endl;
+    rule(50);
+    out << "Account Number: " << account.getAccountNumber() << std::endl;
+    out << "Account Holder: " << account.getAccountHolderName() << std::endl;
+    out << "Current Balance: ₹" << std::fixed << std::setprecision(2) << account.getBalance() << std::endl;
+    rule(50);
+}
+
+void ConsoleView::showAccountDetails(const Account& account) const {
+    Account snapshot(account);  // Consistent view taken under the account lock
+    out << "\n";
+    rule(60);
+    out << "📋 ACCOUNT DETAILS" << std::endl;
+    rule(60);
+    out << "Account Number    : " << snapshot.getAccountNumber() << std::endl;
+    out << "Account Holder    : " << snapshot.getAccountHolderName() << std::endl;
+    out << "Current Balance   : ₹" << std::fixed << std::setprecision(2) << snapshot.getBalance() << std::endl;
+    out << "Active FDs        : " << snapshot.getFixedDeposits().size() << std::endl;
+
+    if (!snapshot.getFixedDeposits().empty()) {
+        Money totalFDAmount;
+        for (const auto& fd : snapshot.getFixedDeposits()) {
+            totalFDAmount += fd->getPrincipal();
+        }
+        out << "Total FD Amount   : ₹" << std::fixed << std::setprecision(2) << totalFDAmount << std::endl;
+    }
+
+    rule(60);
+}
+
+void ConsoleView::showTransactionHistory(const Account& account) const {
+    Account snapshot(account);
+    const auto& history = snapshot.getTransactionHistory();
+    out << "\n";
+    rule(80);
+    out << "📜 TRANSACTION HISTORY (Last " << history.size() << " transactions)" << std::endl;
+    rule(80);
+
+    if (history.empty()) {
+        out << "No transactions yet." << std::endl;
+    } else {
+        int count = 1;
+        std::string line;
+        for (const auto& trans : history) {
+            line.clear();
+            trans.appendTo(line);
+            out << count++ << ". " << line << std::endl;
+        }
+    }
+
+    rule(80);
+}
+
+void ConsoleView::showTransactionPage(const Account& account, size_t first, size_t count) const {
+    size_t total = account.getTransactionCount();
+    std::vector<Transaction> page = account.getTransactionPage(first, count);
+    out << "\n";
+    rule(80);
+    if (page.empty()) {
+        out << "📜 TRANSACTION HISTORY (" << total << " transactions)" << std::endl;
+    } else {
+        out << "📜 TRANSACTION HISTORY (" << first + 1 << "-" << first + page.size()
+            << " of " << total << " transactions)" << std::endl;
+    }
+    rule(80);
+
+    if (total == 0) {
+        out << "No transactions yet." << std::endl;
+    } else if (page.empty()) {
+        out << "No transactions on this page." << std::endl;
+    } else {
+        size_t number = first + 1;
+        std::string line;
+        for (const auto& trans : page) {
+            line.clear();
+            trans.appendTo(line);
+            out << number++ << ". " << line << std::endl;
+        }
+    }
+
+    rule(80);
+}
+
+void ConsoleView::showFixedDeposits(const Account& account) const {
+    Account snapshot(account);
+    out << "\n";
+    rule(80);
+    out << "💎 FIXED DEPOSITS" << std::endl;
+    rule(80);
+
+    if (snapshot.getFixedDeposits().empty()) {
+        out << "No active fixed deposits." << std::endl;
+    } else {
+        int count = 1;
+        for (const auto& fd : snapshot.getFixedDeposits()) {
+            out << "\nFD #" << count++ << ":" << std::endl;
+            out << "  Principal        : ₹" << std::fixed << std::setprecision(2) << fd->getPrincipal() << std::endl;
+            out << "  Tenure           : " << fd->getTenure() << " months" << std::endl;
+            out << "  Interest Rate    : " << fd->getInterestRate() << "%" << std::endl;
+            out << "  Maturity Amount  : ₹" << fd->calculateMaturityAmount() << std::endl;
+            out << "  Maturity Date    : " << fd->getMaturityDate() << std::endl;
+        }
+    }
+
+    rule(80);
+}
+
+void ConsoleView::showMaturedDeposits(size_t credited) const {
+    if (credited > 0) {
+        out << "💰 Credited " << credited << " matured fixed deposit(s)." << std::endl;
+    }
+}
+
+void ConsoleView::showLoadStats(const BankManager::LoadStats& stats) const {
+    if (!stats.fileFound) {
+        out << "ℹ️  No existing data file found. Starting fresh." << std::endl;
+    } else {
+        out << "✅ " << (stats.indexed ? "Indexed " : "Loaded ") << stats.accounts
+            << " account(s) from " << stats.files << " file(s)." << std::endl;
+    }
+
+    if (stats.replayed > 0) {
+        out << "🔁 Replayed " << stats.replayed << " journaled operation(s)." << std::endl;
+    }
+}
+
+void ConsoleView::showSaveStats(const BankManager::SaveStats& stats) const {
+    out << "✅ Data saved successfully! (" << stats.accountsSerialized << " account(s) re-encoded, "
+        << stats.shardsWritten << " of " << stats.shards << " file(s) written, "
+        << std::fixed << std::setprecision(2) << stats.milliseconds << " ms)" << std::endl;
+}
+
+void ConsoleView::showDiagnostics(const std::vector<std::string>& diagnostics) const {
+    for (const auto& message : diagnostics) {
+        showError(message);
+    }
+}
+
+void ConsoleView::showGoodbye() const {
+    out << "\n";
+    rule(60);
+    out << "Thank you for banking with Secure Bank!" << std::endl;
+    out << "Have a great day! 👋" << std::endl;
+    rule(60);
+}
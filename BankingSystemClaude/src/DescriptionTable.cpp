@@ -0,0 +1,68 @@
+#include "DescriptionTable.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Table {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string_view, uint32_t> ids;     // Keys view the strings in texts
+    std::vector<std::unique_ptr<const std::string>> texts;  // Indexed by id; strings never move
+
+    Table() {
+        // Same order as the DescriptionTable ids
+        for (const char* text : {"", "Initial deposit", "Cash deposit", "Cash withdrawal",
+                                 "FD opened for 12 months", "FD opened for 24 months", "FD matured",
+                                 "Transfer to", "Transfer from"}) {
+            texts.emplace_back(new std::string(text));
+            ids.emplace(*texts.back(), static_cast<uint32_t>(texts.size() - 1));
+        }
+    }
+};
+
+Table& table() {
+    static Table instance;
+    return instance;
+}
+
+}
+
+uint32_t DescriptionTable::intern(std::string_view description) {
+    Table& t = table();
+    {
+        std::shared_lock<std::shared_mutex> lock(t.mutex);
+        auto it = t.ids.find(description);
+        if (it != t.ids.end()) {
+            return it->second;
+        }
+    }
+
+    // Only a new description is copied; its key views the copy
+    std::unique_lock<std::shared_mutex> lock(t.mutex);
+    auto it = t.ids.find(description);
+    if (it != t.ids.end()) {
+        return it->second;
+    }
+    if (t.texts.size() >= CAPACITY) {
+        return NONE;
+    }
+    uint32_t id = static_cast<uint32_t>(t.texts.size());
+    t.texts.emplace_back(new std::string(description));
+    t.ids.emplace(*t.texts.back(), id);
+    return id;
+}
+
+const std::string& DescriptionTable::lookup(uint32_t id) {
+    Table& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    return id < t.texts.size() ? *t.texts[id] : *t.texts[NONE];
+}
+
+size_t DescriptionTable::size() {
+    Table& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    return t.texts.size();
+}
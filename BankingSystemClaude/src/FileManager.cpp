@@ -1,8 +1,16 @@
 #include "FileManager.h"
 #include <sys/stat.h>
 #include <sys/types.h>
-#include <iostream>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include <sstream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
 
 FileManager::FileManager(const std::string& dataDir) : dataDirectory(dataDir) {}
 
@@ -32,31 +40,286 @@ std::string FileManager::getFilePath(const std::string& filename) const {
 
 bool FileManager::writeToFile(const std::string& filename, const std::string& data) {
     std::string filepath = getFilePath(filename);
-    std::ofstream file(filepath, std::ios::out | std::ios::trunc);
+    std::string tempPath = filepath + ".tmp";
     
-    if (!file.is_open()) {
+    // Write a sibling temp file and rename it over the target, so a crash leaves
+    // either the complete old file or the complete new one
+#ifndef _WIN32
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    const char* next = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+        ssize_t count = write(fd, next, left);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            close(fd);
+            unlink(tempPath.c_str());
+            return false;
+        }
+        next += count;
+        left -= static_cast<size_t>(count);
+    }
+    
+    // The data must be on disk before the rename makes it visible
+    bool synced = fsync(fd) == 0;
+    if (close(fd) != 0 || !synced || rename(tempPath.c_str(), filepath.c_str()) != 0) {
+        unlink(tempPath.c_str());
         return false;
     }
     
+    // Persist the directory entry so the rename itself survives a crash
+    int dirFd = open(dataDirectory.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        close(dirFd);
+    }
+    return true;
+#else
+    std::ofstream file(tempPath, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
     file << data;
     file.close();
+    if (!file.good()) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
     
-    return file.good();
+    // rename() does not replace an existing file on Windows
+    std::remove(filepath.c_str());
+    return std::rename(tempPath.c_str(), filepath.c_str()) == 0;
+#endif
 }
 
 std::string FileManager::readFromFile(const std::string& filename) {
     std::string filepath = getFilePath(filename);
-    std::ifstream file(filepath, std::ios::in);
+    std::ifstream file(filepath, std::ios::in | std::ios::binary | std::ios::ate);
     
     if (!file.is_open()) {
         return "";
     }
     
+    // Read straight into the result instead of through an intermediate stringstream
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&data[0], static_cast<std::streamsize>(data.size()));
+    data.resize(static_cast<size_t>(file.gcount()));
+    file.close();
+    
+    return data;
+}
+
+std::unique_ptr<FileManager::BlockReader> FileManager::openBlockReader(const std::string& filename,
+                                                                       size_t bufferSize) const {
+    return std::unique_ptr<BlockReader>(new BlockReader(getFilePath(filename), bufferSize));
+}
+
+std::unique_ptr<FileManager::MappedFile> FileManager::mapFile(const std::string& filename) const {
+    return std::unique_ptr<MappedFile>(new MappedFile(getFilePath(filename)));
+}
+
+FileManager::MappedFile::MappedFile(const std::string& filepath) : address(nullptr), length(0) {
+#ifndef _WIN32
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            address = static_cast<const char*>(mapped);
+            length = static_cast<size_t>(info.st_size);
+        }
+    }
+    close(fd);
+    
+    if (address != nullptr) {
+        return;
+    }
+#endif
+    
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
     std::stringstream buffer;
     buffer << file.rdbuf();
-    file.close();
+    fallback = buffer.str();
+    address = fallback.data();
+    length = fallback.size();
+}
+
+FileManager::MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (address != nullptr && address != fallback.data()) {
+        munmap(const_cast<char*>(address), length);
+    }
+#endif
+}
+
+FileManager::BlockReader::BlockReader(const std::string& filepath, size_t bufferSize)
+    : file(filepath, std::ios::in | std::ios::binary),
+      buffer(std::max<size_t>(bufferSize, 16)), begin(0), end(0), atEof(false) {}
+
+bool FileManager::BlockReader::fill() {
+    if (atEof) {
+        return false;
+    }
+    
+    if (begin > 0) {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    
+    // Only a single record larger than the buffer makes it grow
+    if (end == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+    }
+    
+    file.read(buffer.data() + end, static_cast<std::streamsize>(buffer.size() - end));
+    size_t count = static_cast<size_t>(file.gcount());
+    end += count;
+    
+    if (count == 0) {
+        atEof = true;
+        return false;
+    }
+    
+    return true;
+}
+
+bool FileManager::BlockReader::fillLines() {
+    if (fill()) {
+        return true;
+    }
     
-    return buffer.str();
+    // Terminate a final line that lacks its newline so line scanning stays uniform
+    if (end > begin && buffer[end - 1] != '\n') {
+        if (end == buffer.size()) {
+            buffer.resize(buffer.size() + 1);
+        }
+        buffer[end++] = '\n';
+        return true;
+    }
+    return false;
+}
+
+size_t FileManager::BlockReader::findNewline(size_t from) const {
+    const void* found = std::memchr(buffer.data() + from, '\n', end - from);
+    return found ? static_cast<size_t>(static_cast<const char*>(found) - buffer.data()) : std::string::npos;
+}
+
+bool FileManager::BlockReader::lineEquals(size_t pos, size_t newline, std::string_view text) const {
+    return std::string_view(buffer.data() + pos, newline - pos) == text;
+}
+
+bool FileManager::BlockReader::peek(size_t size, std::string_view& out) {
+    while (end - begin < size) {
+        if (!fill()) {
+            return false;
+        }
+    }
+    out = std::string_view(buffer.data() + begin, size);
+    return true;
+}
+
+bool FileManager::BlockReader::read(size_t size, std::string_view& out) {
+    if (!peek(size, out)) {
+        return false;
+    }
+    begin += size;
+    return true;
+}
+
+bool FileManager::BlockReader::nextLine(std::string_view& line) {
+    size_t newline;
+    while ((newline = findNewline(begin)) == std::string::npos) {
+        if (!fillLines()) {
+            return false;
+        }
+    }
+    line = std::string_view(buffer.data() + begin, newline - begin);
+    begin = newline + 1;
+    return true;
+}
+
+size_t FileManager::BlockReader::nextBlocks(std::string_view startLine, std::string_view endLine,
+                                            std::vector<std::string_view>& blocks) {
+    blocks.clear();
+    
+    while (true) {
+        size_t newline;
+        while ((newline = findNewline(begin)) != std::string::npos) {
+            if (!lineEquals(begin, newline, startLine)) {
+                begin = newline + 1;  // Not inside a block
+                continue;
+            }
+            
+            // Look for the end marker; an incomplete block is rescanned after the next fill
+            size_t bodyStart = newline + 1;
+            size_t pos = bodyStart;
+            size_t bodyEnd = std::string::npos;
+            size_t next = std::string::npos;
+            while ((newline = findNewline(pos)) != std::string::npos) {
+                if (lineEquals(pos, newline, endLine)) {
+                    bodyEnd = pos;
+                    next = newline + 1;
+                    break;
+                }
+                pos = newline + 1;
+            }
+            if (bodyEnd == std::string::npos && atEof) {
+                bodyEnd = end;
+                next = end;
+            }
+            if (bodyEnd == std::string::npos) {
+                break;
+            }
+            
+            blocks.emplace_back(buffer.data() + bodyStart, bodyEnd - bodyStart);
+            begin = next;
+        }
+        
+        // Refilling moves the buffer, so hand out what we have first
+        if (!blocks.empty() || !fillLines()) {
+            return blocks.size();
+        }
+    }
+}
+
+size_t FileManager::BlockReader::nextRecords(size_t maxRecords, std::vector<std::string_view>& records) {
+    records.clear();
+    
+    while (true) {
+        while (records.size() < maxRecords && end - begin >= sizeof(uint32_t)) {
+            uint32_t length;
+            std::memcpy(&length, buffer.data() + begin, sizeof(length));
+            size_t total = sizeof(length) + length;
+            if (end - begin < total) {
+                // Make sure a record larger than the whole buffer can still be read
+                if (begin == 0 && total > buffer.size()) {
+                    buffer.resize(total);
+                }
+                break;
+            }
+            records.emplace_back(buffer.data() + begin, total);
+            begin += total;
+        }
+        
+        if (!records.empty() || records.size() >= maxRecords || !fill()) {
+            return records.size();
+        }
+    }
 }
 
 bool FileManager::fileExists(const std::string& filename) const {
@@ -1,15 +1,35 @@
 #include "FixedDeposit.h"
+#include "BinaryIO.h"
 #include <stdexcept>
 #include <cmath>
 #include <sstream>
 #include <ctime>
-#include <iomanip>
 #include <vector>
 
-FixedDeposit::FixedDeposit(double amount, int months)
-    : principal(amount), tenure(months), openDate(std::chrono::system_clock::now()) {
+namespace {
+
+/**
+ * Thread-safe localtime: FDs are constructed on many loader threads
+ */
+std::tm localTime(std::time_t time) {
+    std::tm result{};
+#ifdef _WIN32
+    localtime_s(&result, &time);
+#else
+    localtime_r(&time, &result);
+#endif
+    return result;
+}
+
+}
+
+FixedDeposit::FixedDeposit(Money amount, int months)
+    : FixedDeposit(amount, months, std::chrono::system_clock::now()) {}
+
+FixedDeposit::FixedDeposit(Money amount, int months, std::chrono::system_clock::time_point opened)
+    : principal(amount), tenure(months), openDate(opened) {
     
-    if (amount <= 0) {
+    if (!amount.isPositive()) {
         throw std::invalid_argument("FD amount must be positive");
     }
     
@@ -23,35 +43,39 @@ FixedDeposit::FixedDeposit(double amount, int months)
     } else {
         interestRate = 7.5;  // 7.5% for 24 months
     }
+    
+    computeMaturity();
 }
 
-double FixedDeposit::calculateMaturityAmount() const {
-    // Simple interest calculation: A = P * (1 + (r * t))
-    // where r is rate per year, t is time in years
-    double rate = interestRate / 100.0;
-    double years = tenure / 12.0;
-    double maturityAmount = principal * (1 + (rate * years));
+void FixedDeposit::computeMaturity() {
+    // One time-zone lookup for the open date; the month arithmetic is plain day counting
+    CivilDate openDay = localDate(openDate);
+    maturityDate = openDay.plusMonths(tenure);
     
-    return maturityAmount;
+    // Whole days later, so the time of day is kept (up to a DST change in between)
+    maturityTime = openDate + std::chrono::hours(24 * (maturityDate.toDays() - openDay.toDays()));
 }
 
-std::string FixedDeposit::getMaturityDate() const {
-    // Add tenure months to open date
-    std::time_t openTime = std::chrono::system_clock::to_time_t(openDate);
-    std::tm* tm = std::localtime(&openTime);
+Money FixedDeposit::calculateMaturityAmount() const {
+    // Simple interest calculation: A = P + P * r * t
+    // with r in basis points per year and t in months, so only the final division rounds
+    int64_t basisPoints = std::llround(interestRate * 100);
     
-    tm->tm_mon += tenure;
-    // Handle year overflow
-    while (tm->tm_mon >= 12) {
-        tm->tm_mon -= 12;
-        tm->tm_year++;
-    }
-    
-    std::time_t maturityTime = std::mktime(tm);
-    char buffer[100];
-    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", std::localtime(&maturityTime));
-    
-    return std::string(buffer);
+    return principal + principal.scaled(basisPoints * tenure, 10000 * 12);
+}
+
+std::string FixedDeposit::getMaturityDate() const {
+    char buffer[CivilDate::FORMATTED_SIZE];
+    return std::string(buffer, maturityDate.format(buffer));
+}
+
+CivilDate FixedDeposit::localDate(std::chrono::system_clock::time_point time) {
+    std::tm tm = localTime(std::chrono::system_clock::to_time_t(time));
+    return CivilDate{tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1), static_cast<unsigned>(tm.tm_mday)};
+}
+
+int FixedDeposit::monthIndex(std::chrono::system_clock::time_point time) {
+    return localDate(time).monthIndex();
 }
 
 std::string FixedDeposit::serialize() const {
@@ -67,26 +91,63 @@ std::string FixedDeposit::serialize() const {
 }
 
 FixedDeposit FixedDeposit::deserialize(const std::string& data) {
-    std::stringstream ss(data);
-    std::string token;
-    std::vector<std::string> tokens;
-    
-    while (std::getline(ss, token, '|')) {
-        tokens.push_back(token);
+    std::shared_ptr<FixedDeposit> fd;
+    ParseError error = parse(data, fd);
+    if (error != ParseError::NONE) {
+        throw std::runtime_error(std::string("Invalid FD data: ") + parseErrorMessage(error));
+    }
+    return *fd;
+}
+
+ParseError FixedDeposit::parse(std::string_view data, std::shared_ptr<FixedDeposit>& out) {
+    // Format: principal|tenure|interestRate|timestamp
+    TextScanner scanner(data);
+    std::string_view principalField = scanner.nextField();
+    std::string_view tenureField = scanner.nextField();
+    std::string_view rateField = scanner.nextField();
+    if (scanner.atEnd()) {
+        return ParseError::MISSING_FIELD;
     }
+    std::string_view timeField = scanner.nextField();
     
-    if (tokens.size() < 4) {
-        throw std::runtime_error("Invalid FD data");
+    Money principal;
+    int tenure;
+    double interestRate;
+    long long time;
+    if (!Money::parse(principalField, principal) ||
+        !TextScanner::parseNumber(tenureField, tenure) ||
+        !TextScanner::parseNumber(rateField, interestRate) ||
+        !TextScanner::parseNumber(timeField, time)) {
+        return ParseError::INVALID_NUMBER;
+    }
+    // Checked here so the constructor's invariants never throw
+    if (!principal.isPositive() || (tenure != 12 && tenure != 24)) {
+        return ParseError::INVALID_VALUE;
     }
     
-    double principal = std::stod(tokens[0]);
-    int tenure = std::stoi(tokens[1]);
-    double interestRate = std::stod(tokens[2]);
-    std::time_t time = std::stoll(tokens[3]);
+    out = std::make_shared<FixedDeposit>(principal, tenure,
+        std::chrono::system_clock::from_time_t(static_cast<std::time_t>(time)));
+    out->interestRate = interestRate;
     
-    FixedDeposit fd(principal, tenure);
+    return ParseError::NONE;
+}
+
+void FixedDeposit::serializeBinary(BinaryWriter& out) const {
+    // Format: i64 principal | i32 tenure | f64 interestRate | i64 openDate
+    out.writeMoney(principal);
+    out.writeI32(tenure);
+    out.writeF64(interestRate);
+    out.writeI64(static_cast<int64_t>(std::chrono::system_clock::to_time_t(openDate)));
+}
+
+FixedDeposit FixedDeposit::deserializeBinary(BinaryReader& in, AmountFormat amounts) {
+    Money principal = in.readMoney(amounts);
+    int tenure = in.readI32();
+    double interestRate = in.readF64();
+    std::time_t time = static_cast<std::time_t>(in.readI64());
+
+    FixedDeposit fd(principal, tenure, std::chrono::system_clock::from_time_t(time));
     fd.interestRate = interestRate;
-    fd.openDate = std::chrono::system_clock::from_time_t(time);
-    
+
     return fd;
 }
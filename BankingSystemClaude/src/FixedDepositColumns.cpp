@@ -0,0 +1,176 @@
+#include "FixedDepositColumns.h"
+#include "FixedDeposit.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <future>
+
+namespace {
+
+/**
+ * Per-slot sums of one scan. Slot 0 is overdue, slots 1..months are the
+ * months, slot months + 1 is later and the last slot collects free rows.
+ */
+struct Tally {
+    std::vector<size_t> deposits;
+    std::vector<int64_t> principal;
+    std::vector<int64_t> payout;
+
+    explicit Tally(size_t slots) : deposits(slots, 0), principal(slots, 0), payout(slots, 0) {}
+
+    void add(const Tally& other) {
+        for (size_t s = 0; s < deposits.size(); ++s) {
+            deposits[s] += other.deposits[s];
+            principal[s] += other.principal[s];
+            payout[s] += other.payout[s];
+        }
+    }
+
+    MaturityBucket bucket(size_t slot) const {
+        MaturityBucket result;
+        result.deposits = deposits[slot];
+        result.principal = Money::fromPaise(principal[slot]);
+        result.payout = Money::fromPaise(payout[slot]);
+        return result;
+    }
+};
+
+/**
+ * Add one chunk to a tally in two passes. The first turns maturity months
+ * into slots with branch-free integer arithmetic over the column arrays, which
+ * the compiler vectorizes; the second adds each row to its slot.
+ */
+void tallyChunk(const FixedDepositColumns::Chunk& chunk, size_t used, int firstMonth, size_t months, Tally& tally) {
+    uint32_t slots[FixedDepositColumns::CHUNK_ROWS];
+    const int32_t later = static_cast<int32_t>(months) + 1;
+    const int32_t unused = later + 1;
+    const int32_t offset = 1 - firstMonth;
+
+    for (size_t i = 0; i < used; ++i) {
+        int32_t slot = chunk.maturityMonth[i] + offset;
+        slot = slot < 0 ? 0 : slot;
+        slot = slot > later ? later : slot;
+        slots[i] = static_cast<uint32_t>(chunk.occupied[i] ? slot : unused);
+    }
+
+    size_t* deposits = tally.deposits.data();
+    int64_t* principal = tally.principal.data();
+    int64_t* payout = tally.payout.data();
+    for (size_t i = 0; i < used; ++i) {
+        uint32_t slot = slots[i];
+        ++deposits[slot];
+        principal[slot] += chunk.principal[i];
+        payout[slot] += chunk.payout[i];
+    }
+}
+
+}
+
+FixedDepositColumns::FixedDepositColumns() : nextRow(0), rows(0) {}
+
+size_t FixedDepositColumns::usedRows(size_t chunk) const {
+    size_t used = nextRow - chunk * CHUNK_ROWS;
+    return used < CHUNK_ROWS ? used : CHUNK_ROWS;
+}
+
+FixedDepositColumns::Cell FixedDepositColumns::attach(int accountNumber, const FixedDeposit& fd) {
+    Cell cell;
+    {
+        std::unique_lock<std::shared_mutex> lock(chunksMutex);
+        if (!freeRows.empty()) {
+            cell.index = freeRows.back();
+            freeRows.pop_back();
+        } else {
+            cell.index = nextRow++;
+            if (cell.index / CHUNK_ROWS == chunks.size()) {
+                chunks.emplace_back(new Chunk());
+            }
+        }
+        cell.chunk = chunks[cell.index / CHUNK_ROWS].get();
+        cell.row = cell.index % CHUNK_ROWS;
+        ++rows;
+    }
+
+    int64_t payout = fd.calculateMaturityAmount().toPaise();
+
+    std::unique_lock<std::shared_mutex> lock(cell.chunk->mutex);
+    cell.chunk->occupied[cell.row] = true;
+    cell.chunk->accountNumbers[cell.row] = accountNumber;
+    cell.chunk->principal[cell.row] = fd.getPrincipal().toPaise();
+    cell.chunk->maturityMonth[cell.row] = fd.getMaturityMonth();
+    cell.chunk->payout[cell.row] = payout;
+    return cell;
+}
+
+void FixedDepositColumns::release(const Cell& cell) {
+    {
+        std::unique_lock<std::shared_mutex> lock(cell.chunk->mutex);
+        cell.chunk->occupied[cell.row] = false;
+        cell.chunk->accountNumbers[cell.row] = 0;
+        cell.chunk->principal[cell.row] = 0;
+        cell.chunk->maturityMonth[cell.row] = 0;
+        cell.chunk->payout[cell.row] = 0;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(chunksMutex);
+    freeRows.push_back(cell.index);
+    --rows;
+}
+
+size_t FixedDepositColumns::size() const {
+    std::shared_lock<std::shared_mutex> lock(chunksMutex);
+    return rows;
+}
+
+MaturityProjection FixedDepositColumns::project(int firstMonth, size_t months, size_t threads) const {
+    const size_t slots = months + 3;
+    Tally tally(slots);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(chunksMutex);
+        auto tallyChunks = [this, firstMonth, months](size_t first, size_t stride, Tally& into) {
+            for (size_t c = first; c < chunks.size(); c += stride) {
+                const Chunk& chunk = *chunks[c];
+                std::unique_lock<std::shared_mutex> chunkLock(chunk.mutex);
+                tallyChunk(chunk, usedRows(c), firstMonth, months, into);
+            }
+        };
+
+        threads = std::min(threads, chunks.size());
+        if (threads <= 1) {
+            tallyChunks(0, 1, tally);
+        } else {
+            // Each worker tallies every threads-th chunk into its own slots; the tallies are added at the end
+            std::vector<Tally> partial(threads, Tally(slots));
+            ThreadPool pool(threads);
+            std::vector<std::future<void>> pending;
+            for (size_t t = 0; t < threads; ++t) {
+                pending.push_back(pool.submit([&tallyChunks, &partial, t, threads]() {
+                    tallyChunks(t, threads, partial[t]);
+                }));
+            }
+            for (auto& task : pending) {
+                task.get();
+            }
+            for (const Tally& part : partial) {
+                tally.add(part);
+            }
+        }
+    }
+
+    MaturityProjection projection;
+    projection.firstMonth = firstMonth;
+    projection.overdue = tally.bucket(0);
+    projection.months.reserve(months);
+    for (size_t m = 1; m <= months; ++m) {
+        projection.months.push_back(tally.bucket(m));
+    }
+    projection.later = tally.bucket(months + 1);
+
+    for (size_t s = 0; s <= months + 1; ++s) {
+        MaturityBucket bucket = tally.bucket(s);
+        projection.total.deposits += bucket.deposits;
+        projection.total.principal += bucket.principal;
+        projection.total.payout += bucket.payout;
+    }
+    return projection;
+}
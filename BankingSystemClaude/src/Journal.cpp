@@ -0,0 +1,336 @@
+#include "Journal.h"
+#include "FileManager.h"
+#include <sstream>
+#include <stdexcept>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+char operationCode(JournalEntry::Operation op) {
+    switch (op) {
+        case JournalEntry::Operation::CREATE_ACCOUNT: return 'C';
+        case JournalEntry::Operation::DEPOSIT: return 'D';
+        case JournalEntry::Operation::WITHDRAWAL: return 'W';
+        case JournalEntry::Operation::FD_OPEN: return 'F';
+        case JournalEntry::Operation::TRANSFER: return 'T';
+        case JournalEntry::Operation::FD_MATURITY: return 'M';
+    }
+    return '?';
+}
+
+JournalEntry::Operation operationFromCode(const std::string& code) {
+    if (code == "C") return JournalEntry::Operation::CREATE_ACCOUNT;
+    if (code == "D") return JournalEntry::Operation::DEPOSIT;
+    if (code == "W") return JournalEntry::Operation::WITHDRAWAL;
+    if (code == "F") return JournalEntry::Operation::FD_OPEN;
+    if (code == "T") return JournalEntry::Operation::TRANSFER;
+    if (code == "M") return JournalEntry::Operation::FD_MATURITY;
+    throw std::runtime_error("Invalid journal operation: " + code);
+}
+
+}
+
+std::string JournalEntry::serialize() const {
+    std::stringstream ss;
+    ss.precision(17);
+
+    // Format: lsn|op|accNum|amount|tenure|timestamp|passwordHash|holderName
+    // The holder name is last so that it may contain any character but newline.
+    // A transfer stores its counterparty in the tenure column.
+    ss << lsn << "|"
+       << operationCode(operation) << "|"
+       << accountNumber << "|"
+       << amount << "|"
+       << (operation == Operation::TRANSFER ? counterparty : tenure) << "|"
+       << timestamp << "|"
+       << passwordHash << "|"
+       << holderName;
+
+    return ss.str();
+}
+
+JournalEntry JournalEntry::deserialize(const std::string& line) {
+    std::stringstream ss(line);
+    std::string token;
+    std::vector<std::string> tokens;
+
+    // Split the first seven fields; the remainder is the holder name
+    while (tokens.size() < 7 && std::getline(ss, token, '|')) {
+        tokens.push_back(token);
+    }
+
+    if (tokens.size() < 7) {
+        throw std::runtime_error("Invalid journal entry");
+    }
+
+    JournalEntry entry;
+    entry.lsn = std::stoull(tokens[0]);
+    entry.operation = operationFromCode(tokens[1]);
+    entry.accountNumber = std::stoi(tokens[2]);
+    if (!Money::parse(tokens[3], entry.amount)) {
+        throw std::runtime_error("Invalid journal amount");
+    }
+    if (entry.operation == Operation::TRANSFER) {
+        entry.counterparty = std::stoi(tokens[4]);
+    } else {
+        entry.tenure = std::stoi(tokens[4]);
+    }
+    entry.timestamp = static_cast<std::time_t>(std::stoll(tokens[5]));
+    entry.passwordHash = tokens[6];
+    std::getline(ss, entry.holderName);
+
+    return entry;
+}
+
+Journal::Journal(const std::string& file, const std::string& dataDir)
+    : filename(file), dataDirectory(dataDir), syncFd(-1), nextLsn(1), pendingEntries(0),
+      maxCommitDelay(0), maxCommitBatch(DEFAULT_COMMIT_BATCH), committing(false), stopping(false), commitCount(0) {}
+
+Journal::~Journal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    commitCondition.notify_all();
+    if (committer.joinable()) {
+        committer.join();
+    }
+#ifndef _WIN32
+    if (syncFd >= 0) {
+        close(syncFd);
+    }
+#endif
+}
+
+std::string Journal::getFilePath() const {
+    return dataDirectory + "/" + filename;
+}
+
+bool Journal::openStream(bool truncate) {
+    if (stream.is_open()) {
+        stream.close();
+    }
+    stream.clear();
+    stream.open(getFilePath(), std::ios::out | std::ios::binary | (truncate ? std::ios::trunc : std::ios::app));
+    
+#ifndef _WIN32
+    // fsync through any descriptor syncs the file, including what the stream wrote
+    if (syncFd >= 0) {
+        close(syncFd);
+    }
+    syncFd = ::open(getFilePath().c_str(), O_RDONLY);
+#endif
+    return stream.is_open();
+}
+
+bool Journal::open() {
+    FileManager fileManager(dataDirectory);
+    if (!fileManager.ensureDataDirectory()) {
+        return false;
+    }
+
+    // Continue numbering after whatever is already in the file
+    std::vector<JournalEntry> existing = readEntries();
+    std::lock_guard<std::mutex> lock(mutex);
+    pendingEntries = existing.size();
+    if (!existing.empty() && existing.back().lsn + 1 > nextLsn) {
+        nextLsn = existing.back().lsn + 1;
+    }
+
+    return openStream(false);
+}
+
+uint64_t Journal::append(JournalEntry entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!stream.is_open()) {
+        return 0;
+    }
+
+    entry.lsn = nextLsn++;
+    stream << entry.serialize() << '\n';
+    stream.flush();
+    ++pendingEntries;
+
+    return entry.lsn;
+}
+
+bool Journal::appendBatch(std::vector<JournalEntry>& entries) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!stream.is_open()) {
+        return false;
+    }
+    
+    for (auto& entry : entries) {
+        entry.lsn = nextLsn++;
+        stream << entry.serialize() << '\n';
+    }
+    stream.flush();
+    pendingEntries += entries.size();
+    
+    return true;
+}
+
+std::future<bool> Journal::appendDurable(JournalEntry entry) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!stream.is_open()) {
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future();
+    }
+
+    // Written to the stream buffer now; the commit thread flushes and syncs it
+    entry.lsn = nextLsn++;
+    stream << entry.serialize() << '\n';
+    ++pendingEntries;
+
+    waiting.emplace_back();
+    std::future<bool> committed = waiting.back().get_future();
+    if (!committer.joinable()) {
+        committer = std::thread(&Journal::commitLoop, this);
+    }
+    lock.unlock();
+    commitCondition.notify_one();
+
+    return committed;
+}
+
+void Journal::commitLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        commitCondition.wait(lock, [this]() { return !waiting.empty() || stopping; });
+        if (waiting.empty()) {
+            break;  // Stopped with nothing left to commit
+        }
+
+        // Hold the commit open so that concurrent callers share one fsync
+        if (maxCommitDelay.count() > 0) {
+            auto deadline = std::chrono::steady_clock::now() + maxCommitDelay;
+            commitCondition.wait_until(lock, deadline, [this]() {
+                return stopping || waiting.size() >= maxCommitBatch;
+            });
+        }
+
+        std::vector<std::promise<bool>> batch;
+        batch.swap(waiting);
+        committing = true;
+        stream.flush();
+        bool ok = stream.good();
+        int fd = syncFd;
+
+        // Appends continue into the stream buffer while this batch syncs
+        lock.unlock();
+#ifndef _WIN32
+        ok = ok && fd >= 0 && fsync(fd) == 0;
+#else
+        (void)fd;
+#endif
+        for (auto& caller : batch) {
+            caller.set_value(ok);
+        }
+        lock.lock();
+
+        committing = false;
+        ++commitCount;
+        idleCondition.notify_all();
+    }
+}
+
+void Journal::drain(std::unique_lock<std::mutex>& lock) {
+    idleCondition.wait(lock, [this]() { return waiting.empty() && !committing; });
+}
+
+void Journal::setMaxCommitDelay(std::chrono::microseconds delay) {
+    std::lock_guard<std::mutex> lock(mutex);
+    maxCommitDelay = delay;
+}
+
+void Journal::setMaxCommitBatch(size_t callers) {
+    std::lock_guard<std::mutex> lock(mutex);
+    maxCommitBatch = callers == 0 ? 1 : callers;
+}
+
+size_t Journal::getCommitCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return commitCount;
+}
+
+std::vector<JournalEntry> Journal::readEntries() const {
+    std::vector<JournalEntry> entries;
+    std::ifstream file(getFilePath(), std::ios::in | std::ios::binary);
+
+    if (!file.is_open()) {
+        return entries;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        // A line without its newline was torn by a crash mid-append
+        if (file.eof()) {
+            break;
+        }
+
+        try {
+            entries.push_back(JournalEntry::deserialize(line));
+        } catch (const std::exception&) {
+            break;  // Nothing after a damaged entry can be trusted
+        }
+    }
+
+    return entries;
+}
+
+bool Journal::reset() {
+    std::unique_lock<std::mutex> lock(mutex);
+    drain(lock);
+    pendingEntries = 0;
+
+    return openStream(true);
+}
+
+bool Journal::discardThrough(uint64_t lsn) {
+    std::unique_lock<std::mutex> lock(mutex);
+    drain(lock);
+    stream.flush();
+
+    std::string tail;
+    size_t kept = 0;
+    for (const auto& entry : readEntries()) {
+        if (entry.lsn > lsn) {
+            tail += entry.serialize();
+            tail += '\n';
+            ++kept;
+        }
+    }
+    
+    stream.close();
+    FileManager fileManager(dataDirectory);
+    bool written = fileManager.writeToFile(filename, tail);
+    pendingEntries = kept;
+    
+    return openStream(false) && written;
+}
+
+void Journal::advanceLsn(uint64_t lsn) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (lsn > nextLsn) {
+        nextLsn = lsn;
+    }
+}
+
+uint64_t Journal::getLastLsn() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nextLsn - 1;
+}
+
+size_t Journal::getPendingEntries() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pendingEntries;
+}
+
+bool Journal::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stream.is_open();
+}
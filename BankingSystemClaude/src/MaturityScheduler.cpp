@@ -0,0 +1,46 @@
+#include "MaturityScheduler.h"
+#include <algorithm>
+#include <unordered_set>
+
+void MaturityScheduler::schedule(int accountNumber, std::chrono::system_clock::time_point maturity) {
+    Entry entry{static_cast<int64_t>(maturity.time_since_epoch().count()), accountNumber};
+    std::lock_guard<std::mutex> lock(mutex);
+    heap.push_back(entry);
+    std::push_heap(heap.begin(), heap.end());
+}
+
+std::vector<int> MaturityScheduler::takeDue(std::chrono::system_clock::time_point now) {
+    int64_t limit = static_cast<int64_t>(now.time_since_epoch().count());
+    std::vector<int> due;
+    std::unordered_set<int> seen;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!heap.empty() && heap.front().maturity <= limit) {
+        int accountNumber = heap.front().accountNumber;
+        std::pop_heap(heap.begin(), heap.end());
+        heap.pop_back();
+        if (seen.insert(accountNumber).second) {
+            due.push_back(accountNumber);
+        }
+    }
+    return due;
+}
+
+bool MaturityScheduler::nextMaturity(std::chrono::system_clock::time_point& when) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (heap.empty()) {
+        return false;
+    }
+    when = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(heap.front().maturity));
+    return true;
+}
+
+size_t MaturityScheduler::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return heap.size();
+}
+
+void MaturityScheduler::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    heap.clear();
+}
@@ -0,0 +1,113 @@
+#include "Money.h"
+#include "TextScanner.h"
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+bool Money::fromRupees(double value, Money& out) {
+    // -2^63 and 2^63 are exact doubles; the negated test also rejects NaN
+    double scaled = value * 100;
+    if (!(scaled >= -9223372036854775808.0 && scaled < 9223372036854775808.0)) {
+        return false;
+    }
+    out = Money(static_cast<int64_t>(std::llround(scaled)));
+    return true;
+}
+
+Money Money::fromRupees(double value) {
+    Money amount;
+    if (!fromRupees(value, amount)) {
+        throw std::out_of_range("Rupee amount out of range");
+    }
+    return amount;
+}
+
+bool Money::parse(std::string_view text, Money& out) {
+    // Fast exact path: [-]digits[.digits]
+    std::string_view digits = text;
+    bool negative = !digits.empty() && digits.front() == '-';
+    if (negative) {
+        digits.remove_prefix(1);
+    }
+    size_t point = digits.find('.');
+    std::string_view whole = digits.substr(0, point);
+    std::string_view fraction = point == std::string_view::npos ? std::string_view() : digits.substr(point + 1);
+
+    bool plain = !whole.empty() && whole.size() <= 16 && fraction.size() <= 2;
+    for (char c : whole) {
+        plain = plain && c >= '0' && c <= '9';
+    }
+    for (char c : fraction) {
+        plain = plain && c >= '0' && c <= '9';
+    }
+    if (plain) {
+        int64_t value = 0;
+        for (char c : whole) {
+            value = value * 10 + (c - '0');
+        }
+        for (size_t i = 0; i < 2; ++i) {
+            value = value * 10 + (i < fraction.size() ? fraction[i] - '0' : 0);
+        }
+        out = Money(negative ? -value : value);
+        return true;
+    }
+
+    // Anything else (long fractions, exponents) goes through a double
+    double rupees;
+    return TextScanner::parseNumber(text, rupees) && fromRupees(rupees, out);
+}
+
+std::string Money::toString() const {
+    char buffer[FORMATTED_MAX];
+    return std::string(buffer, format(buffer));
+}
+
+size_t Money::format(char* out) const {
+    // Work on the magnitude as unsigned so INT64_MIN does not overflow
+    uint64_t magnitude = paise < 0 ? 0 - static_cast<uint64_t>(paise) : static_cast<uint64_t>(paise);
+    
+    // Digits are produced from the right, then moved to the front
+    char digits[FORMATTED_MAX];
+    char* end = digits + FORMATTED_MAX;
+    char* p = end;
+    unsigned fraction = static_cast<unsigned>(magnitude % 100);
+    *--p = static_cast<char>('0' + fraction % 10);
+    *--p = static_cast<char>('0' + fraction / 10);
+    *--p = '.';
+    uint64_t whole = magnitude / 100;
+    do {
+        *--p = static_cast<char>('0' + whole % 10);
+        whole /= 10;
+    } while (whole != 0);
+    if (paise < 0) {
+        *--p = '-';
+    }
+    
+    size_t length = static_cast<size_t>(end - p);
+    std::memcpy(out, p, length);
+    return length;
+}
+
+Money Money::scaled(int64_t numerator, int64_t denominator) const {
+    int64_t product = paise * numerator;
+    int64_t quotient = product / denominator;
+    int64_t remainder = product % denominator;
+    if (remainder != 0 && 2 * (remainder < 0 ? -remainder : remainder) >= (denominator < 0 ? -denominator : denominator)) {
+        quotient += ((product < 0) != (denominator < 0)) ? -1 : 1;
+    }
+    return Money(quotient);
+}
+
+std::ostream& operator<<(std::ostream& out, Money amount) {
+    return out << amount.toString();
+}
+
+std::istream& operator>>(std::istream& in, Money& amount) {
+    std::string text;
+    if (in >> text && !Money::parse(text, amount)) {
+        in.setstate(std::ios::failbit);
+    }
+    return in;
+}
@@ -0,0 +1,110 @@
+#include "TimestampFormatter.h"
+#include "CivilDate.h"
+#include <cstring>
+
+namespace {
+
+/**
+ * Thread-safe localtime
+ */
+std::tm localTime(std::time_t time) {
+    std::tm result{};
+#ifdef _WIN32
+    localtime_s(&result, &time);
+#else
+    localtime_r(&time, &result);
+#endif
+    return result;
+}
+
+int secondsOfDay(const std::tm& tm) {
+    return tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+}
+
+/**
+ * Seconds [start, end) that share one rendered date and one UTC offset, so
+ * the wall-clock seconds since midnight are time - midnight
+ */
+struct CachedDay {
+    std::time_t start = 1;
+    std::time_t end = 0;  // Empty until the first miss
+    std::time_t midnight = 0;
+    char date[CivilDate::FORMATTED_SIZE + 1];
+};
+
+thread_local CachedDay cachedDay;
+thread_local size_t dayLookups = 0;
+
+/**
+ * Whether time renders on day's date with the given implied midnight, i.e.
+ * falls in the same span as the time day was looked up for
+ */
+bool sameSpan(std::time_t time, std::time_t midnight, const std::tm& day) {
+    std::tm tm = localTime(time);
+    return tm.tm_mday == day.tm_mday && tm.tm_mon == day.tm_mon && time - secondsOfDay(tm) == midnight;
+}
+
+void renderDigits(char* out, int value) {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+}
+
+size_t TimestampFormatter::format(std::time_t time, char* out) {
+    CachedDay& day = cachedDay;
+    if (time < day.start || time >= day.end) {
+        ++dayLookups;
+        std::tm tm = localTime(time);
+        CivilDate date{tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1), static_cast<unsigned>(tm.tm_mday)};
+        date.format(day.date);
+        day.date[CivilDate::FORMATTED_SIZE] = ' ';
+
+        // The span is the whole day unless a DST change falls on it; then the
+        // change, found by bisection, splits the day into two spans
+        std::time_t midnight = time - secondsOfDay(tm);
+        std::time_t first = midnight;
+        if (!sameSpan(first, midnight, tm)) {
+            std::time_t before = midnight;  // Outside the span; time is inside
+            first = time;
+            while (first - before > 1) {
+                std::time_t middle = before + (first - before) / 2;
+                if (sameSpan(middle, midnight, tm)) {
+                    first = middle;
+                } else {
+                    before = middle;
+                }
+            }
+        }
+        std::time_t last = midnight + 86399;
+        if (!sameSpan(last, midnight, tm)) {
+            std::time_t after = last;  // Outside the span; time is inside
+            last = time;
+            while (after - last > 1) {
+                std::time_t middle = last + (after - last) / 2;
+                if (sameSpan(middle, midnight, tm)) {
+                    last = middle;
+                } else {
+                    after = middle;
+                }
+            }
+        }
+        day.start = first;
+        day.end = last + 1;
+        day.midnight = midnight;
+    }
+
+    int seconds = static_cast<int>(time - day.midnight);
+    std::memcpy(out, day.date, sizeof(day.date));
+    char* clock = out + sizeof(day.date);
+    renderDigits(clock, seconds / 3600);
+    clock[2] = ':';
+    renderDigits(clock + 3, seconds / 60 % 60);
+    clock[5] = ':';
+    renderDigits(clock + 6, seconds % 60);
+    return FORMATTED_SIZE;
+}
+
+size_t TimestampFormatter::getDayLookups() {
+    return dayLookups;
+}
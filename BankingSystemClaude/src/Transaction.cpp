@@ -1,87 +1,177 @@
 #include "Transaction.h"
+#include "BinaryIO.h"
+#include "TimestampFormatter.h"
+#include <charconv>
 #include <ctime>
-#include <iostream>
+#include <sstream>
 #include <vector>
 
-Transaction::Transaction(Type t, double amt, double balance, const std::string& desc)
-    : type(t), amount(amt), balanceAfter(balance), 
-      timestamp(std::chrono::system_clock::now()), description(desc) {}
+namespace {
 
-std::string Transaction::toString() const {
-    std::stringstream ss;
-    
-    // Convert timestamp to readable format
-    std::time_t time = std::chrono::system_clock::to_time_t(timestamp);
-    char timeStr[100];
-    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
-    
-    // Format type
-    std::string typeStr;
-    switch(type) {
-        case Type::DEPOSIT:
-            typeStr = "DEPOSIT   ";
-            break;
-        case Type::WITHDRAWAL:
-            typeStr = "WITHDRAWAL";
-            break;
-        case Type::FD_OPEN:
-            typeStr = "FD OPEN   ";
-            break;
-        case Type::FD_MATURITY:
-            typeStr = "FD MATURITY";
-            break;
-        case Type::TRANSFER:
-            typeStr = "TRANSFER  ";
-            break;
+/**
+ * Intern a description read back as text. A transfer's "Transfer to 1002"
+ * splits into the fixed id and the counterparty, so loading statements does
+ * not add one table entry per counterparty.
+ */
+uint32_t internDescription(Transaction::Type type, std::string_view text, int& counterparty) {
+    counterparty = 0;
+    if (type == Transaction::Type::TRANSFER) {
+        int account;
+        if (TextScanner::parsePrefixed(text, "Transfer to ", account) && account > 0) {
+            counterparty = account;
+            return DescriptionTable::TRANSFER_TO;
+        }
+        if (TextScanner::parsePrefixed(text, "Transfer from ", account) && account > 0) {
+            counterparty = account;
+            return DescriptionTable::TRANSFER_FROM;
+        }
+    }
+    return DescriptionTable::intern(text);
+}
+
+}
+
+Transaction::Transaction(Type t, Money amt, Money balance, const std::string& desc)
+    : Transaction(t, amt, balance, desc, std::chrono::system_clock::now()) {}
+
+Transaction::Transaction(Type t, Money amt, Money balance, const std::string& desc,
+                         std::chrono::system_clock::time_point when)
+    : Transaction(t, amt, balance, DescriptionTable::NONE, when) {
+    int account;
+    descriptionId = internDescription(t, desc, account);
+    counterparty = account;
+}
+
+Transaction::Transaction(Type t, Money amt, Money balance, uint32_t descId,
+                         std::chrono::system_clock::time_point when, int counterparty)
+    : amount(amt), balanceAfter(balance), timestamp(when.time_since_epoch().count()),
+      descriptionId(descId), typeCode(static_cast<uint32_t>(t)), counterparty(counterparty) {}
+
+std::string Transaction::getDescription() const {
+    std::string text;
+    appendDescription(text);
+    return text;
+}
+
+void Transaction::appendDescription(std::string& out) const {
+    out += DescriptionTable::lookup(descriptionId);
+    if (counterparty != 0) {
+        char digits[12];
+        out += ' ';
+        out.append(digits, std::to_chars(digits, digits + sizeof(digits), counterparty).ptr);
     }
+}
+
+std::string Transaction::toString() const {
+    std::string text;
+    appendTo(text);
+    return text;
+}
+
+void Transaction::appendTo(std::string& out) const {
+    // Padded to a common width, except FD MATURITY which is one wider
+    static constexpr std::string_view typeLabels[TYPE_COUNT] = {
+        "DEPOSIT   ", "WITHDRAWAL", "FD OPEN   ", "FD MATURITY", "TRANSFER  "
+    };
     
-    ss << timeStr << " | " << typeStr << " | ₹" << std::fixed << std::setprecision(2) 
-       << amount << " | Balance: ₹" << balanceAfter;
+    char buffer[TimestampFormatter::FORMATTED_SIZE + Money::FORMATTED_MAX];
+    out.append(buffer, TimestampFormatter::format(getTimestamp(), buffer));
+    out += " | ";
+    out += typeLabels[typeCode];
+    out += " | ₹";
+    out.append(buffer, amount.format(buffer));
+    out += " | Balance: ₹";
+    out.append(buffer, balanceAfter.format(buffer));
     
-    if (!description.empty()) {
-        ss << " | " << description;
+    if (descriptionId != DescriptionTable::NONE) {
+        out += " | ";
+        appendDescription(out);
     }
-    
-    return ss.str();
 }
 
 std::string Transaction::serialize() const {
     std::stringstream ss;
     
     // Format: type|amount|balanceAfter|timestamp|description
-    ss << static_cast<int>(type) << "|"
+    ss << static_cast<int>(typeCode) << "|"
        << amount << "|"
        << balanceAfter << "|"
-       << std::chrono::system_clock::to_time_t(timestamp) << "|"
-       << description;
+       << std::chrono::system_clock::to_time_t(getTimestamp()) << "|"
+       << getDescription();
     
     return ss.str();
 }
 
 Transaction Transaction::deserialize(const std::string& data) {
-    std::stringstream ss(data);
-    std::string token;
-    std::vector<std::string> tokens;
-    
-    while (std::getline(ss, token, '|')) {
-        tokens.push_back(token);
+    Transaction trans(Type::DEPOSIT, Money(), Money(), DescriptionTable::NONE, std::chrono::system_clock::time_point());
+    ParseError error = parse(data, trans);
+    if (error != ParseError::NONE) {
+        throw std::runtime_error(std::string("Invalid transaction data: ") + parseErrorMessage(error));
     }
-    
-    if (tokens.size() < 4) {
-        throw std::runtime_error("Invalid transaction data");
+    return trans;
+}
+
+ParseError Transaction::parse(std::string_view data, Transaction& out) {
+    // Format: type|amount|balanceAfter|timestamp[|description]
+    TextScanner scanner(data);
+    std::string_view typeField = scanner.nextField();
+    std::string_view amountField = scanner.nextField();
+    std::string_view balanceField = scanner.nextField();
+    if (scanner.atEnd()) {
+        return ParseError::MISSING_FIELD;
     }
+    std::string_view timeField = scanner.nextField();
+    std::string_view descField = scanner.nextField();
     
-    Type type = static_cast<Type>(std::stoi(tokens[0]));
-    double amount = std::stod(tokens[1]);
-    double balanceAfter = std::stod(tokens[2]);
-    std::time_t time = std::stoll(tokens[3]);
-    std::string description = tokens.size() > 4 ? tokens[4] : "";
+    int rawType;
+    Money amount;
+    Money balanceAfter;
+    long long time;
+    if (!TextScanner::parseNumber(typeField, rawType) ||
+        !Money::parse(amountField, amount) ||
+        !Money::parse(balanceField, balanceAfter) ||
+        !TextScanner::parseNumber(timeField, time)) {
+        return ParseError::INVALID_NUMBER;
+    }
+    if (rawType < 0 || rawType > static_cast<int>(Type::TRANSFER)) {
+        return ParseError::INVALID_VALUE;
+    }
     
-    Transaction trans(type, amount, balanceAfter, description);
-    // Reconstruct timestamp
-    trans.timestamp = std::chrono::system_clock::from_time_t(time);
+    int counterparty;
+    uint32_t descId = internDescription(static_cast<Type>(rawType), descField, counterparty);
+    out = Transaction(static_cast<Type>(rawType), amount, balanceAfter, descId,
+                      std::chrono::system_clock::from_time_t(static_cast<std::time_t>(time)), counterparty);
     
-    return trans;
+    return ParseError::NONE;
+}
+
+void Transaction::serializeBinary(BinaryWriter& out) const {
+    // Format: u8 type | i64 amount | i64 balanceAfter | i64 ticks | u16 descLen | desc
+    std::string description = getDescription();
+    out.writeU8(static_cast<uint8_t>(typeCode));
+    out.writeMoney(amount);
+    out.writeMoney(balanceAfter);
+    out.writeI64(timestamp);
+    out.writeU16(static_cast<uint16_t>(description.size()));
+    out.writeBytes(description.data(), description.size());
+}
+
+Transaction Transaction::deserializeBinary(BinaryReader& in, AmountFormat amounts, TimestampFormat times) {
+    uint8_t rawType = in.readU8();
+    if (rawType > static_cast<uint8_t>(Type::TRANSFER)) {
+        throw std::runtime_error("Invalid transaction type");
+    }
+    Money amount = in.readMoney(amounts);
+    Money balanceAfter = in.readMoney(amounts);
+    int64_t rawTime = in.readI64();
+    auto time = times == TimestampFormat::TICKS
+        ? std::chrono::system_clock::time_point(std::chrono::system_clock::duration(rawTime))
+        : std::chrono::system_clock::from_time_t(static_cast<std::time_t>(rawTime));
+    uint16_t descLength = in.readU16();
+    int counterparty;
+    uint32_t descId = internDescription(static_cast<Type>(rawType), in.readString(descLength), counterparty);
+
+    return Transaction(static_cast<Type>(rawType), amount, balanceAfter, descId, time, counterparty);
 }
 
 std::string Transaction::typeToString(Type t) {
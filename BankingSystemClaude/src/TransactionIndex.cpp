@@ -0,0 +1,98 @@
+#include "TransactionIndex.h"
+#include <algorithm>
+
+namespace {
+
+unsigned lowestBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+    unsigned position = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        ++position;
+    }
+    return position;
+#endif
+}
+
+}
+
+void TransactionIndex::insertBit(std::vector<uint64_t>& words, size_t position, size_t bits, bool value) {
+    words.resize((bits + 1 + 63) / 64, 0);
+    size_t word = position / 64;
+
+    // Carry the top bit of each word into the next, from the end down
+    for (size_t w = words.size() - 1; w > word; --w) {
+        words[w] = (words[w] << 1) | (words[w - 1] >> 63);
+    }
+    uint64_t below = (uint64_t(1) << (position % 64)) - 1;
+    uint64_t current = words[word];
+    words[word] = (current & below) | ((current & ~below) << 1) | (uint64_t(value) << (position % 64));
+}
+
+void TransactionIndex::add(const Location& location, Transaction::Type type) {
+    size_t position = locations.size();
+    if (!locations.empty() && locations.back().timestamp > location.timestamp) {
+        position = static_cast<size_t>(std::upper_bound(locations.begin(), locations.end(), location.timestamp,
+            [](int64_t timestamp, const Location& other) { return timestamp < other.timestamp; })
+            - locations.begin());
+    }
+
+    for (size_t t = 0; t < Transaction::TYPE_COUNT; ++t) {
+        bool set = t == static_cast<size_t>(type);
+        if (position == locations.size()) {
+            typeBits[t].resize((position + 1 + 63) / 64, 0);
+            typeBits[t][position / 64] |= uint64_t(set) << (position % 64);
+        } else {
+            insertBit(typeBits[t], position, locations.size(), set);
+        }
+    }
+    locations.insert(locations.begin() + position, location);
+}
+
+std::vector<TransactionIndex::Location> TransactionIndex::slice(size_t first, size_t count) const {
+    if (first >= locations.size()) {
+        return {};
+    }
+    count = std::min(count, locations.size() - first);
+    return std::vector<Location>(locations.begin() + first, locations.begin() + first + count);
+}
+
+size_t TransactionIndex::lowerBound(std::chrono::system_clock::time_point when) const {
+    int64_t ticks = static_cast<int64_t>(when.time_since_epoch().count());
+    return static_cast<size_t>(std::lower_bound(locations.begin(), locations.end(), ticks,
+        [](const Location& location, int64_t bound) { return location.timestamp < bound; })
+        - locations.begin());
+}
+
+std::vector<TransactionIndex::Location> TransactionIndex::between(std::chrono::system_clock::time_point from,
+                                                                  std::chrono::system_clock::time_point to,
+                                                                  uint32_t typeMask) const {
+    size_t begin = lowerBound(from);
+    size_t end = std::max(begin, lowerBound(to));
+    std::vector<Location> result;
+    if ((typeMask & Transaction::ALL_TYPES) == Transaction::ALL_TYPES) {
+        return std::vector<Location>(locations.begin() + begin, locations.begin() + end);
+    }
+
+    // Walk the range a word at a time over the union of the wanted types' bitmaps
+    for (size_t word = begin / 64; begin < end && word <= (end - 1) / 64; ++word) {
+        uint64_t bits = 0;
+        for (size_t t = 0; t < Transaction::TYPE_COUNT; ++t) {
+            if (typeMask & Transaction::maskOf(static_cast<Transaction::Type>(t))) {
+                bits |= typeBits[t][word];
+            }
+        }
+        if (word == begin / 64) {
+            bits &= ~uint64_t(0) << (begin % 64);
+        }
+        if (word == (end - 1) / 64 && end % 64 != 0) {
+            bits &= (uint64_t(1) << (end % 64)) - 1;
+        }
+        for (; bits != 0; bits &= bits - 1) {
+            result.push_back(locations[word * 64 + lowestBit(bits)]);
+        }
+    }
+    return result;
+}
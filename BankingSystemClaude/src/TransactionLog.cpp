@@ -0,0 +1,353 @@
+#include "TransactionLog.h"
+#include "BinaryIO.h"
+#include "FileManager.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// Every segment starts with this; records follow as u32 length | i32 account | transaction
+const char SEGMENT_MAGIC[] = "TXNLOG03";
+const size_t SEGMENT_MAGIC_SIZE = sizeof(SEGMENT_MAGIC) - 1;
+
+// Segments written before timestamps were stored as clock ticks; still read
+const char SECONDS_SEGMENT_MAGIC[] = "TXNLOG02";
+// Segments written before amounts were stored as paise; still read
+const char LEGACY_SEGMENT_MAGIC[] = "TXNLOG01";
+
+/**
+ * Amount and timestamp formats of a segment's records from its magic
+ * @return false if the magic is not a known segment magic
+ */
+bool segmentFormat(std::string_view magic, AmountFormat& amounts, TimestampFormat& times) {
+    if (magic == std::string_view(SEGMENT_MAGIC, SEGMENT_MAGIC_SIZE)) {
+        amounts = AmountFormat::PAISE;
+        times = TimestampFormat::TICKS;
+        return true;
+    }
+    if (magic == std::string_view(SECONDS_SEGMENT_MAGIC, SEGMENT_MAGIC_SIZE)) {
+        amounts = AmountFormat::PAISE;
+        times = TimestampFormat::SECONDS;
+        return true;
+    }
+    if (magic == std::string_view(LEGACY_SEGMENT_MAGIC, SEGMENT_MAGIC_SIZE)) {
+        amounts = AmountFormat::RUPEES;
+        times = TimestampFormat::SECONDS;
+        return true;
+    }
+    return false;
+}
+
+// Account number plus the largest binary transaction (65535-byte description)
+const uint32_t MAX_RECORD_BYTES = 4 + 1 + 8 + 8 + 8 + 2 + 65535;
+
+// Every index file starts with this; older index files held whole-second
+// timestamps and no magic, and are rebuilt from their segments
+const char INDEX_MAGIC[] = "TXNIDX02";
+const size_t INDEX_MAGIC_SIZE = sizeof(INDEX_MAGIC) - 1;
+
+int64_t ticksOf(const Transaction& trans) {
+    return static_cast<int64_t>(trans.getTimestamp().time_since_epoch().count());
+}
+
+std::string segmentName(const std::string& name, uint32_t segment) {
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), ".%06u", segment);
+    return name + suffix;
+}
+
+std::string indexName(const std::string& name, uint32_t segment) {
+    return segmentName(name, segment) + ".idx";
+}
+
+}
+
+TransactionLog::TransactionLog(const std::string& logName, const std::string& dataDir, size_t segmentSize)
+    : name(logName), dataDirectory(dataDir), segmentBytes(segmentSize), activeSegment(0), activeSize(0),
+      records(0), segmentReads(0), failedAppends(0) {}
+
+TransactionLog::~TransactionLog() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stream.is_open()) {
+        stream.close();
+        writeIndex(activeSegment, activeEntries);
+    }
+}
+
+std::string TransactionLog::getSegmentPath(uint32_t segment) const {
+    return dataDirectory + "/" + segmentName(name, segment);
+}
+
+bool TransactionLog::open() {
+    FileManager fileManager(dataDirectory);
+    if (!fileManager.ensureDataDirectory()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    records = 0;
+
+    // Segments are numbered from 1 without gaps; sealed ones carry an index file
+    uint32_t segment = 1;
+    for (; fileManager.fileExists(segmentName(name, segment)); ++segment) {
+        bool indexed = fileManager.fileExists(indexName(name, segment)) && loadIndex(segment);
+        if (!indexed && !recoverSegment(segment)) {
+            return false;
+        }
+    }
+
+    activeSegment = segment - 1;
+    return roll();
+}
+
+bool TransactionLog::roll() {
+    if (stream.is_open()) {
+        stream.close();
+        if (!writeIndex(activeSegment, activeEntries)) {
+            return false;
+        }
+    }
+    activeEntries.clear();
+
+    ++activeSegment;
+    stream.clear();
+    stream.open(getSegmentPath(activeSegment), std::ios::out | std::ios::binary | std::ios::trunc);
+    stream.write(SEGMENT_MAGIC, SEGMENT_MAGIC_SIZE);
+    stream.flush();
+    activeSize = static_cast<uint32_t>(SEGMENT_MAGIC_SIZE);
+    return stream.good();
+}
+
+bool TransactionLog::writeIndex(uint32_t segment, const std::vector<IndexRecord>& entries) const {
+    // Format: magic | u32 count | { i32 account | u32 offset | i64 ticks | u8 type } * count
+    std::string data(INDEX_MAGIC, INDEX_MAGIC_SIZE);
+    BinaryWriter out(data);
+    out.writeU32(static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries) {
+        out.writeI32(entry.accountNumber);
+        out.writeU32(entry.location.offset);
+        out.writeI64(entry.location.timestamp);
+        out.writeU8(static_cast<uint8_t>(entry.type));
+    }
+
+    FileManager fileManager(dataDirectory);
+    return fileManager.writeToFile(indexName(name, segment), data);
+}
+
+bool TransactionLog::loadIndex(uint32_t segment) {
+    FileManager fileManager(dataDirectory);
+    std::string data = fileManager.readFromFile(indexName(name, segment));
+    std::vector<IndexRecord> entries;
+    if (data.compare(0, INDEX_MAGIC_SIZE, INDEX_MAGIC) != 0) {
+        return false;  // Older format; rebuilt from the segment itself
+    }
+
+    try {
+        BinaryReader in(data.data() + INDEX_MAGIC_SIZE, data.size() - INDEX_MAGIC_SIZE);
+        uint32_t count = in.readU32();
+        entries.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            IndexRecord entry;
+            entry.accountNumber = in.readI32();
+            entry.location.segment = segment;
+            entry.location.offset = in.readU32();
+            entry.location.timestamp = in.readI64();
+            uint8_t rawType = in.readU8();
+            if (rawType >= Transaction::TYPE_COUNT) {
+                return false;
+            }
+            entry.type = static_cast<Transaction::Type>(rawType);
+            entries.push_back(entry);
+        }
+        if (in.remaining() != 0) {
+            return false;
+        }
+    } catch (const std::exception&) {
+        return false;  // Rebuilt from the segment itself
+    }
+
+    for (const auto& entry : entries) {
+        addToIndex(entry);
+    }
+    return true;
+}
+
+bool TransactionLog::recoverSegment(uint32_t segment) {
+    FileManager::MappedFile file(getSegmentPath(segment));
+    std::string_view data = file.isOpen() ? file.view() : std::string_view();
+    std::vector<IndexRecord> entries;
+
+    // Keep every complete record; stop at the first torn or corrupt one
+    AmountFormat amounts;
+    TimestampFormat times;
+    if (segmentFormat(data.substr(0, SEGMENT_MAGIC_SIZE), amounts, times)) {
+        size_t offset = SEGMENT_MAGIC_SIZE;
+        try {
+            while (offset + sizeof(uint32_t) <= data.size()) {
+                BinaryReader prefix(data.data() + offset, sizeof(uint32_t));
+                uint32_t length = prefix.readU32();
+                if (length > data.size() - offset - sizeof(uint32_t)) {
+                    break;
+                }
+
+                BinaryReader record(data.data() + offset + sizeof(uint32_t), length);
+                IndexRecord entry;
+                entry.accountNumber = record.readI32();
+                Transaction trans = Transaction::deserializeBinary(record, amounts, times);
+                entry.location.segment = segment;
+                entry.location.offset = static_cast<uint32_t>(offset);
+                entry.location.timestamp = ticksOf(trans);
+                entry.type = trans.getType();
+                entries.push_back(entry);
+                offset += sizeof(uint32_t) + length;
+            }
+        } catch (const std::exception&) {
+            // Records after a corrupt one cannot be located reliably
+        }
+    }
+
+    for (const auto& entry : entries) {
+        addToIndex(entry);
+    }
+    return writeIndex(segment, entries);
+}
+
+void TransactionLog::addToIndex(const IndexRecord& record) {
+    index[record.accountNumber].add(record.location, record.type);
+    ++records;
+}
+
+bool TransactionLog::append(int accountNumber, const Transaction& trans) {
+    std::string data;
+    BinaryWriter out(data);
+    out.writeU32(0);
+    out.writeI32(accountNumber);
+    trans.serializeBinary(out);
+    out.patchU32(0, static_cast<uint32_t>(data.size() - sizeof(uint32_t)));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!stream.is_open() ||
+        (activeSize > SEGMENT_MAGIC_SIZE && activeSize + data.size() > segmentBytes && !roll())) {
+        ++failedAppends;
+        return false;
+    }
+
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+    stream.flush();
+    if (!stream.good()) {
+        ++failedAppends;
+        return false;
+    }
+
+    IndexRecord entry;
+    entry.accountNumber = accountNumber;
+    entry.location.segment = activeSegment;
+    entry.location.offset = activeSize;
+    entry.location.timestamp = ticksOf(trans);
+    entry.type = trans.getType();
+    activeEntries.push_back(entry);
+    addToIndex(entry);
+    activeSize += static_cast<uint32_t>(data.size());
+    return true;
+}
+
+std::vector<Transaction> TransactionLog::readAt(const std::vector<Location>& locations) const {
+    std::vector<Transaction> result;
+    result.reserve(locations.size());
+    std::ifstream file;
+    uint32_t openSegment = 0;
+    AmountFormat amounts = AmountFormat::PAISE;
+    TimestampFormat times = TimestampFormat::TICKS;
+    std::string data;
+
+    for (const Location& location : locations) {
+        if (location.segment != openSegment) {
+            file.close();
+            file.clear();
+            file.open(getSegmentPath(location.segment), std::ios::in | std::ios::binary);
+            openSegment = location.segment;
+            ++segmentReads;
+
+            char magic[SEGMENT_MAGIC_SIZE];
+            if (!file.read(magic, SEGMENT_MAGIC_SIZE) ||
+                !segmentFormat(std::string_view(magic, SEGMENT_MAGIC_SIZE), amounts, times)) {
+                file.clear();
+                amounts = AmountFormat::PAISE;
+                times = TimestampFormat::TICKS;
+            }
+        }
+
+        uint32_t length = 0;
+        file.seekg(location.offset);
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+        if (!file || length > MAX_RECORD_BYTES) {
+            file.clear();
+            continue;
+        }
+        data.resize(length);
+        file.read(&data[0], length);
+        if (!file) {
+            file.clear();
+            continue;
+        }
+
+        try {
+            BinaryReader record(data.data(), data.size());
+            record.readI32();
+            result.push_back(Transaction::deserializeBinary(record, amounts, times));
+        } catch (const std::exception&) {
+            // Skip a damaged record rather than failing the whole query
+        }
+    }
+    return result;
+}
+
+size_t TransactionLog::count(int accountNumber) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(accountNumber);
+    return it == index.end() ? 0 : it->second.size();
+}
+
+std::vector<Transaction> TransactionLog::readPage(int accountNumber, size_t first, size_t limit) const {
+    std::vector<Location> locations;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(accountNumber);
+        if (it == index.end()) {
+            return {};
+        }
+        locations = it->second.slice(first, limit);
+    }
+    return readAt(locations);
+}
+
+std::vector<Transaction> TransactionLog::readRange(int accountNumber, std::chrono::system_clock::time_point from,
+                                                   std::chrono::system_clock::time_point to,
+                                                   uint32_t typeMask) const {
+    std::vector<Location> locations;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(accountNumber);
+        if (it == index.end()) {
+            return {};
+        }
+        locations = it->second.between(from, to, typeMask);
+    }
+    return readAt(locations);
+}
+
+size_t TransactionLog::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return records;
+}
+
+size_t TransactionLog::getSegmentCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return activeSegment;
+}
+
+bool TransactionLog::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stream.is_open();
+}
@@ -2,6 +2,19 @@
 #include <limits>
 #include <memory>
 #include "BankManager.h"
+#include "ConsoleView.h"
+
+namespace {
+const char* const DATA_FILE = "accounts.dat";
+const char* const JOURNAL_FILE = "accounts.journal";
+// Full history beyond the last five transactions, in data/accounts.txlog.NNNNNN
+const char* const TRANSACTION_LOG = "accounts.txlog";
+const size_t HISTORY_PAGE = 10;
+// Binary snapshots carry the account index used by lazy loading
+const BankManager::SnapshotFormat DATA_FORMAT = BankManager::SnapshotFormat::BINARY;
+// accounts.dat holds the manifest; accounts live in accounts.dat.shard0..3
+const size_t DATA_SHARDS = 4;
+}
 
 void clearScreen() {
     #ifdef _WIN32
@@ -17,40 +30,48 @@ void pause() {
     std::cin.get();
 }
 
-void displayMainMenu() {
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "           🏦 WELCOME TO SECURE BANK 🏦" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
-    std::cout << "1. Create New Account" << std::endl;
-    std::cout << "2. Login to Existing Account" << std::endl;
-    std::cout << "3. Exit" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
-    std::cout << "Enter your choice: ";
+/**
+ * Show problems BankManager collected since the last call (failed saves,
+ * skipped records, ...)
+ */
+void showDiagnostics(BankManager* bank, const ConsoleView& view) {
+    view.showDiagnostics(bank->takeDiagnostics());
 }
 
-void displayAccountMenu(const std::string& accountHolder) {
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "           ACCOUNT MENU - " << accountHolder << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
-    std::cout << "1. Deposit Money" << std::endl;
-    std::cout << "2. Withdraw Money" << std::endl;
-    std::cout << "3. Balance Enquiry" << std::endl;
-    std::cout << "4. Account Details" << std::endl;
-    std::cout << "5. Transaction History" << std::endl;
-    std::cout << "6. Open Fixed Deposit" << std::endl;
-    std::cout << "7. View Fixed Deposits" << std::endl;
-    std::cout << "8. Logout" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
-    std::cout << "Enter your choice: ";
+/**
+ * Page through the account's full history, starting with the newest page
+ */
+void showHistoryPages(const Account& account, const ConsoleView& view) {
+    size_t total = account.getTransactionCount();
+    size_t first = total > HISTORY_PAGE ? (total - 1) / HISTORY_PAGE * HISTORY_PAGE : 0;
+    
+    while (true) {
+        view.showTransactionPage(account, first, HISTORY_PAGE);
+        std::cout << "\n[P]revious  [N]ext  [B]ack: ";
+        
+        char key;
+        std::cin >> key;
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            return;
+        }
+        
+        if ((key == 'p' || key == 'P') && first > 0) {
+            first -= HISTORY_PAGE;
+        } else if ((key == 'n' || key == 'N') && first + HISTORY_PAGE < account.getTransactionCount()) {
+            first += HISTORY_PAGE;
+        } else if (key == 'b' || key == 'B') {
+            return;
+        }
+    }
 }
 
-void handleCreateAccount(BankManager* bank) {
+void handleCreateAccount(BankManager* bank, const ConsoleView& view) {
     std::string name, password;
-    double initialBalance;
+    Money initialBalance;
     
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "           CREATE NEW ACCOUNT" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
+    view.showHeading("CREATE NEW ACCOUNT");
     
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     
@@ -66,20 +87,20 @@ void handleCreateAccount(BankManager* bank) {
     if (std::cin.fail()) {
         std::cin.clear();
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        std::cout << "❌ Invalid amount!" << std::endl;
+        view.showError("Invalid amount");
         return;
     }
     
-    bank->createAccount(name, password, initialBalance);
+    BankResult result;
+    int accountNumber = bank->createAccount(name, password, initialBalance, &result);
+    view.showAccountCreated(result, accountNumber, name, initialBalance);
 }
 
-void handleLogin(BankManager* bank) {
+void handleLogin(BankManager* bank, const ConsoleView& view) {
     int accountNumber;
     std::string password;
     
-    std::cout << "\n" << std::string(60, '=') << std::endl;
-    std::cout << "           LOGIN" << std::endl;
-    std::cout << std::string(60, '=') << std::endl;
+    view.showHeading("LOGIN");
     
     std::cout << "Enter account number: ";
     std::cin >> accountNumber;
@@ -87,7 +108,7 @@ void handleLogin(BankManager* bank) {
     if (std::cin.fail()) {
         std::cin.clear();
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        std::cout << "❌ Invalid account number!" << std::endl;
+        view.showError("Invalid account number");
         return;
     }
     
@@ -95,18 +116,23 @@ void handleLogin(BankManager* bank) {
     std::cout << "Enter password: ";
     std::getline(std::cin, password);
     
-    auto account = bank->login(accountNumber, password);
+    BankResult result;
+    auto account = bank->login(accountNumber, password, &result);
+    view.showLogin(result, account.get());
     
     if (account == nullptr) {
         pause();
         return;
     }
     
+    // Logging in materializes the account, which schedules its FDs
+    view.showMaturedDeposits(bank->creditMaturedDeposits());
+    
     // Account menu loop
     bool loggedIn = true;
     while (loggedIn) {
         clearScreen();
-        displayAccountMenu(account->getAccountHolderName());
+        view.showAccountMenu(account->getAccountHolderName());
         
         int choice;
         std::cin >> choice;
@@ -114,65 +140,62 @@ void handleLogin(BankManager* bank) {
         if (std::cin.fail()) {
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "❌ Invalid choice!" << std::endl;
+            view.showError("Invalid choice");
             pause();
             continue;
         }
         
         switch (choice) {
             case 1: {
-                double amount;
+                Money amount;
                 std::cout << "\nEnter deposit amount: ₹";
                 std::cin >> amount;
                 
                 if (std::cin.fail()) {
                     std::cin.clear();
                     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                    std::cout << "❌ Invalid amount!" << std::endl;
+                    view.showError("Invalid amount");
                 } else {
-                    account->deposit(amount);
+                    view.showDeposit(account->deposit(amount), amount, *account);
+                    bank->checkpointIfDue(DATA_FILE, DATA_FORMAT);
+                    showDiagnostics(bank, view);
                 }
                 pause();
                 break;
             }
             case 2: {
-                double amount;
+                Money amount;
                 std::cout << "\nEnter withdrawal amount: ₹";
                 std::cin >> amount;
                 
                 if (std::cin.fail()) {
                     std::cin.clear();
                     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                    std::cout << "❌ Invalid amount!" << std::endl;
+                    view.showError("Invalid amount");
                 } else {
-                    account->withdraw(amount);
+                    view.showWithdrawal(account->withdraw(amount), amount, *account);
+                    bank->checkpointIfDue(DATA_FILE, DATA_FORMAT);
+                    showDiagnostics(bank, view);
                 }
                 pause();
                 break;
             }
             case 3:
-                account->displayBalance();
+                view.showBalance(*account);
                 pause();
                 break;
             case 4:
-                account->displayAccountDetails();
+                view.showAccountDetails(*account);
                 pause();
                 break;
             case 5:
-                account->displayTransactionHistory();
-                pause();
+                showHistoryPages(*account, view);
                 break;
             case 6: {
-                double amount;
+                Money amount;
                 int tenure;
                 
-                std::cout << "\n" << std::string(50, '=') << std::endl;
-                std::cout << "OPEN FIXED DEPOSIT" << std::endl;
-                std::cout << std::string(50, '=') << std::endl;
-                std::cout << "Interest Rates:" << std::endl;
-                std::cout << "  12 months - 6.5% p.a." << std::endl;
-                std::cout << "  24 months - 7.5% p.a." << std::endl;
-                std::cout << std::string(50, '=') << std::endl;
+                view.showFixedDepositRates();
                 
                 std::cout << "Enter FD amount: ₹";
                 std::cin >> amount;
@@ -180,7 +203,7 @@ void handleLogin(BankManager* bank) {
                 if (std::cin.fail()) {
                     std::cin.clear();
                     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                    std::cout << "❌ Invalid amount!" << std::endl;
+                    view.showError("Invalid amount");
                     pause();
                     break;
                 }
@@ -191,24 +214,49 @@ void handleLogin(BankManager* bank) {
                 if (std::cin.fail()) {
                     std::cin.clear();
                     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                    std::cout << "❌ Invalid tenure!" << std::endl;
+                    view.showError("Invalid tenure");
                 } else {
-                    account->openFixedDeposit(amount, tenure);
+                    view.showFixedDepositOpened(account->openFixedDeposit(amount, tenure), *account);
+                    bank->checkpointIfDue(DATA_FILE, DATA_FORMAT);
+                    showDiagnostics(bank, view);
                 }
                 pause();
                 break;
             }
             case 7:
-                account->displayFixedDeposits();
+                view.showFixedDeposits(*account);
+                pause();
+                break;
+            case 8: {
+                int target;
+                Money amount;
+                std::cout << "\nEnter destination account number: ";
+                std::cin >> target;
+                if (!std::cin.fail()) {
+                    std::cout << "Enter transfer amount: ₹";
+                    std::cin >> amount;
+                }
+                
+                if (std::cin.fail()) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    view.showError("Invalid input");
+                } else {
+                    TransferResult result = bank->transfer(account->getAccountNumber(), target, amount);
+                    view.showTransfer(result, amount, target, *account);
+                    bank->checkpointIfDue(DATA_FILE, DATA_FORMAT);
+                    showDiagnostics(bank, view);
+                }
                 pause();
                 break;
-            case 8:
+            }
+            case 9:
                 std::cout << "\n👋 Logging out..." << std::endl;
                 loggedIn = false;
                 pause();
                 break;
             default:
-                std::cout << "❌ Invalid choice! Please try again." << std::endl;
+                view.showError("Invalid choice! Please try again");
                 pause();
         }
     }
@@ -217,14 +265,25 @@ void handleLogin(BankManager* bank) {
 int main() {
     BankManager* bank = BankManager::getInstance();
     
-    // Load existing data
-    bank->loadFromFile("accounts.dat");
+    // Operations are journaled as they happen; loading replays the journal
+    // tail on top of the last checkpointed snapshot. Accounts are only
+    // deserialized when first used.
+    bank->setLoadMode(BankManager::LoadMode::LAZY);
+    bank->setShardCount(DATA_SHARDS);
+    bank->setBackgroundSnapshots(true);  // Periodic checkpoints no longer block the menu
+    bank->enableJournal(JOURNAL_FILE);
+    bank->enableTransactionLog(TRANSACTION_LOG);  // Before loading, so replay is not logged twice
+    ConsoleView view;
+    bank->loadFromFile(DATA_FILE);
+    showDiagnostics(bank, view);
+    view.showLoadStats(bank->getLastLoadStats());
+    view.showMaturedDeposits(bank->creditMaturedDeposits());
     
     bool running = true;
     
     while (running) {
         clearScreen();
-        displayMainMenu();
+        view.showMainMenu();
         
         int choice;
         std::cin >> choice;
@@ -232,31 +291,31 @@ int main() {
         if (std::cin.fail()) {
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "❌ Invalid choice!" << std::endl;
+            view.showError("Invalid choice");
             pause();
             continue;
         }
         
         switch (choice) {
             case 1:
-                handleCreateAccount(bank);
-                bank->saveToFile("accounts.dat");
+                handleCreateAccount(bank, view);
+                bank->checkpointIfDue(DATA_FILE, DATA_FORMAT);
+                showDiagnostics(bank, view);
                 pause();
                 break;
             case 2:
-                handleLogin(bank);
-                bank->saveToFile("accounts.dat");
+                handleLogin(bank, view);
                 break;
             case 3:
-                std::cout << "\n" << std::string(60, '=') << std::endl;
-                std::cout << "Thank you for banking with Secure Bank!" << std::endl;
-                std::cout << "Have a great day! 👋" << std::endl;
-                std::cout << std::string(60, '=') << std::endl;
-                bank->saveToFile("accounts.dat");
+                view.showGoodbye();
+                if (bank->checkpoint(DATA_FILE, DATA_FORMAT)) {
+                    view.showSaveStats(bank->getLastSaveStats());
+                }
+                showDiagnostics(bank, view);
                 running = false;
                 break;
             default:
-                std::cout << "❌ Invalid choice! Please try again." << std::endl;
+                view.showError("Invalid choice! Please try again");
                 pause();
         }
     }
@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
 #include "Account.h"
+#include "BinaryIO.h"
+#include "FileManager.h"
 
 class AccountTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        testAccount = std::make_shared<Account>(1001, "John Doe", "password123", 1000.0);
+        testAccount = std::make_shared<Account>(1001, "John Doe", "password123", Money::rupees(1000));
     }
 
     void TearDown() override {
@@ -18,7 +20,7 @@ protected:
 TEST_F(AccountTest, AccountCreation) {
     EXPECT_EQ(testAccount->getAccountNumber(), 1001);
     EXPECT_EQ(testAccount->getAccountHolderName(), "John Doe");
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1000.0);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
 }
 
 // Test password verification
@@ -29,56 +31,117 @@ TEST_F(AccountTest, PasswordVerification) {
 
 // Test deposit with positive amount
 TEST_F(AccountTest, DepositPositiveAmount) {
-    EXPECT_TRUE(testAccount->deposit(500.0));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1500.0);
+    EXPECT_EQ(testAccount->deposit(Money::rupees(500)), OperationResult::OK);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1500));
 }
 
 // Test deposit with negative amount
 TEST_F(AccountTest, DepositNegativeAmount) {
-    EXPECT_FALSE(testAccount->deposit(-100.0));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1000.0);
+    EXPECT_EQ(testAccount->deposit(Money::rupees(-100)), OperationResult::INVALID_AMOUNT);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
 }
 
 // Test deposit with zero amount
 TEST_F(AccountTest, DepositZeroAmount) {
-    EXPECT_FALSE(testAccount->deposit(0.0));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1000.0);
+    EXPECT_EQ(testAccount->deposit(Money::rupees(0)), OperationResult::INVALID_AMOUNT);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
 }
 
 // Test withdrawal with sufficient balance
 TEST_F(AccountTest, WithdrawSufficientBalance) {
-    EXPECT_TRUE(testAccount->withdraw(300.0));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 700.0);
+    EXPECT_EQ(testAccount->withdraw(Money::rupees(300)), OperationResult::OK);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(700));
 }
 
 // Test withdrawal with insufficient balance
 TEST_F(AccountTest, WithdrawInsufficientBalance) {
-    EXPECT_FALSE(testAccount->withdraw(1500.0));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1000.0);
+    EXPECT_EQ(testAccount->withdraw(Money::rupees(1500)), OperationResult::INSUFFICIENT_BALANCE);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
 }
 
 // Test withdrawal with negative amount
 TEST_F(AccountTest, WithdrawNegativeAmount) {
-    EXPECT_FALSE(testAccount->withdraw(-100.0));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1000.0);
+    EXPECT_EQ(testAccount->withdraw(Money::rupees(-100)), OperationResult::INVALID_AMOUNT);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
+}
+
+// Test async deposit/withdraw apply immediately and report through the future
+TEST_F(AccountTest, AsyncOperationsWithoutJournal) {
+    EXPECT_TRUE(testAccount->depositAsync(Money::rupees(500)).get());
+    EXPECT_TRUE(testAccount->withdrawAsync(Money::rupees(300)).get());
+    EXPECT_FALSE(testAccount->depositAsync(Money::rupees(-10)).get());
+    EXPECT_FALSE(testAccount->withdrawAsync(Money::rupees(5000)).get());
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1200));
+}
+
+// Test async operations are journaled durably
+TEST_F(AccountTest, AsyncOperationsAreJournaled) {
+    FileManager fileManager("test_data");
+    fileManager.deleteFile("test_async.journal");
+    {
+        Journal journal("test_async.journal", "test_data");
+        ASSERT_TRUE(journal.open());
+        testAccount->setJournal(&journal);
+        
+        std::future<bool> first = testAccount->depositAsync(Money::rupees(250));
+        std::future<bool> second = testAccount->withdrawAsync(Money::rupees(50));
+        EXPECT_TRUE(first.get());
+        EXPECT_TRUE(second.get());
+        
+        std::vector<JournalEntry> entries = journal.readEntries();
+        ASSERT_EQ(entries.size(), 2u);
+        EXPECT_EQ(entries[0].operation, JournalEntry::Operation::DEPOSIT);
+        EXPECT_EQ(entries[1].operation, JournalEntry::Operation::WITHDRAWAL);
+        testAccount->setJournal(nullptr);
+    }
+    fileManager.deleteFile("test_async.journal");
+}
+
+// Test transfer moves money and records a TRANSFER transaction on both sides
+TEST_F(AccountTest, TransferBetweenAccounts) {
+    Account other(1002, "Jane Doe", "password456", Money::rupees(500));
+    
+    EXPECT_EQ(Account::transfer(*testAccount, other, Money::rupees(300)), TransferResult::OK);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(700));
+    EXPECT_EQ(other.getBalance(), Money::rupees(800));
+    
+    const Transaction& sent = testAccount->getTransactionHistory().back();
+    const Transaction& received = other.getTransactionHistory().back();
+    EXPECT_EQ(sent.getType(), Transaction::Type::TRANSFER);
+    EXPECT_EQ(received.getType(), Transaction::Type::TRANSFER);
+    EXPECT_EQ(sent.getDescription(), "Transfer to 1002");
+    EXPECT_EQ(received.getDescription(), "Transfer from 1001");
+    EXPECT_EQ(sent.getCounterparty(), 1002);
+    EXPECT_EQ(received.getDescriptionId(), static_cast<uint32_t>(DescriptionTable::TRANSFER_FROM));
+}
+
+// Test rejected transfers leave both balances unchanged
+TEST_F(AccountTest, TransferRejected) {
+    Account other(1002, "Jane Doe", "password456", Money::rupees(500));
+    
+    EXPECT_EQ(Account::transfer(*testAccount, other, Money::rupees(5000)), TransferResult::INSUFFICIENT_BALANCE);
+    EXPECT_EQ(Account::transfer(*testAccount, other, Money::rupees(-10)), TransferResult::INVALID_AMOUNT);
+    EXPECT_EQ(Account::transfer(*testAccount, *testAccount, Money::rupees(10)), TransferResult::SAME_ACCOUNT);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
+    EXPECT_EQ(other.getBalance(), Money::rupees(500));
 }
 
 // Test multiple transactions
 TEST_F(AccountTest, MultipleTransactions) {
-    testAccount->deposit(500.0);
-    testAccount->withdraw(200.0);
-    testAccount->deposit(300.0);
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1600.0);
+    testAccount->deposit(Money::rupees(500));
+    testAccount->withdraw(Money::rupees(200));
+    testAccount->deposit(Money::rupees(300));
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1600));
 }
 
 // Test transaction history limit (max 5)
 TEST_F(AccountTest, TransactionHistoryLimit) {
-    testAccount->deposit(100.0);
-    testAccount->deposit(100.0);
-    testAccount->deposit(100.0);
-    testAccount->deposit(100.0);
-    testAccount->deposit(100.0);
-    testAccount->deposit(100.0); // 6th transaction
+    testAccount->deposit(Money::rupees(100));
+    testAccount->deposit(Money::rupees(100));
+    testAccount->deposit(Money::rupees(100));
+    testAccount->deposit(Money::rupees(100));
+    testAccount->deposit(Money::rupees(100));
+    testAccount->deposit(Money::rupees(100)); // 6th transaction
     
     // Should have only 5 transactions (excluding initial deposit)
     EXPECT_EQ(testAccount->getTransactionHistory().size(), 5);
@@ -86,63 +149,120 @@ TEST_F(AccountTest, TransactionHistoryLimit) {
 
 // Test opening FD with valid parameters
 TEST_F(AccountTest, OpenFixedDeposit12Months) {
-    EXPECT_TRUE(testAccount->openFixedDeposit(500.0, 12));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 500.0);
+    EXPECT_EQ(testAccount->openFixedDeposit(Money::rupees(500), 12), OperationResult::OK);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(500));
     EXPECT_EQ(testAccount->getFixedDeposits().size(), 1);
 }
 
 TEST_F(AccountTest, OpenFixedDeposit24Months) {
-    EXPECT_TRUE(testAccount->openFixedDeposit(500.0, 24));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 500.0);
+    EXPECT_EQ(testAccount->openFixedDeposit(Money::rupees(500), 24), OperationResult::OK);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(500));
     EXPECT_EQ(testAccount->getFixedDeposits().size(), 1);
 }
 
 // Test opening FD with invalid tenure
 TEST_F(AccountTest, OpenFixedDepositInvalidTenure) {
-    EXPECT_FALSE(testAccount->openFixedDeposit(500.0, 18));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1000.0);
+    EXPECT_EQ(testAccount->openFixedDeposit(Money::rupees(500), 18), OperationResult::INVALID_TENURE);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
     EXPECT_EQ(testAccount->getFixedDeposits().size(), 0);
 }
 
 // Test opening FD with insufficient balance
 TEST_F(AccountTest, OpenFixedDepositInsufficientBalance) {
-    EXPECT_FALSE(testAccount->openFixedDeposit(1500.0, 12));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1000.0);
+    EXPECT_EQ(testAccount->openFixedDeposit(Money::rupees(1500), 12), OperationResult::INSUFFICIENT_BALANCE);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
     EXPECT_EQ(testAccount->getFixedDeposits().size(), 0);
 }
 
 // Test opening FD with negative amount
 TEST_F(AccountTest, OpenFixedDepositNegativeAmount) {
-    EXPECT_FALSE(testAccount->openFixedDeposit(-500.0, 12));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 1000.0);
+    EXPECT_EQ(testAccount->openFixedDeposit(Money::rupees(-500), 12), OperationResult::INVALID_AMOUNT);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(1000));
 }
 
 // Test multiple FDs
 TEST_F(AccountTest, OpenMultipleFixedDeposits) {
-    EXPECT_TRUE(testAccount->openFixedDeposit(300.0, 12));
-    EXPECT_TRUE(testAccount->openFixedDeposit(200.0, 24));
-    EXPECT_DOUBLE_EQ(testAccount->getBalance(), 500.0);
+    EXPECT_EQ(testAccount->openFixedDeposit(Money::rupees(300), 12), OperationResult::OK);
+    EXPECT_EQ(testAccount->openFixedDeposit(Money::rupees(200), 24), OperationResult::OK);
+    EXPECT_EQ(testAccount->getBalance(), Money::rupees(500));
     EXPECT_EQ(testAccount->getFixedDeposits().size(), 2);
 }
 
 // Test account with negative initial balance
 TEST(AccountCreationTest, NegativeInitialBalance) {
     EXPECT_THROW({
-        Account account(1002, "Jane Doe", "pass", -100.0);
+        Account account(1002, "Jane Doe", "pass", Money::rupees(-100));
     }, std::invalid_argument);
 }
 
 // Test serialization and deserialization
 TEST_F(AccountTest, SerializationDeserialization) {
-    testAccount->deposit(500.0);
-    testAccount->withdraw(200.0);
-    testAccount->openFixedDeposit(300.0, 12);
+    testAccount->deposit(Money::rupees(500));
+    testAccount->withdraw(Money::rupees(200));
+    testAccount->openFixedDeposit(Money::rupees(300), 12);
     
     std::string serialized = testAccount->serialize();
     auto deserializedAccount = Account::deserialize(serialized);
     
     EXPECT_EQ(deserializedAccount->getAccountNumber(), testAccount->getAccountNumber());
     EXPECT_EQ(deserializedAccount->getAccountHolderName(), testAccount->getAccountHolderName());
-    EXPECT_DOUBLE_EQ(deserializedAccount->getBalance(), testAccount->getBalance());
+    EXPECT_EQ(deserializedAccount->getBalance(), testAccount->getBalance());
     EXPECT_EQ(deserializedAccount->getFixedDeposits().size(), testAccount->getFixedDeposits().size());
 }
+
+// Test binary serialization round trip
+TEST_F(AccountTest, BinarySerializationRoundTrip) {
+    testAccount->deposit(Money::rupees(500));
+    testAccount->withdraw(Money::rupees(200));
+    testAccount->openFixedDeposit(Money::rupees(300), 24);
+    
+    std::string buffer;
+    BinaryWriter writer(buffer);
+    testAccount->serializeBinary(writer);
+    
+    BinaryReader reader(buffer.data(), buffer.size());
+    auto restored = Account::deserializeBinary(reader);
+    
+    EXPECT_EQ(reader.remaining(), 0u);
+    EXPECT_EQ(restored->getAccountNumber(), testAccount->getAccountNumber());
+    EXPECT_EQ(restored->getAccountHolderName(), testAccount->getAccountHolderName());
+    EXPECT_EQ(restored->getBalance(), testAccount->getBalance());
+    EXPECT_TRUE(restored->verifyPassword("password123"));
+    ASSERT_EQ(restored->getTransactionHistory().size(), testAccount->getTransactionHistory().size());
+    EXPECT_EQ(restored->getTransactionHistory().back().getDescription(), "FD opened for 24 months");
+    ASSERT_EQ(restored->getFixedDeposits().size(), 1u);
+    EXPECT_EQ(restored->getFixedDeposits()[0]->getTenure(), 24);
+}
+
+// Test truncated binary record is rejected
+TEST_F(AccountTest, BinaryDeserializationTruncated) {
+    std::string buffer;
+    BinaryWriter writer(buffer);
+    testAccount->serializeBinary(writer);
+    buffer.resize(buffer.size() / 2);
+    
+    BinaryReader reader(buffer.data(), buffer.size());
+    EXPECT_THROW(Account::deserializeBinary(reader), std::runtime_error);
+}
+
+// Test allocation-free parser reports errors instead of throwing
+TEST(AccountParseTest, ParseReportsErrors) {
+    std::shared_ptr<Account> account;
+    EXPECT_EQ(Account::parse("1001|Name|hash\n", account), ParseError::MISSING_FIELD);
+    EXPECT_EQ(Account::parse("abc|Name|hash|100\n", account), ParseError::INVALID_NUMBER);
+    EXPECT_EQ(Account::parse("1001|Name|hash|100\nTRANSACTIONS:1\n9|1|1|0|x\n", account),
+              ParseError::INVALID_VALUE);
+    EXPECT_EQ(account, nullptr);
+    EXPECT_THROW(Account::deserialize("1001|Name|hash\n"), std::runtime_error);
+}
+
+// Test parser reads the same data as the serializer writes
+TEST_F(AccountTest, ParseSerializedAccount) {
+    testAccount->withdraw(Money::fromRupees(250.5));
+    testAccount->openFixedDeposit(Money::rupees(100), 12);
+    
+    std::shared_ptr<Account> parsed;
+    ASSERT_EQ(Account::parse(testAccount->serialize(), parsed), ParseError::NONE);
+    EXPECT_EQ(parsed->serialize(), testAccount->serialize());
+    EXPECT_TRUE(parsed->verifyPassword("password123"));
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "AccountColumns.h"
+#include "Account.h"
+
+class AccountColumnsTest : public ::testing::Test {
+protected:
+    AccountColumns columns;
+};
+
+// Test rows follow attach, publish and release
+TEST_F(AccountColumnsTest, AttachPublishRelease) {
+    AccountColumns::Cell first = columns.attach(1001, Money::rupees(100), Money(), 0);
+    AccountColumns::Cell second = columns.attach(1002, Money::rupees(250), Money::rupees(500), 1);
+    EXPECT_EQ(columns.size(), 2u);
+    EXPECT_EQ(columns.totalBalance(), Money::rupees(350));
+    EXPECT_EQ(columns.totalFdPrincipal(), Money::rupees(500));
+
+    AccountColumns::publish(first, Money::rupees(40), Money(), 0);
+    EXPECT_EQ(columns.totalBalance(), Money::rupees(290));
+
+    // A released row no longer counts and is handed out again
+    columns.release(second);
+    EXPECT_EQ(columns.size(), 1u);
+    EXPECT_EQ(columns.totalBalance(), Money::rupees(40));
+    EXPECT_EQ(columns.totalFdPrincipal(), Money::rupees(0));
+    EXPECT_EQ(columns.attach(1003, Money::rupees(1), Money(), 0).index, second.index);
+}
+
+// Test summary extremes and histogram across several chunks
+TEST_F(AccountColumnsTest, SummarizeAcrossChunks) {
+    size_t rows = AccountColumns::CHUNK_ROWS * 2 + 10;
+    for (size_t i = 0; i < rows; ++i) {
+        columns.attach(static_cast<int>(1001 + i), Money::rupees(static_cast<int64_t>(i)), Money(), 0);
+    }
+
+    BalanceSummary summary = columns.summarize({Money::rupees(100), Money::rupees(1000)});
+    EXPECT_EQ(summary.accounts, rows);
+    EXPECT_EQ(summary.totalBalance, Money::rupees(static_cast<int64_t>(rows * (rows - 1) / 2)));
+    EXPECT_EQ(summary.minBalance, Money::rupees(0));
+    EXPECT_EQ(summary.maxBalance, Money::rupees(static_cast<int64_t>(rows - 1)));
+    ASSERT_EQ(summary.bucketCounts.size(), 3u);
+    EXPECT_EQ(summary.bucketCounts[0], 100u);
+    EXPECT_EQ(summary.bucketCounts[1], 900u);
+    EXPECT_EQ(summary.bucketCounts[2], rows - 1000);
+}
+
+// Test rows of account number 0 or below count as accounts; only released rows are skipped
+TEST_F(AccountColumnsTest, SummarizeAnyAccountNumber) {
+    columns.attach(0, Money::rupees(70), Money(), 0);
+    columns.attach(-5, Money::rupees(30), Money(), 0);
+    columns.release(columns.attach(1001, Money::rupees(500), Money(), 0));
+
+    BalanceSummary summary = columns.summarize();
+    EXPECT_EQ(summary.accounts, 2u);
+    EXPECT_EQ(summary.totalBalance, Money::rupees(100));
+    EXPECT_EQ(summary.minBalance, Money::rupees(30));
+    EXPECT_EQ(summary.maxBalance, Money::rupees(70));
+}
+
+// Test an attached account publishes every change, and stops after detaching
+TEST_F(AccountColumnsTest, AccountPublishesChanges) {
+    Account account(1001, "John Doe", "password123", Money::rupees(1000));
+    account.attachColumns(&columns);
+    EXPECT_EQ(columns.totalBalance(), Money::rupees(1000));
+
+    account.deposit(Money::rupees(500));
+    account.openFixedDeposit(Money::rupees(300), 12);
+    BalanceSummary summary = columns.summarize();
+    EXPECT_EQ(summary.totalBalance, Money::rupees(1200));
+    EXPECT_EQ(summary.totalFdPrincipal, Money::rupees(300));
+    EXPECT_EQ(summary.fixedDeposits, 1u);
+
+    account.detachColumns(&columns);
+    account.deposit(Money::rupees(100));
+    EXPECT_EQ(columns.size(), 0u);
+    EXPECT_EQ(columns.totalBalance(), Money::rupees(0));
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "AccountStore.h"
+#include <thread>
+#include <vector>
+
+class AccountStoreTest : public ::testing::Test {
+protected:
+    static std::shared_ptr<Account> makeAccount(int accNum) {
+        return std::make_shared<Account>(accNum, "Holder", "password", Money::rupees(1000));
+    }
+
+    AccountStore store{4};
+};
+
+// Test find returns inserted accounts and nullptr for unknown numbers
+TEST_F(AccountStoreTest, FindInsertedAccount) {
+    store.assign(1001, makeAccount(1001));
+    
+    ASSERT_NE(store.find(1001), nullptr);
+    EXPECT_EQ(store.find(1001)->getAccountNumber(), 1001);
+    EXPECT_EQ(store.find(1002), nullptr);
+    EXPECT_TRUE(store.contains(1001));
+    EXPECT_FALSE(store.contains(1002));
+    EXPECT_EQ(store.size(), 1u);
+}
+
+// Test insert keeps the account already stored, while assign replaces it
+TEST_F(AccountStoreTest, InsertKeepsExistingAccount) {
+    auto first = makeAccount(1001);
+    store.assign(1001, first);
+    
+    auto second = makeAccount(1001);
+    EXPECT_FALSE(store.insert(1001, second));
+    EXPECT_EQ(second, first);
+    
+    store.assign(1001, makeAccount(1001));
+    EXPECT_NE(store.find(1001), first);
+    EXPECT_EQ(store.size(), 1u);
+}
+
+// Test sorted returns accounts from every stripe in account-number order
+TEST_F(AccountStoreTest, SortedAcrossStripes) {
+    for (int accNum : {1007, 1001, 1004, 1002, 1010}) {
+        store.assign(accNum, makeAccount(accNum));
+    }
+    
+    std::vector<AccountStore::Entry> all = store.sorted();
+    ASSERT_EQ(all.size(), 5u);
+    for (size_t i = 1; i < all.size(); ++i) {
+        EXPECT_LT(all[i - 1].first, all[i].first);
+    }
+    
+    std::vector<AccountStore::Entry> even = store.sorted([](int accNum) { return accNum % 2 == 0; });
+    ASSERT_EQ(even.size(), 3u);
+    EXPECT_EQ(even[0].first, 1002);
+    EXPECT_EQ(even[2].first, 1010);
+    
+    store.clear();
+    EXPECT_TRUE(store.empty());
+}
+
+// Test concurrent inserts and operations from several threads
+TEST_F(AccountStoreTest, ConcurrentInsertAndDeposit) {
+    const int threads = 8;
+    const int perThread = 200;
+    
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([this, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                int accNum = 1000 + t * perThread + i;
+                store.assign(accNum, makeAccount(accNum));
+                store.find(accNum)->depositAsync(Money::rupees(1)).get();
+                // Every thread also hammers one shared account
+                auto shared = makeAccount(1);
+                store.insert(1, shared);
+                shared->depositAsync(Money::rupees(1)).get();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    EXPECT_EQ(store.size(), static_cast<size_t>(threads * perThread + 1));
+    EXPECT_EQ(store.find(1)->getBalance(), Money::rupees(1000 + threads * perThread));
+    EXPECT_EQ(store.find(1000)->getBalance(), Money::rupees(1001));
+}
+
+// Test erased accounts leave tombstones and far-away numbers use the sparse fallback
+TEST_F(AccountStoreTest, DenseTableWithSparseFallback) {
+    AccountStore dense(4, 1001);
+    for (int accNum = 1001; accNum <= 1100; ++accNum) {
+        dense.assign(accNum, makeAccount(accNum));
+    }
+    EXPECT_EQ(dense.sparseSize(), 0u);
+    
+    // Tombstone: the number disappears, its neighbours are unaffected, and it can be reused
+    EXPECT_TRUE(dense.erase(1050));
+    EXPECT_FALSE(dense.erase(1050));
+    EXPECT_FALSE(dense.contains(1050));
+    EXPECT_EQ(dense.find(1050), nullptr);
+    EXPECT_EQ(dense.find(1051)->getAccountNumber(), 1051);
+    EXPECT_EQ(dense.size(), 99u);
+    
+    // Imported numbers below the base or far past the end go to the sparse maps
+    int farAway = 1001 + 4 * static_cast<int>(AccountStore::MAX_DENSE_GAP) * 2;
+    dense.assign(7, makeAccount(7));
+    dense.assign(farAway, makeAccount(farAway));
+    EXPECT_EQ(dense.sparseSize(), 2u);
+    EXPECT_EQ(dense.find(farAway)->getAccountNumber(), farAway);
+    EXPECT_EQ(dense.find(7)->getAccountNumber(), 7);
+    
+    std::vector<AccountStore::Entry> all = dense.sorted();
+    ASSERT_EQ(all.size(), 101u);
+    EXPECT_EQ(all.front().first, 7);
+    EXPECT_EQ(all.back().first, farAway);
+    
+    // Sequential growth eventually covers the far-away number and absorbs it
+    int last = farAway + 4;
+    for (int accNum = 1101; accNum <= last; ++accNum) {
+        if (accNum != farAway) {
+            dense.assign(accNum, makeAccount(accNum));
+        }
+    }
+    EXPECT_EQ(dense.sparseSize(), 1u);
+    EXPECT_EQ(dense.find(farAway)->getAccountNumber(), farAway);
+    EXPECT_EQ(dense.size(), static_cast<size_t>(last - 1001 + 1));  // 1050 erased, 7 added
+}
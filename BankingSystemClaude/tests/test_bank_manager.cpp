@@ -1,5 +1,14 @@
 #include <gtest/gtest.h>
 #include "BankManager.h"
+#include "BinaryIO.h"
+#include "FileManager.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 class BankManagerTest : public ::testing::Test {
 protected:
@@ -24,60 +33,214 @@ TEST_F(BankManagerTest, SingletonPattern) {
 
 // Test account creation
 TEST_F(BankManagerTest, CreateAccount) {
-    int accNum = bankManager->createAccount("Alice", "password", 1000.0);
+    int accNum = bankManager->createAccount("Alice", "password", Money::rupees(1000));
     EXPECT_GE(accNum, 1001);
     EXPECT_TRUE(bankManager->accountExists(accNum));
 }
 
+// Test concurrent account creation hands out distinct numbers and operations run in parallel
+TEST_F(BankManagerTest, ConcurrentCreateAndOperate) {
+    const int threads = 4;
+    const int perThread = 25;
+    std::vector<std::vector<int>> created(threads);
+    
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([this, t, &created]() {
+            for (int i = 0; i < perThread; ++i) {
+                int accNum = bankManager->createAccount("Holder", "password", Money::rupees(100));
+                created[t].push_back(accNum);
+                bankManager->getAccount(accNum)->depositAsync(Money::rupees(50)).get();
+                bankManager->getAccount(accNum)->withdrawAsync(Money::rupees(25)).get();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    std::set<int> numbers;
+    for (const auto& list : created) {
+        numbers.insert(list.begin(), list.end());
+    }
+    EXPECT_EQ(numbers.size(), static_cast<size_t>(threads * perThread));
+    EXPECT_EQ(bankManager->getAccountCount(), static_cast<size_t>(threads * perThread));
+    for (int accNum : numbers) {
+        EXPECT_EQ(bankManager->getAccount(accNum)->getBalance(), Money::rupees(125));
+    }
+}
+
+// Test opposing concurrent transfers neither deadlock nor lose money
+TEST_F(BankManagerTest, ConcurrentOpposingTransfers) {
+    int acc1 = bankManager->createAccount("Alice", "pass1234", Money::rupees(10000));
+    int acc2 = bankManager->createAccount("Bob", "pass5678", Money::rupees(10000));
+    
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        int from = (t % 2 == 0) ? acc1 : acc2;
+        int to = (t % 2 == 0) ? acc2 : acc1;
+        workers.emplace_back([this, from, to]() {
+            for (int i = 0; i < 500; ++i) {
+                bankManager->transfer(from, to, Money::rupees(1));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    Money total = bankManager->getAccount(acc1)->getBalance() + bankManager->getAccount(acc2)->getBalance();
+    EXPECT_EQ(total, Money::rupees(20000));
+    EXPECT_EQ(bankManager->transfer(acc1, 99999, Money::rupees(1)), TransferResult::ACCOUNT_NOT_FOUND);
+    EXPECT_EQ(bankManager->transfer(acc1, acc1, Money::rupees(1)), TransferResult::SAME_ACCOUNT);
+}
+
+// Test batch operations apply per account in input order and report each result
+TEST_F(BankManagerTest, ApplyBatchInOrder) {
+    int acc1 = bankManager->createAccount("Alice", "pass1234", Money::rupees(100));
+    int acc2 = bankManager->createAccount("Bob", "pass5678", Money::rupees(100));
+    
+    std::vector<BatchOperation> operations = {
+        {BatchOperation::Type::DEPOSIT, acc1, Money::rupees(50)},
+        {BatchOperation::Type::WITHDRAWAL, acc2, Money::rupees(500)},   // Insufficient
+        {BatchOperation::Type::WITHDRAWAL, acc1, Money::rupees(150)},   // Only covered by the deposit above
+        {BatchOperation::Type::DEPOSIT, 99999, Money::rupees(10)},
+        {BatchOperation::Type::DEPOSIT, acc2, Money::rupees(-5)},
+    };
+    BatchReport report = bankManager->applyBatch(operations);
+    
+    ASSERT_EQ(report.results.size(), 5u);
+    EXPECT_EQ(report.results[0], BatchResult::OK);
+    EXPECT_EQ(report.results[1], BatchResult::INSUFFICIENT_BALANCE);
+    EXPECT_EQ(report.results[2], BatchResult::OK);
+    EXPECT_EQ(report.results[3], BatchResult::ACCOUNT_NOT_FOUND);
+    EXPECT_EQ(report.results[4], BatchResult::INVALID_AMOUNT);
+    EXPECT_EQ(report.applied, 2u);
+    EXPECT_EQ(report.rejected, 3u);
+    EXPECT_EQ(report.accounts, 3u);
+    EXPECT_EQ(bankManager->getAccount(acc1)->getBalance(), Money::rupees(0));
+    EXPECT_EQ(bankManager->getAccount(acc2)->getBalance(), Money::rupees(100));
+}
+
+// Test CSV batches skip the header and blank lines and flag malformed lines
+TEST_F(BankManagerTest, ApplyBatchCsv) {
+    int acc = bankManager->createAccount("Alice", "pass1234", Money::rupees(100));
+    std::string id = std::to_string(acc);
+    std::stringstream csv("type,account,amount\r\n"
+                          "DEPOSIT," + id + ",25.5\r\n"
+                          "\n"
+                          "W," + id + ",10\n"
+                          "TRANSFER," + id + ",10\n"
+                          "D," + id + "\n");
+    
+    BatchReport report = bankManager->applyBatch(csv);
+    ASSERT_EQ(report.results.size(), 4u);
+    EXPECT_EQ(report.results[0], BatchResult::OK);
+    EXPECT_EQ(report.results[1], BatchResult::OK);
+    EXPECT_EQ(report.results[2], BatchResult::PARSE_ERROR);
+    EXPECT_EQ(report.results[3], BatchResult::PARSE_ERROR);
+    EXPECT_EQ(bankManager->getAccount(acc)->getBalance(), Money::fromRupees(115.5));
+}
+
+// Test a large batch on the worker pool matches sequential results and is journaled
+TEST_F(BankManagerTest, ApplyBatchParallelJournaled) {
+    FileManager fileManager;
+    fileManager.deleteFile("test_batch.journal");
+    fileManager.deleteFile("test_batch.dat");
+    ASSERT_TRUE(bankManager->enableJournal("test_batch.journal"));
+    bankManager->setLoadThreads(4);
+    
+    std::vector<int> numbers;
+    for (int i = 0; i < 20; ++i) {
+        numbers.push_back(bankManager->createAccount("Holder", "password", Money::rupees(1000)));
+    }
+    EXPECT_TRUE(bankManager->checkpoint("test_batch.dat"));
+    
+    std::vector<BatchOperation> operations;
+    std::map<int, Money> expected;
+    for (int i = 0; i < 4000; ++i) {
+        BatchOperation::Type type = (i % 3 == 0) ? BatchOperation::Type::WITHDRAWAL : BatchOperation::Type::DEPOSIT;
+        int accNum = numbers[i % numbers.size()];
+        operations.push_back({type, accNum, Money::rupees(1)});
+        expected[accNum] += (type == BatchOperation::Type::DEPOSIT) ? Money::rupees(1) : Money::rupees(-1);
+    }
+    BatchReport report = bankManager->applyBatch(operations);
+    EXPECT_EQ(report.applied, operations.size());
+    EXPECT_GT(report.threads, 1u);
+    
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_batch.journal"));
+    ASSERT_TRUE(recovered->loadFromFile("test_batch.dat"));
+    for (int accNum : numbers) {
+        EXPECT_EQ(recovered->getAccount(accNum)->getBalance(), Money::rupees(1000) + expected[accNum]);
+    }
+    
+    fileManager.deleteFile("test_batch.journal");
+    fileManager.deleteFile("test_batch.dat");
+}
+
 // Test account creation with empty name
 TEST_F(BankManagerTest, CreateAccountEmptyName) {
-    int accNum = bankManager->createAccount("", "password", 1000.0);
+    BankResult result;
+    int accNum = bankManager->createAccount("", "password", Money::rupees(1000), &result);
     EXPECT_EQ(accNum, -1);
+    EXPECT_EQ(result, BankResult::EMPTY_NAME);
 }
 
 // Test account creation with short password
 TEST_F(BankManagerTest, CreateAccountShortPassword) {
-    int accNum = bankManager->createAccount("Bob", "123", 1000.0);
+    BankResult result;
+    int accNum = bankManager->createAccount("Bob", "123", Money::rupees(1000), &result);
     EXPECT_EQ(accNum, -1);
+    EXPECT_EQ(result, BankResult::SHORT_PASSWORD);
 }
 
 // Test account creation with negative balance
 TEST_F(BankManagerTest, CreateAccountNegativeBalance) {
-    int accNum = bankManager->createAccount("Charlie", "password", -100.0);
+    BankResult result;
+    int accNum = bankManager->createAccount("Charlie", "password", Money::rupees(-100), &result);
     EXPECT_EQ(accNum, -1);
+    EXPECT_EQ(result, BankResult::NEGATIVE_BALANCE);
 }
 
 // Test sequential account numbers
 TEST_F(BankManagerTest, SequentialAccountNumbers) {
-    int acc1 = bankManager->createAccount("Alice", "pass1234", 1000.0);
-    int acc2 = bankManager->createAccount("Bob", "pass1234", 2000.0);
+    int acc1 = bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
+    int acc2 = bankManager->createAccount("Bob", "pass1234", Money::rupees(2000));
     EXPECT_EQ(acc2, acc1 + 1);
 }
 
 // Test successful login
 TEST_F(BankManagerTest, SuccessfulLogin) {
-    int accNum = bankManager->createAccount("Dave", "password123", 1500.0);
-    auto account = bankManager->login(accNum, "password123");
-    EXPECT_NE(account, nullptr);
+    int accNum = bankManager->createAccount("Dave", "password123", Money::rupees(1500));
+    BankResult result;
+    auto account = bankManager->login(accNum, "password123", &result);
+    EXPECT_EQ(result, BankResult::OK);
+    ASSERT_NE(account, nullptr);
     EXPECT_EQ(account->getAccountNumber(), accNum);
 }
 
 // Test login with wrong password
 TEST_F(BankManagerTest, LoginWrongPassword) {
-    int accNum = bankManager->createAccount("Eve", "password123", 1500.0);
-    auto account = bankManager->login(accNum, "wrongpassword");
+    int accNum = bankManager->createAccount("Eve", "password123", Money::rupees(1500));
+    BankResult result;
+    auto account = bankManager->login(accNum, "wrongpassword", &result);
     EXPECT_EQ(account, nullptr);
+    EXPECT_EQ(result, BankResult::INVALID_PASSWORD);
 }
 
 // Test login with non-existent account
 TEST_F(BankManagerTest, LoginNonExistentAccount) {
-    auto account = bankManager->login(9999, "password");
+    BankResult result;
+    auto account = bankManager->login(9999, "password", &result);
     EXPECT_EQ(account, nullptr);
+    EXPECT_EQ(result, BankResult::ACCOUNT_NOT_FOUND);
 }
 
 // Test getAccount method
 TEST_F(BankManagerTest, GetAccount) {
-    int accNum = bankManager->createAccount("Frank", "password123", 2000.0);
+    int accNum = bankManager->createAccount("Frank", "password123", Money::rupees(2000));
     auto account = bankManager->getAccount(accNum);
     EXPECT_NE(account, nullptr);
     EXPECT_EQ(account->getAccountNumber(), accNum);
@@ -85,7 +248,7 @@ TEST_F(BankManagerTest, GetAccount) {
 
 // Test accountExists method
 TEST_F(BankManagerTest, AccountExists) {
-    int accNum = bankManager->createAccount("Grace", "password123", 3000.0);
+    int accNum = bankManager->createAccount("Grace", "password123", Money::rupees(3000));
     EXPECT_TRUE(bankManager->accountExists(accNum));
     EXPECT_FALSE(bankManager->accountExists(9999));
 }
@@ -93,17 +256,17 @@ TEST_F(BankManagerTest, AccountExists) {
 // Test account count
 TEST_F(BankManagerTest, AccountCount) {
     EXPECT_EQ(bankManager->getAccountCount(), 0);
-    bankManager->createAccount("Alice", "pass1234", 1000.0);
+    bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
     EXPECT_EQ(bankManager->getAccountCount(), 1);
-    bankManager->createAccount("Bob", "pass1234", 2000.0);
+    bankManager->createAccount("Bob", "pass1234", Money::rupees(2000));
     EXPECT_EQ(bankManager->getAccountCount(), 2);
 }
 
 // Test multiple account creation
 TEST_F(BankManagerTest, MultipleAccounts) {
-    int acc1 = bankManager->createAccount("User1", "pass1234", 1000.0);
-    int acc2 = bankManager->createAccount("User2", "pass1234", 2000.0);
-    int acc3 = bankManager->createAccount("User3", "pass1234", 3000.0);
+    int acc1 = bankManager->createAccount("User1", "pass1234", Money::rupees(1000));
+    int acc2 = bankManager->createAccount("User2", "pass1234", Money::rupees(2000));
+    int acc3 = bankManager->createAccount("User3", "pass1234", Money::rupees(3000));
     
     EXPECT_TRUE(bankManager->accountExists(acc1));
     EXPECT_TRUE(bankManager->accountExists(acc2));
@@ -114,12 +277,12 @@ TEST_F(BankManagerTest, MultipleAccounts) {
 // Test save and load functionality
 TEST_F(BankManagerTest, SaveAndLoad) {
     // Create accounts
-    int acc1 = bankManager->createAccount("Alice", "pass1234", 1000.0);
-    int acc2 = bankManager->createAccount("Bob", "pass5678", 2000.0);
+    int acc1 = bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
+    int acc2 = bankManager->createAccount("Bob", "pass5678", Money::rupees(2000));
     
     // Perform some operations
     auto account1 = bankManager->getAccount(acc1);
-    account1->deposit(500.0);
+    account1->deposit(Money::rupees(500));
     
     // Save to file
     EXPECT_TRUE(bankManager->saveToFile("test_accounts.dat"));
@@ -138,12 +301,12 @@ TEST_F(BankManagerTest, SaveAndLoad) {
     
     auto loadedAccount = newBankManager->getAccount(acc1);
     EXPECT_NE(loadedAccount, nullptr);
-    EXPECT_DOUBLE_EQ(loadedAccount->getBalance(), 1500.0);
+    EXPECT_EQ(loadedAccount->getBalance(), Money::rupees(1500));
 }
 
 // Test login after save and load
 TEST_F(BankManagerTest, LoginAfterSaveLoad) {
-    int accNum = bankManager->createAccount("Charlie", "mypassword", 3000.0);
+    int accNum = bankManager->createAccount("Charlie", "mypassword", Money::rupees(3000));
     
     bankManager->saveToFile("test_login.dat");
     
@@ -160,12 +323,13 @@ TEST_F(BankManagerTest, LoginAfterSaveLoad) {
 TEST_F(BankManagerTest, LoadNonExistentFile) {
     EXPECT_TRUE(bankManager->loadFromFile("nonexistent_file.dat"));
     EXPECT_EQ(bankManager->getAccountCount(), 0);
+    EXPECT_FALSE(bankManager->getLastLoadStats().fileFound);
 }
 
 // Test next account number preservation
 TEST_F(BankManagerTest, NextAccountNumberPreservation) {
-    bankManager->createAccount("User1", "pass1234", 1000.0);
-    int lastAccNum = bankManager->createAccount("User2", "pass1234", 2000.0);
+    bankManager->createAccount("User1", "pass1234", Money::rupees(1000));
+    int lastAccNum = bankManager->createAccount("User2", "pass1234", Money::rupees(2000));
     
     bankManager->saveToFile("test_acc_num.dat");
     
@@ -173,6 +337,764 @@ TEST_F(BankManagerTest, NextAccountNumberPreservation) {
     BankManager* newBankManager = BankManager::getInstance();
     newBankManager->loadFromFile("test_acc_num.dat");
     
-    int newAccNum = newBankManager->createAccount("User3", "pass1234", 3000.0);
+    int newAccNum = newBankManager->createAccount("User3", "pass1234", Money::rupees(3000));
     EXPECT_GT(newAccNum, lastAccNum);
 }
+
+// Test save and load with the binary snapshot format
+TEST_F(BankManagerTest, SaveAndLoadBinary) {
+    int acc1 = bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
+    int acc2 = bankManager->createAccount("Bob", "pass5678", Money::rupees(2000));
+    bankManager->getAccount(acc1)->deposit(Money::rupees(500));
+    bankManager->getAccount(acc2)->openFixedDeposit(Money::rupees(1500), 12);
+    
+    EXPECT_TRUE(bankManager->saveToFile("test_binary.dat", BankManager::SnapshotFormat::BINARY));
+    
+    BankManager::resetInstance();
+    BankManager* newBankManager = BankManager::getInstance();
+    EXPECT_TRUE(newBankManager->loadFromFile("test_binary.dat"));
+    
+    EXPECT_EQ(newBankManager->getAccountCount(), 2);
+    EXPECT_EQ(newBankManager->getNextAccountNumber(), acc2 + 1);
+    EXPECT_EQ(newBankManager->getAccount(acc1)->getBalance(), Money::rupees(1500));
+    EXPECT_EQ(newBankManager->getAccount(acc2)->getBalance(), Money::rupees(500));
+    EXPECT_EQ(newBankManager->getAccount(acc2)->getFixedDeposits().size(), 1);
+    EXPECT_NE(newBankManager->login(acc2, "pass5678"), nullptr);
+}
+
+// Test format detection and conversion between text and binary
+TEST_F(BankManagerTest, ConvertSnapshot) {
+    int accNum = bankManager->createAccount("Carol", "pass1234", Money::rupees(750));
+    bankManager->saveToFile("test_convert.txt");
+    
+    EXPECT_TRUE(BankManager::convertSnapshot("test_convert.txt", "test_convert.bin",
+                                             BankManager::SnapshotFormat::BINARY));
+    EXPECT_TRUE(BankManager::convertSnapshot("test_convert.bin", "test_convert_back.txt",
+                                             BankManager::SnapshotFormat::TEXT));
+    
+    FileManager fileManager;
+    EXPECT_EQ(BankManager::detectFormat(fileManager.readFromFile("test_convert.bin")),
+              BankManager::SnapshotFormat::BINARY);
+    EXPECT_EQ(fileManager.readFromFile("test_convert_back.txt"),
+              fileManager.readFromFile("test_convert.txt"));
+    
+    BankManager::resetInstance();
+    BankManager* newBankManager = BankManager::getInstance();
+    EXPECT_TRUE(newBankManager->loadFromFile("test_convert.bin"));
+    EXPECT_EQ(newBankManager->getAccount(accNum)->getBalance(), Money::rupees(750));
+}
+
+// Test corrupt binary snapshot is rejected
+TEST_F(BankManagerTest, LoadCorruptBinarySnapshot) {
+    bankManager->createAccount("Dave", "pass1234", Money::rupees(100));
+    bankManager->saveToFile("test_corrupt.bin", BankManager::SnapshotFormat::BINARY);
+    
+    FileManager fileManager;
+    std::string data = fileManager.readFromFile("test_corrupt.bin");
+    fileManager.writeToFile("test_corrupt.bin", data.substr(0, data.size() / 2));
+    
+    BankManager::resetInstance();
+    EXPECT_FALSE(BankManager::getInstance()->loadFromFile("test_corrupt.bin"));
+    
+    // The failure is reported through diagnostics rather than printed
+    std::vector<std::string> diagnostics = BankManager::getInstance()->takeDiagnostics();
+    EXPECT_FALSE(diagnostics.empty());
+    EXPECT_TRUE(BankManager::getInstance()->takeDiagnostics().empty());
+    
+    // A lazy load relies on the trailer, so cutting it off is detected as well
+    fileManager.writeToFile("test_corrupt.bin", data.substr(0, data.size() - 8));
+    BankManager::resetInstance();
+    BankManager::getInstance()->setLoadMode(BankManager::LoadMode::LAZY);
+    EXPECT_FALSE(BankManager::getInstance()->loadFromFile("test_corrupt.bin"));
+}
+
+// Test binary snapshots from before version 4 (f64 rupee amounts, whole-second times) still load and are rewritten
+TEST_F(BankManagerTest, LoadRupeeBinarySnapshot) {
+    // Version 2 layout: header with checkpoint LSN, no index
+    std::string data;
+    BinaryWriter out(data);
+    out.writeBytes("BANKSNAP", 8);
+    out.writeU32(2);
+    out.writeI32(1002);
+    out.writeI64(1);
+    out.writeI64(0);
+    size_t recordStart = out.position();
+    out.writeU32(0);
+    out.writeI32(1001);
+    out.writeF64(1234.56);
+    out.writeU32(1);
+    out.writeU32(1);
+    out.writeU16(5);
+    out.writeU16(4);
+    out.writeBytes("Alice", 5);
+    out.writeBytes("hash", 4);
+    out.writeU32(1 + 8 + 8 + 8 + 2 + 12);
+    out.writeU8(static_cast<uint8_t>(Transaction::Type::DEPOSIT));
+    out.writeF64(1234.56);
+    out.writeF64(1234.56);
+    out.writeI64(1700000000);
+    out.writeU16(12);
+    out.writeBytes("Cash deposit", 12);
+    out.writeU32(28);
+    out.writeF64(5000.25);
+    out.writeI32(12);
+    out.writeF64(6.5);
+    out.writeI64(1700000000);
+    out.patchU32(recordStart, static_cast<uint32_t>(out.position() - recordStart - 4));
+    
+    FileManager fileManager;
+    ASSERT_TRUE(fileManager.writeToFile("test_rupees.bin", data));
+    
+    ASSERT_TRUE(bankManager->loadFromFile("test_rupees.bin"));
+    auto account = bankManager->getAccount(1001);
+    ASSERT_NE(account, nullptr);
+    EXPECT_EQ(account->getBalance(), Money::fromPaise(123456));
+    EXPECT_EQ(account->getTransactionHistory().back().getAmount(), Money::fromPaise(123456));
+    EXPECT_EQ(account->getFixedDeposits().front()->getPrincipal(), Money::fromPaise(500025));
+    
+    // Saved before the account is materialized, the record is re-encoded rather than copied through
+    BankManager::resetInstance();
+    BankManager* lazy = BankManager::getInstance();
+    lazy->setLoadMode(BankManager::LoadMode::LAZY);
+    ASSERT_TRUE(lazy->loadFromFile("test_rupees.bin"));
+    ASSERT_TRUE(lazy->saveToFile("test_paise.bin", BankManager::SnapshotFormat::BINARY));
+    
+    std::string saved = fileManager.readFromFile("test_paise.bin");
+    BinaryReader header(saved.data(), saved.size());
+    header.skip(8);
+    EXPECT_EQ(header.readU32(), 5u);
+    
+    BankManager::resetInstance();
+    BankManager* reloaded = BankManager::getInstance();
+    ASSERT_TRUE(reloaded->loadFromFile("test_paise.bin"));
+    EXPECT_EQ(reloaded->getAccount(1001)->getBalance(), Money::fromPaise(123456));
+    EXPECT_EQ(reloaded->getAccount(1001)->getFixedDeposits().front()->getPrincipal(), Money::fromPaise(500025));
+    EXPECT_EQ(reloaded->getAccount(1001)->getTransactionHistory().back().getTimestamp(),
+              std::chrono::system_clock::from_time_t(1700000000));
+    
+    fileManager.deleteFile("test_rupees.bin");
+    fileManager.deleteFile("test_paise.bin");
+}
+
+// Test a journaled transfer is replayed on both accounts
+TEST_F(BankManagerTest, TransferJournalRecovery) {
+    FileManager fileManager;
+    fileManager.deleteFile("test_transfer.journal");
+    fileManager.deleteFile("test_transfer.dat");
+    
+    ASSERT_TRUE(bankManager->enableJournal("test_transfer.journal"));
+    int acc1 = bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
+    int acc2 = bankManager->createAccount("Bob", "pass5678", Money::rupees(500));
+    EXPECT_TRUE(bankManager->checkpoint("test_transfer.dat"));
+    EXPECT_EQ(bankManager->transfer(acc1, acc2, Money::rupees(400)), TransferResult::OK);
+    
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_transfer.journal"));
+    ASSERT_TRUE(recovered->loadFromFile("test_transfer.dat"));
+    
+    EXPECT_EQ(recovered->getAccount(acc1)->getBalance(), Money::rupees(600));
+    EXPECT_EQ(recovered->getAccount(acc2)->getBalance(), Money::rupees(900));
+    EXPECT_EQ(recovered->getAccount(acc2)->getTransactionHistory().back().getType(),
+              Transaction::Type::TRANSFER);
+    
+    fileManager.deleteFile("test_transfer.journal");
+    fileManager.deleteFile("test_transfer.dat");
+}
+
+// Test recovery replays journaled operations on top of the last snapshot
+TEST_F(BankManagerTest, JournalRecovery) {
+    FileManager fileManager;
+    fileManager.deleteFile("test_recovery.journal");
+    fileManager.deleteFile("test_recovery.dat");
+    
+    ASSERT_TRUE(bankManager->enableJournal("test_recovery.journal"));
+    int acc1 = bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
+    bankManager->getAccount(acc1)->deposit(Money::rupees(500));
+    EXPECT_TRUE(bankManager->checkpoint("test_recovery.dat"));
+    
+    // Operations after the checkpoint exist only in the journal
+    int acc2 = bankManager->createAccount("Bob", "pass5678", Money::rupees(2000));
+    bankManager->getAccount(acc1)->withdraw(Money::rupees(200));
+    bankManager->getAccount(acc2)->openFixedDeposit(Money::rupees(1000), 24);
+    
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_recovery.journal"));
+    ASSERT_TRUE(recovered->loadFromFile("test_recovery.dat"));
+    
+    EXPECT_EQ(recovered->getAccountCount(), 2);
+    EXPECT_EQ(recovered->getNextAccountNumber(), acc2 + 1);
+    EXPECT_EQ(recovered->getAccount(acc1)->getBalance(), Money::rupees(1300));
+    EXPECT_EQ(recovered->getAccount(acc2)->getBalance(), Money::rupees(1000));
+    EXPECT_EQ(recovered->getAccount(acc2)->getFixedDeposits().size(), 1);
+    EXPECT_NE(recovered->login(acc2, "pass5678"), nullptr);
+    
+    fileManager.deleteFile("test_recovery.journal");
+    fileManager.deleteFile("test_recovery.dat");
+}
+
+// Test entries already folded into a snapshot are not applied twice
+TEST_F(BankManagerTest, JournalNotReplayedTwice) {
+    FileManager fileManager;
+    fileManager.deleteFile("test_twice.journal");
+    
+    ASSERT_TRUE(bankManager->enableJournal("test_twice.journal"));
+    int accNum = bankManager->createAccount("Carol", "pass1234", Money::rupees(1000));
+    bankManager->getAccount(accNum)->deposit(Money::rupees(100));
+    
+    // Snapshot without resetting the journal, as if a crash hit mid-checkpoint
+    EXPECT_TRUE(bankManager->saveToFile("test_twice.dat", BankManager::SnapshotFormat::BINARY));
+    bankManager->getAccount(accNum)->deposit(Money::rupees(50));
+    
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_twice.journal"));
+    ASSERT_TRUE(recovered->loadFromFile("test_twice.dat"));
+    EXPECT_EQ(recovered->getAccount(accNum)->getBalance(), Money::rupees(1150));
+    
+    fileManager.deleteFile("test_twice.journal");
+    fileManager.deleteFile("test_twice.dat");
+}
+
+// Test automatic checkpoint after the configured number of operations
+TEST_F(BankManagerTest, CheckpointIfDue) {
+    FileManager fileManager;
+    fileManager.deleteFile("test_due.journal");
+    
+    ASSERT_TRUE(bankManager->enableJournal("test_due.journal"));
+    bankManager->setCheckpointInterval(3);
+    int accNum = bankManager->createAccount("Dave", "pass1234", Money::rupees(1000));
+    bankManager->getAccount(accNum)->deposit(Money::rupees(10));
+    EXPECT_FALSE(bankManager->checkpointIfDue("test_due.dat"));
+    
+    bankManager->getAccount(accNum)->deposit(Money::rupees(10));
+    EXPECT_TRUE(bankManager->checkpointIfDue("test_due.dat"));
+    EXPECT_EQ(bankManager->getCheckpointLsn(), 3u);
+    
+    fileManager.deleteFile("test_due.journal");
+    fileManager.deleteFile("test_due.dat");
+}
+
+// Test parallel loading produces the same accounts as the serial loader
+TEST_F(BankManagerTest, ParallelLoadMatchesSerial) {
+    for (int i = 0; i < 600; ++i) {
+        int accNum = bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100 + i));
+        if (i % 3 == 0) {
+            bankManager->getAccount(accNum)->openFixedDeposit(Money::rupees(50), 12);
+        }
+    }
+    bankManager->saveToFile("test_parallel.txt");
+    bankManager->saveToFile("test_parallel.bin", BankManager::SnapshotFormat::BINARY);
+    
+    for (const char* file : {"test_parallel.txt", "test_parallel.bin"}) {
+        BankManager::resetInstance();
+        BankManager* serial = BankManager::getInstance();
+        serial->setLoadThreads(1);
+        ASSERT_TRUE(serial->loadFromFile(file));
+        std::string expected = serial->getAccount(1001)->serialize() + serial->getAccount(1600)->serialize();
+        size_t expectedCount = serial->getAccountCount();
+        
+        BankManager::resetInstance();
+        BankManager* parallel = BankManager::getInstance();
+        parallel->setLoadThreads(4);
+        ASSERT_TRUE(parallel->loadFromFile(file));
+        
+        EXPECT_EQ(expectedCount, 600u);
+        EXPECT_EQ(parallel->getAccountCount(), expectedCount);
+        EXPECT_EQ(parallel->getNextAccountNumber(), 1601);
+        EXPECT_EQ(parallel->getAccount(1001)->serialize() + parallel->getAccount(1600)->serialize(), expected);
+    }
+}
+
+// Test streaming load with a tiny buffer matches a whole-file load
+TEST_F(BankManagerTest, StreamingLoadSmallBuffer) {
+    for (int i = 0; i < 40; ++i) {
+        int accNum = bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(500 + i));
+        bankManager->getAccount(accNum)->deposit(Money::rupees(10));
+    }
+    bankManager->saveToFile("test_stream.txt");
+    bankManager->saveToFile("test_stream.bin", BankManager::SnapshotFormat::BINARY);
+    std::string expected = bankManager->getAccount(1040)->serialize();
+    
+    for (const char* file : {"test_stream.txt", "test_stream.bin"}) {
+        BankManager::resetInstance();
+        BankManager* streamed = BankManager::getInstance();
+        streamed->setLoadBufferSize(64);
+        ASSERT_TRUE(streamed->loadFromFile(file));
+        EXPECT_EQ(streamed->getAccountCount(), 40u);
+        EXPECT_EQ(streamed->getNextAccountNumber(), 1041);
+        EXPECT_EQ(streamed->getAccount(1040)->serialize(), expected);
+    }
+}
+
+// Test lazy load indexes accounts and only deserializes the ones accessed
+TEST_F(BankManagerTest, LazyLoadMaterializesOnAccess) {
+    for (int i = 0; i < 20; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100 + i));
+    }
+    bankManager->getAccount(1005)->deposit(Money::rupees(50));
+    bankManager->saveToFile("test_lazy.txt");
+    bankManager->saveToFile("test_lazy.bin", BankManager::SnapshotFormat::BINARY);
+    std::string expected = bankManager->getAccount(1005)->serialize();
+    
+    for (const char* file : {"test_lazy.txt", "test_lazy.bin"}) {
+        BankManager::resetInstance();
+        BankManager* lazy = BankManager::getInstance();
+        lazy->setLoadMode(BankManager::LoadMode::LAZY);
+        ASSERT_TRUE(lazy->loadFromFile(file));
+        
+        EXPECT_EQ(lazy->getAccountCount(), 20u);
+        EXPECT_EQ(lazy->getMaterializedCount(), 0u);
+        EXPECT_EQ(lazy->getNextAccountNumber(), 1021);
+        EXPECT_TRUE(lazy->accountExists(1020));
+        EXPECT_FALSE(lazy->accountExists(1021));
+        
+        EXPECT_EQ(lazy->getAccount(1005)->serialize(), expected);
+        EXPECT_NE(lazy->login(1010, "pass1234"), nullptr);
+        EXPECT_EQ(lazy->getMaterializedCount(), 2u);
+        EXPECT_EQ(lazy->getAccountCount(), 20u);
+    }
+}
+
+// Test bank-wide reports follow operations and include lazily loaded accounts
+TEST_F(BankManagerTest, BalanceReports) {
+    int acc1 = bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
+    int acc2 = bankManager->createAccount("Bob", "pass1234", Money::rupees(500));
+    bankManager->getAccount(acc1)->openFixedDeposit(Money::rupees(200), 12);
+    bankManager->transfer(acc1, acc2, Money::rupees(300));
+    bankManager->getAccount(acc2)->withdraw(Money::rupees(50));
+    
+    BalanceSummary summary = bankManager->getBalanceSummary({Money::rupees(600)});
+    EXPECT_EQ(summary.accounts, 2u);
+    EXPECT_EQ(summary.totalBalance, Money::rupees(1250));
+    EXPECT_EQ(summary.minBalance, Money::rupees(500));
+    EXPECT_EQ(summary.maxBalance, Money::rupees(750));
+    EXPECT_EQ(summary.totalFdPrincipal, Money::rupees(200));
+    EXPECT_EQ(summary.fixedDeposits, 1u);
+    EXPECT_EQ(summary.bucketCounts, (std::vector<size_t>{1, 1}));
+    
+    bankManager->saveToFile("test_report.bin", BankManager::SnapshotFormat::BINARY);
+    BankManager::resetInstance();
+    BankManager* lazy = BankManager::getInstance();
+    lazy->setLoadMode(BankManager::LoadMode::LAZY);
+    ASSERT_TRUE(lazy->loadFromFile("test_report.bin"));
+    EXPECT_EQ(lazy->getTotalBalance(), Money::rupees(1250));
+    EXPECT_EQ(lazy->getTotalFdPrincipal(), Money::rupees(200));
+}
+
+// Test saving a lazily loaded snapshot keeps untouched accounts
+TEST_F(BankManagerTest, LazySaveKeepsUnmaterializedAccounts) {
+    for (int i = 0; i < 10; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100));
+    }
+    bankManager->saveToFile("test_lazy_save.txt");
+    
+    BankManager::resetInstance();
+    BankManager* lazy = BankManager::getInstance();
+    lazy->setLoadMode(BankManager::LoadMode::LAZY);
+    ASSERT_TRUE(lazy->loadFromFile("test_lazy_save.txt"));
+    lazy->getAccount(1003)->deposit(Money::rupees(25));
+    int created = lazy->createAccount("Newcomer", "pass1234", Money::rupees(300));
+    
+    // Save in place (re-maps the file) and to the other format
+    EXPECT_TRUE(lazy->saveToFile("test_lazy_save.txt"));
+    EXPECT_TRUE(lazy->saveToFile("test_lazy_save.bin", BankManager::SnapshotFormat::BINARY));
+    EXPECT_EQ(lazy->getAccountCount(), 11u);
+    EXPECT_EQ(lazy->getAccount(1003)->getBalance(), Money::rupees(125));
+    EXPECT_EQ(lazy->getAccount(1007)->getBalance(), Money::rupees(100));
+    
+    for (const char* file : {"test_lazy_save.txt", "test_lazy_save.bin"}) {
+        BankManager::resetInstance();
+        BankManager* reloaded = BankManager::getInstance();
+        ASSERT_TRUE(reloaded->loadFromFile(file));
+        EXPECT_EQ(reloaded->getAccountCount(), 11u);
+        EXPECT_EQ(reloaded->getAccount(1003)->getBalance(), Money::rupees(125));
+        EXPECT_EQ(reloaded->getAccount(1009)->getBalance(), Money::rupees(100));
+        EXPECT_NE(reloaded->getAccount(created), nullptr);
+    }
+}
+
+// Test sharded save writes a manifest plus shard files and loads back in either mode
+TEST_F(BankManagerTest, ShardedSaveAndLoad) {
+    for (int i = 0; i < 12; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100 + i));
+    }
+    bankManager->setShardCount(4);
+    ASSERT_TRUE(bankManager->saveToFile("test_sharded.dat", BankManager::SnapshotFormat::BINARY));
+    
+    FileManager fileManager;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(fileManager.fileExists("test_sharded.dat.shard" + std::to_string(i)));
+    }
+    
+    for (auto mode : {BankManager::LoadMode::EAGER, BankManager::LoadMode::LAZY}) {
+        BankManager::resetInstance();
+        BankManager* loaded = BankManager::getInstance();
+        loaded->setLoadMode(mode);
+        ASSERT_TRUE(loaded->loadFromFile("test_sharded.dat"));
+        EXPECT_EQ(loaded->getAccountCount(), 12u);
+        EXPECT_EQ(loaded->getNextAccountNumber(), 1013);
+        EXPECT_EQ(loaded->getAccount(1007)->getBalance(), Money::rupees(106));
+    }
+}
+
+// Test only shards containing modified accounts are rewritten
+TEST_F(BankManagerTest, ShardedSaveSkipsCleanShards) {
+    for (int i = 0; i < 8; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100));
+    }
+    bankManager->setShardCount(4);
+    ASSERT_TRUE(bankManager->saveToFile("test_shard_dirty.dat"));
+    
+    // Account 1001 lives in shard 1001 % 4 = 1; mark every other shard file
+    FileManager fileManager;
+    for (int i : {0, 2, 3}) {
+        fileManager.writeToFile("test_shard_dirty.dat.shard" + std::to_string(i), "untouched");
+    }
+    bankManager->getAccount(1001)->deposit(Money::rupees(50));
+    ASSERT_TRUE(bankManager->saveToFile("test_shard_dirty.dat"));
+    
+    EXPECT_EQ(fileManager.readFromFile("test_shard_dirty.dat.shard0"), "untouched");
+    EXPECT_EQ(fileManager.readFromFile("test_shard_dirty.dat.shard3"), "untouched");
+    EXPECT_NE(fileManager.readFromFile("test_shard_dirty.dat.shard1"), "untouched");
+}
+
+// Test a damaged shard does not prevent loading the others, and is never overwritten
+TEST_F(BankManagerTest, ShardedLoadIsolatesDamagedShard) {
+    for (int i = 0; i < 8; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100));
+    }
+    bankManager->setShardCount(2);
+    ASSERT_TRUE(bankManager->saveToFile("test_shard_damaged.dat", BankManager::SnapshotFormat::BINARY));
+    
+    FileManager fileManager;
+    std::string shard0 = fileManager.readFromFile("test_shard_damaged.dat.shard0");
+    fileManager.writeToFile("test_shard_damaged.dat.shard0", shard0.substr(0, shard0.size() / 2));
+    
+    BankManager::resetInstance();
+    BankManager* loaded = BankManager::getInstance();
+    loaded->setShardCount(2);
+    EXPECT_FALSE(loaded->loadFromFile("test_shard_damaged.dat"));
+    EXPECT_EQ(loaded->getAccountCount(), 4u);
+    EXPECT_NE(loaded->getAccount(1001), nullptr);
+    EXPECT_EQ(loaded->getAccount(1002), nullptr);
+    
+    EXPECT_FALSE(loaded->saveToFile("test_shard_damaged.dat", BankManager::SnapshotFormat::BINARY));
+    EXPECT_EQ(fileManager.readFromFile("test_shard_damaged.dat.shard0").size(), shard0.size() / 2);
+}
+
+// Test journal replay honours each shard's own checkpoint LSN
+TEST_F(BankManagerTest, ShardedJournalRecovery) {
+    FileManager fileManager;
+    fileManager.deleteFile("test_shard_recovery.journal");
+    
+    ASSERT_TRUE(bankManager->enableJournal("test_shard_recovery.journal"));
+    bankManager->setShardCount(2);
+    bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
+    bankManager->createAccount("Bob", "pass1234", Money::rupees(1000));
+    ASSERT_TRUE(bankManager->saveToFile("test_shard_recovery.dat"));
+    
+    // Only Bob's shard is rewritten; the journal still holds Alice's later deposit
+    bankManager->getAccount(1002)->deposit(Money::rupees(10));
+    ASSERT_TRUE(bankManager->saveToFile("test_shard_recovery.dat"));
+    bankManager->getAccount(1001)->deposit(Money::rupees(20));
+    
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_shard_recovery.journal"));
+    ASSERT_TRUE(recovered->loadFromFile("test_shard_recovery.dat"));
+    EXPECT_EQ(recovered->getAccount(1001)->getBalance(), Money::rupees(1020));
+    EXPECT_EQ(recovered->getAccount(1002)->getBalance(), Money::rupees(1010));
+}
+
+// Test saves only re-encode accounts changed since the previous save
+TEST_F(BankManagerTest, IncrementalSaveReusesCleanRecords) {
+    for (int i = 0; i < 10; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100));
+    }
+    ASSERT_TRUE(bankManager->saveToFile("test_incremental.dat"));
+    EXPECT_EQ(bankManager->getLastSaveStats().accountsSerialized, 10u);
+    EXPECT_EQ(bankManager->getLastSaveStats().shardsWritten, 1u);
+    
+    // Nothing changed: the file is left alone
+    ASSERT_TRUE(bankManager->saveToFile("test_incremental.dat"));
+    EXPECT_EQ(bankManager->getLastSaveStats().shardsWritten, 0u);
+    EXPECT_EQ(bankManager->getLastSaveStats().bytesWritten, 0u);
+    
+    bankManager->getAccount(1004)->deposit(Money::rupees(25));
+    ASSERT_TRUE(bankManager->saveToFile("test_incremental.dat"));
+    EXPECT_EQ(bankManager->getLastSaveStats().accountsSerialized, 1u);
+    EXPECT_EQ(bankManager->getLastSaveStats().accountsReused, 9u);
+    EXPECT_GT(bankManager->getLastSaveStats().bytesWritten, 0u);
+    
+    // Cached records are per format
+    ASSERT_TRUE(bankManager->saveToFile("test_incremental.bin", BankManager::SnapshotFormat::BINARY));
+    EXPECT_EQ(bankManager->getLastSaveStats().accountsSerialized, 10u);
+    
+    BankManager::resetInstance();
+    BankManager* loaded = BankManager::getInstance();
+    ASSERT_TRUE(loaded->loadFromFile("test_incremental.dat"));
+    EXPECT_EQ(loaded->getAccount(1004)->getBalance(), Money::rupees(125));
+}
+
+// Test a background snapshot captures the state at request time while operations continue
+TEST_F(BankManagerTest, BackgroundSnapshotUsesRequestTimeView) {
+    for (int i = 0; i < 50; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100));
+    }
+    bankManager->requestSnapshot("test_background.dat", BankManager::SnapshotFormat::BINARY);
+    
+    // Changes after the request belong to the next snapshot
+    bankManager->getAccount(1001)->deposit(Money::rupees(900));
+    bankManager->createAccount("Late", "pass1234", Money::rupees(5));
+    ASSERT_TRUE(bankManager->waitForSnapshots());
+    
+    BankManager::resetInstance();
+    BankManager* loaded = BankManager::getInstance();
+    ASSERT_TRUE(loaded->loadFromFile("test_background.dat"));
+    EXPECT_EQ(loaded->getAccountCount(), 50u);
+    EXPECT_EQ(loaded->getAccount(1001)->getBalance(), Money::rupees(100));
+    
+    FileManager fileManager;
+    fileManager.deleteFile("test_background.dat");
+}
+
+// Test a burst of snapshot requests is written as fewer snapshots
+TEST_F(BankManagerTest, BackgroundSnapshotsCoalesce) {
+    for (int i = 0; i < 200; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100));
+    }
+    for (int i = 0; i < 20; ++i) {
+        bankManager->getAccount(1001 + i)->deposit(Money::rupees(1));
+        bankManager->requestSnapshot("test_coalesce.dat");
+    }
+    ASSERT_TRUE(bankManager->waitForSnapshots());
+    EXPECT_GE(bankManager->getSnapshotsWritten(), 1u);
+    EXPECT_LT(bankManager->getSnapshotsWritten(), 20u);
+    
+    // The last snapshot reflects every request
+    BankManager::resetInstance();
+    BankManager* loaded = BankManager::getInstance();
+    ASSERT_TRUE(loaded->loadFromFile("test_coalesce.dat"));
+    EXPECT_EQ(loaded->getAccount(1020)->getBalance(), Money::rupees(101));
+    
+    FileManager fileManager;
+    fileManager.deleteFile("test_coalesce.dat");
+}
+
+// Test background checkpoints keep journal entries written during the snapshot
+TEST_F(BankManagerTest, BackgroundCheckpointKeepsNewerJournalEntries) {
+    FileManager fileManager;
+    fileManager.deleteFile("test_bg_checkpoint.journal");
+    fileManager.deleteFile("test_bg_checkpoint.dat");
+    
+    ASSERT_TRUE(bankManager->enableJournal("test_bg_checkpoint.journal"));
+    bankManager->setBackgroundSnapshots(true);
+    int accNum = bankManager->createAccount("Alice", "pass1234", Money::rupees(1000));
+    bankManager->requestSnapshot("test_bg_checkpoint.dat");
+    bankManager->getAccount(accNum)->deposit(Money::rupees(250));
+    ASSERT_TRUE(bankManager->waitForSnapshots());
+    
+    // Recovery = snapshot (creation) + journal tail (deposit)
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_bg_checkpoint.journal"));
+    ASSERT_TRUE(recovered->loadFromFile("test_bg_checkpoint.dat"));
+    EXPECT_EQ(recovered->getAccount(accNum)->getBalance(), Money::rupees(1250));
+    
+    fileManager.deleteFile("test_bg_checkpoint.journal");
+    fileManager.deleteFile("test_bg_checkpoint.dat");
+}
+
+// Test deposits racing a snapshot are recovered exactly once, from the snapshot or from the journal tail
+TEST_F(BankManagerTest, SnapshotCutConsistentWithConcurrentDeposits) {
+    FileManager fileManager;
+    auto cleanup = [&fileManager]() {
+        fileManager.deleteFile("test_cut.journal");
+        fileManager.deleteFile("test_cut.dat");
+    };
+    cleanup();
+    ASSERT_TRUE(bankManager->enableJournal("test_cut.journal"));
+    const int accounts = 2000;
+    for (int i = 0; i < accounts; ++i) {
+        bankManager->createAccount("User" + std::to_string(i), "pass1234", Money::rupees(100));
+    }
+    ASSERT_TRUE(bankManager->checkpoint("test_cut.dat"));
+    
+    auto depositDuring = [this](const std::function<void()>& snapshot) {
+        std::atomic<bool> done(false);
+        std::thread depositor([this, &done]() {
+            for (int i = 0; !done || i < 200; ++i) {
+                bankManager->getAccount(1001 + (i * 7919) % accounts)->deposit(Money::rupees(1));
+            }
+        });
+        snapshot();
+        done = true;
+        depositor.join();
+    };
+    depositDuring([this]() { bankManager->requestSnapshot("test_cut.dat"); });
+    ASSERT_TRUE(bankManager->waitForSnapshots());
+    depositDuring([this]() { ASSERT_TRUE(bankManager->checkpoint("test_cut.dat")); });
+    depositDuring([this]() { bankManager->requestSnapshot("test_cut.dat"); });
+    ASSERT_TRUE(bankManager->waitForSnapshots());
+    
+    std::vector<Money> expected;
+    for (int i = 0; i < accounts; ++i) {
+        expected.push_back(bankManager->getAccount(1001 + i)->getBalance());
+    }
+    
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_cut.journal"));
+    ASSERT_TRUE(recovered->loadFromFile("test_cut.dat"));
+    for (int i = 0; i < accounts; ++i) {
+        ASSERT_EQ(recovered->getAccount(1001 + i)->getBalance(), expected[i]) << 1001 + i;
+    }
+    
+    BankManager::resetInstance();
+    cleanup();
+}
+
+// Test the transaction log keeps full history, and recovery does not log replayed operations twice
+TEST_F(BankManagerTest, FullHistoryInTransactionLog) {
+    FileManager fileManager;
+    auto cleanup = [&fileManager]() {
+        fileManager.deleteFile("test_history.journal");
+        fileManager.deleteFile("test_history.dat");
+        for (const char* file : {"test_history.log.000001", "test_history.log.000002"}) {
+            fileManager.deleteFile(file);
+            fileManager.deleteFile(std::string(file) + ".idx");
+        }
+    };
+    cleanup();
+    ASSERT_TRUE(bankManager->enableJournal("test_history.journal"));
+    ASSERT_TRUE(bankManager->enableTransactionLog("test_history.log"));
+    
+    int accNum = bankManager->createAccount("Alice", "password", Money::rupees(1000));
+    EXPECT_TRUE(bankManager->checkpoint("test_history.dat"));
+    auto account = bankManager->getAccount(accNum);
+    for (int i = 1; i <= 20; ++i) {
+        account->deposit(Money::rupees(i));
+    }
+    EXPECT_EQ(account->getTransactionHistory().size(), Account::MAX_TRANSACTION_HISTORY);
+    EXPECT_EQ(account->getTransactionCount(), 21u);
+    std::vector<Transaction> page = account->getTransactionPage(0, 3);
+    ASSERT_EQ(page.size(), 3u);
+    EXPECT_EQ(page[0].getDescription(), "Initial deposit");
+    EXPECT_EQ(page[2].getAmount(), Money::rupees(2));
+    
+    // The deposits are replayed from the journal but were already logged
+    account.reset();
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_history.journal"));
+    ASSERT_TRUE(recovered->enableTransactionLog("test_history.log"));
+    ASSERT_TRUE(recovered->loadFromFile("test_history.dat"));
+    EXPECT_EQ(recovered->getLastLoadStats().replayed, 20u);
+    
+    auto restored = recovered->getAccount(accNum);
+    EXPECT_EQ(restored->getTransactionCount(), 21u);
+    restored->withdraw(Money::rupees(100));
+    EXPECT_EQ(restored->getTransactionCount(), 22u);
+    EXPECT_EQ(restored->getTransactionPage(21, 10).front().getType(), Transaction::Type::WITHDRAWAL);
+    
+    restored.reset();
+    BankManager::resetInstance();
+    cleanup();
+}
+
+// Test matured FDs are credited at their maturity date and recovery catches up the rest
+TEST_F(BankManagerTest, MaturedDepositsCreditedAndCaughtUp) {
+    FileManager fileManager;
+    auto cleanup = [&fileManager]() {
+        fileManager.deleteFile("test_maturity.journal");
+        fileManager.deleteFile("test_maturity.dat");
+    };
+    cleanup();
+    ASSERT_TRUE(bankManager->enableJournal("test_maturity.journal"));
+    
+    int accNum = bankManager->createAccount("Alice", "password", Money::rupees(1000));
+    EXPECT_TRUE(bankManager->checkpoint("test_maturity.dat"));
+    auto account = bankManager->getAccount(accNum);
+    ASSERT_EQ(account->openFixedDeposit(Money::rupees(500), 12), OperationResult::OK);
+    ASSERT_EQ(account->openFixedDeposit(Money::rupees(300), 24), OperationResult::OK);
+    EXPECT_EQ(bankManager->getMaturityScheduler().size(), 2u);
+    
+    auto now = std::chrono::system_clock::now();
+    auto month = std::chrono::hours(24 * 31);
+    EXPECT_EQ(bankManager->creditMaturedDeposits(now), 0u);
+    EXPECT_EQ(bankManager->creditMaturedDeposits(now + 13 * month), 1u);
+    EXPECT_EQ(account->getBalance(), Money::fromRupees(732.50));
+    ASSERT_EQ(account->getFixedDeposits().size(), 1u);
+    const Transaction& credit = account->getTransactionHistory().back();
+    EXPECT_EQ(credit.getType(), Transaction::Type::FD_MATURITY);
+    EXPECT_EQ(credit.getAmount(), Money::fromRupees(532.50));
+    EXPECT_LT(credit.getTimestamp(), now + 13 * month);
+    
+    // The account stays queued for the FD it still holds
+    std::chrono::system_clock::time_point next;
+    ASSERT_TRUE(bankManager->getMaturityScheduler().nextMaturity(next));
+    EXPECT_EQ(next, account->getFixedDeposits().front()->getMaturityTime());
+    
+    // The journal replays the opens and the credit; the 24-month FD is still pending
+    account.reset();
+    BankManager::resetInstance();
+    BankManager* recovered = BankManager::getInstance();
+    ASSERT_TRUE(recovered->enableJournal("test_maturity.journal"));
+    ASSERT_TRUE(recovered->loadFromFile("test_maturity.dat"));
+    auto restored = recovered->getAccount(accNum);
+    EXPECT_EQ(restored->getBalance(), Money::fromRupees(732.50));
+    EXPECT_EQ(recovered->getMaturityScheduler().size(), 1u);
+    
+    EXPECT_EQ(recovered->creditMaturedDeposits(now + 25 * month), 1u);
+    EXPECT_EQ(restored->getBalance(), Money::fromRupees(1077.50));
+    EXPECT_TRUE(restored->getFixedDeposits().empty());
+    EXPECT_EQ(recovered->getMaturityScheduler().size(), 0u);
+    EXPECT_EQ(recovered->creditMaturedDeposits(now + 25 * month), 0u);
+    
+    restored.reset();
+    BankManager::resetInstance();
+    cleanup();
+}
+
+// Test an FD maturing a fraction of a second after the check stays scheduled until it matures
+TEST_F(BankManagerTest, SubSecondMaturityNotDropped) {
+    int accNum = bankManager->createAccount("Alice", "password", Money::rupees(1000));
+    auto account = bankManager->getAccount(accNum);
+    ASSERT_EQ(account->openFixedDeposit(Money::rupees(500), 12), OperationResult::OK);
+    auto due = account->getFixedDeposits().front()->getMaturityTime();
+    
+    EXPECT_EQ(bankManager->creditMaturedDeposits(due - std::chrono::milliseconds(1)), 0u);
+    std::chrono::system_clock::time_point next;
+    ASSERT_TRUE(bankManager->getMaturityScheduler().nextMaturity(next));
+    EXPECT_EQ(next, due);
+    EXPECT_EQ(bankManager->creditMaturedDeposits(due), 1u);
+    EXPECT_TRUE(account->getFixedDeposits().empty());
+}
+
+// Test the maturity projection follows FDs as they are opened and credited
+TEST_F(BankManagerTest, ProjectMaturitiesFollowsDeposits) {
+    int accNum = bankManager->createAccount("Alice", "password", Money::rupees(1000));
+    auto account = bankManager->getAccount(accNum);
+    ASSERT_EQ(account->openFixedDeposit(Money::rupees(500), 12), OperationResult::OK);
+    ASSERT_EQ(account->openFixedDeposit(Money::rupees(300), 24), OperationResult::OK);
+    
+    auto now = std::chrono::system_clock::now();
+    int thisMonth = FixedDeposit::monthIndex(now);
+    size_t first = static_cast<size_t>(
+        account->getFixedDeposits()[0]->getMaturityMonth() - thisMonth);
+    MaturityProjection projection = bankManager->projectMaturities(25, now);
+    EXPECT_EQ(projection.firstMonth, thisMonth);
+    EXPECT_EQ(projection.total.deposits, 2u);
+    EXPECT_EQ(projection.total.payout, Money::fromRupees(877.50));
+    EXPECT_EQ(projection.months[first].payout, Money::fromRupees(532.50));
+    
+    // A credited FD leaves the projection
+    auto month = std::chrono::hours(24 * 31);
+    EXPECT_EQ(bankManager->creditMaturedDeposits(now + 13 * month), 1u);
+    projection = bankManager->projectMaturities(25, now);
+    EXPECT_EQ(projection.total.deposits, 1u);
+    EXPECT_EQ(projection.months[first].deposits, 0u);
+    EXPECT_EQ(projection.total.principal, Money::rupees(300));
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include "CivilDate.h"
+#include <ctime>
+
+// Test day counts and dates round-trip and agree with gmtime across four centuries
+TEST(CivilDateTest, MatchesGmtime) {
+    for (int64_t days = -200000; days <= 200000; days += 7) {
+        CivilDate date = CivilDate::fromDays(days);
+        EXPECT_EQ(date.toDays(), days);
+        if (days >= 0 && days < 24000) {  // Within the range every time_t can represent
+            std::time_t seconds = static_cast<std::time_t>(days * 86400);
+            std::tm tm{};
+            gmtime_r(&seconds, &tm);
+            ASSERT_EQ(date, (CivilDate{tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1),
+                                       static_cast<unsigned>(tm.tm_mday)}));
+        }
+    }
+}
+
+// Test month arithmetic crosses years and rolls missing days over like mktime
+TEST(CivilDateTest, PlusMonths) {
+    EXPECT_EQ((CivilDate{2024, 11, 15}.plusMonths(12)), (CivilDate{2025, 11, 15}));
+    EXPECT_EQ((CivilDate{2024, 11, 15}.plusMonths(2)), (CivilDate{2025, 1, 15}));
+    EXPECT_EQ((CivilDate{2024, 1, 31}.plusMonths(1)), (CivilDate{2024, 3, 2}));
+    EXPECT_EQ((CivilDate{2023, 1, 31}.plusMonths(1)), (CivilDate{2023, 3, 3}));
+    EXPECT_EQ((CivilDate{2024, 2, 29}.plusMonths(24)), (CivilDate{2026, 3, 1}));
+    EXPECT_EQ((CivilDate{2025, 3, 10}.plusMonths(-3)), (CivilDate{2024, 12, 10}));
+    EXPECT_EQ((CivilDate{2025, 3, 10}.monthIndex()), 2025 * 12 + 2);
+
+    char buffer[CivilDate::FORMATTED_SIZE];
+    EXPECT_EQ(std::string(buffer, CivilDate{987, 6, 5}.format(buffer)), "0987-06-05");
+}
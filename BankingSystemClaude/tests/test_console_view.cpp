@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "ConsoleView.h"
+#include <sstream>
+
+class ConsoleViewTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        account = std::make_shared<Account>(1001, "John Doe", "password123", Money::rupees(1000));
+        view.reset(new ConsoleView(output));
+    }
+
+    std::shared_ptr<Account> account;
+    std::stringstream output;
+    std::unique_ptr<ConsoleView> view;
+};
+
+// Test operation results are rendered with the resulting balance
+TEST_F(ConsoleViewTest, RendersOperationResults) {
+    view->showDeposit(account->deposit(Money::rupees(500)), Money::rupees(500), *account);
+    EXPECT_NE(output.str().find("Successfully deposited ₹500.00"), std::string::npos);
+    EXPECT_NE(output.str().find("Current balance: ₹1500.00"), std::string::npos);
+
+    output.str("");
+    view->showWithdrawal(account->withdraw(Money::rupees(5000)), Money::rupees(5000), *account);
+    EXPECT_NE(output.str().find("Insufficient balance! Available: ₹1500.00"), std::string::npos);
+
+    output.str("");
+    view->showFixedDepositOpened(account->openFixedDeposit(Money::rupees(500), 18), *account);
+    EXPECT_NE(output.str().find(operationResultMessage(OperationResult::INVALID_TENURE)), std::string::npos);
+}
+
+// Test account views render the account's state
+TEST_F(ConsoleViewTest, RendersAccountViews) {
+    account->openFixedDeposit(Money::rupees(300), 12);
+
+    view->showAccountDetails(*account);
+    EXPECT_NE(output.str().find("John Doe"), std::string::npos);
+    EXPECT_NE(output.str().find("Active FDs        : 1"), std::string::npos);
+
+    output.str("");
+    view->showTransactionHistory(*account);
+    EXPECT_NE(output.str().find("Last 2 transactions"), std::string::npos);
+
+    output.str("");
+    view->showFixedDeposits(*account);
+    EXPECT_NE(output.str().find("FD #1:"), std::string::npos);
+}
+
+// Test history pages are numbered from the start of the full history
+TEST_F(ConsoleViewTest, RendersTransactionPages) {
+    account->deposit(Money::rupees(100));
+    account->deposit(Money::rupees(200));
+
+    view->showTransactionPage(*account, 2, 2);
+    EXPECT_NE(output.str().find("(3-3 of 3 transactions)"), std::string::npos);
+    EXPECT_NE(output.str().find("3. "), std::string::npos);
+    EXPECT_EQ(output.str().find("1. "), std::string::npos);
+
+    output.str("");
+    view->showTransactionPage(*account, 3, 2);
+    EXPECT_NE(output.str().find("No transactions on this page."), std::string::npos);
+}
+
+// Test result codes, statistics and diagnostics from BankManager
+TEST_F(ConsoleViewTest, RendersBankResults) {
+    view->showAccountCreated(BankResult::SHORT_PASSWORD, -1, "Bob", Money::rupees(100));
+    EXPECT_EQ(output.str(), "❌ Password must be at least 4 characters long!\n");
+
+    output.str("");
+    view->showLogin(BankResult::OK, account.get());
+    EXPECT_NE(output.str().find("Welcome, John Doe!"), std::string::npos);
+
+    output.str("");
+    BankManager::LoadStats stats;
+    stats.fileFound = true;
+    stats.indexed = true;
+    stats.files = 4;
+    stats.accounts = 12;
+    stats.replayed = 3;
+    view->showLoadStats(stats);
+    EXPECT_NE(output.str().find("Indexed 12 account(s) from 4 file(s)."), std::string::npos);
+    EXPECT_NE(output.str().find("Replayed 3 journaled operation(s)."), std::string::npos);
+
+    output.str("");
+    view->showDiagnostics({"Error saving data"});
+    EXPECT_EQ(output.str(), "❌ Error saving data!\n");
+}
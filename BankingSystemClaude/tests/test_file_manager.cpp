@@ -147,6 +147,17 @@ TEST_F(FileManagerTest, OverwriteFile) {
     fileManager->deleteFile("overwrite_test.txt");
 }
 
+// Test writes go through a temporary file that does not outlive the write
+TEST_F(FileManagerTest, AtomicWriteLeavesNoTempFile) {
+    fileManager->writeToFile("atomic_test.txt", "Original content");
+    EXPECT_TRUE(fileManager->writeToFile("atomic_test.txt", "Replaced content"));
+    
+    EXPECT_EQ(fileManager->readFromFile("atomic_test.txt"), "Replaced content");
+    EXPECT_FALSE(fileManager->fileExists("atomic_test.txt.tmp"));
+    
+    fileManager->deleteFile("atomic_test.txt");
+}
+
 // Test multiple sequential writes
 TEST_F(FileManagerTest, MultipleWrites) {
     for (int i = 0; i < 5; ++i) {
@@ -167,3 +178,73 @@ TEST_F(FileManagerTest, MultipleWrites) {
 TEST_F(FileManagerTest, GetDataDirectory) {
     EXPECT_EQ(fileManager->getDataDirectory(), testDataDir);
 }
+
+// Test block reader yields complete blocks across buffer refills
+TEST_F(FileManagerTest, BlockReaderSmallBuffer) {
+    std::string data = "HEADER\n";
+    for (int i = 0; i < 50; ++i) {
+        data += "START\nline " + std::to_string(i) + "\nmore\nEND\n";
+    }
+    fileManager->writeToFile("test_file.txt", data);
+    
+    auto reader = fileManager->openBlockReader("test_file.txt", 16);
+    ASSERT_TRUE(reader->isOpen());
+    
+    std::string_view line;
+    ASSERT_TRUE(reader->nextLine(line));
+    EXPECT_EQ(line, "HEADER");
+    
+    std::vector<std::string_view> blocks;
+    int count = 0;
+    while (reader->nextBlocks("START", "END", blocks) > 0) {
+        for (auto block : blocks) {
+            EXPECT_EQ(block, "line " + std::to_string(count++) + "\nmore\n");
+        }
+    }
+    EXPECT_EQ(count, 50);
+}
+
+// Test a block left open at end of file runs to the end
+TEST_F(FileManagerTest, BlockReaderUnterminatedBlock) {
+    fileManager->writeToFile("test_file.txt", "START\na\nEND\nSTART\nb");
+    
+    auto reader = fileManager->openBlockReader("test_file.txt", 1024);
+    std::vector<std::string_view> blocks;
+    std::vector<std::string> collected;
+    while (reader->nextBlocks("START", "END", blocks) > 0) {
+        collected.insert(collected.end(), blocks.begin(), blocks.end());
+    }
+    ASSERT_EQ(collected.size(), 2u);
+    EXPECT_EQ(collected[0], "a\n");
+    EXPECT_EQ(collected[1], "b\n");
+}
+
+// Test length-prefixed records, including one larger than the buffer
+TEST_F(FileManagerTest, BlockReaderRecords) {
+    std::string data;
+    for (uint32_t length : {3u, 100u, 5u}) {
+        data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        data.append(length, 'x');
+    }
+    fileManager->writeToFile("test_file.txt", data);
+    
+    auto reader = fileManager->openBlockReader("test_file.txt", 16);
+    std::vector<std::string_view> records;
+    std::vector<size_t> sizes;
+    while (reader->nextRecords(10, records) > 0) {
+        for (auto record : records) {
+            sizes.push_back(record.size());
+        }
+    }
+    EXPECT_EQ(sizes, (std::vector<size_t>{7, 104, 9}));
+}
+
+// Test mapping a file exposes its whole contents
+TEST_F(FileManagerTest, MapFile) {
+    fileManager->writeToFile("test_file.txt", std::string("mapped\0data", 11));
+    auto mapped = fileManager->mapFile("test_file.txt");
+    ASSERT_TRUE(mapped->isOpen());
+    EXPECT_EQ(mapped->view(), std::string_view("mapped\0data", 11));
+    
+    EXPECT_FALSE(fileManager->mapFile("missing_file.txt")->isOpen());
+}
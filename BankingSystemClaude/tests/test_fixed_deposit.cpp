@@ -1,11 +1,12 @@
 #include <gtest/gtest.h>
 #include "FixedDeposit.h"
+#include <ctime>
 
 class FixedDepositTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        fd12Months = std::make_shared<FixedDeposit>(10000.0, 12);
-        fd24Months = std::make_shared<FixedDeposit>(10000.0, 24);
+        fd12Months = std::make_shared<FixedDeposit>(Money::rupees(10000), 12);
+        fd24Months = std::make_shared<FixedDeposit>(Money::rupees(10000), 24);
     }
 
     void TearDown() override {
@@ -19,14 +20,14 @@ protected:
 
 // Test FD creation with 12 months
 TEST_F(FixedDepositTest, CreateFD12Months) {
-    EXPECT_DOUBLE_EQ(fd12Months->getPrincipal(), 10000.0);
+    EXPECT_EQ(fd12Months->getPrincipal(), Money::rupees(10000));
     EXPECT_EQ(fd12Months->getTenure(), 12);
     EXPECT_DOUBLE_EQ(fd12Months->getInterestRate(), 6.5);
 }
 
 // Test FD creation with 24 months
 TEST_F(FixedDepositTest, CreateFD24Months) {
-    EXPECT_DOUBLE_EQ(fd24Months->getPrincipal(), 10000.0);
+    EXPECT_EQ(fd24Months->getPrincipal(), Money::rupees(10000));
     EXPECT_EQ(fd24Months->getTenure(), 24);
     EXPECT_DOUBLE_EQ(fd24Months->getInterestRate(), 7.5);
 }
@@ -34,39 +35,39 @@ TEST_F(FixedDepositTest, CreateFD24Months) {
 // Test maturity amount calculation for 12 months
 TEST_F(FixedDepositTest, MaturityAmount12Months) {
     // 10000 * (1 + (6.5/100 * 1)) = 10000 * 1.065 = 10650
-    double expectedMaturity = 10650.0;
-    EXPECT_NEAR(fd12Months->calculateMaturityAmount(), expectedMaturity, 0.01);
+    Money expectedMaturity = Money::rupees(10650);
+    EXPECT_EQ(fd12Months->calculateMaturityAmount(), expectedMaturity);
 }
 
 // Test maturity amount calculation for 24 months
 TEST_F(FixedDepositTest, MaturityAmount24Months) {
     // 10000 * (1 + (7.5/100 * 2)) = 10000 * 1.15 = 11500
-    double expectedMaturity = 11500.0;
-    EXPECT_NEAR(fd24Months->calculateMaturityAmount(), expectedMaturity, 0.01);
+    Money expectedMaturity = Money::rupees(11500);
+    EXPECT_EQ(fd24Months->calculateMaturityAmount(), expectedMaturity);
 }
 
 // Test FD with invalid tenure
 TEST(FixedDepositCreationTest, InvalidTenure) {
     EXPECT_THROW({
-        FixedDeposit fd(10000.0, 6);
+        FixedDeposit fd(Money::rupees(10000), 6);
     }, std::invalid_argument);
     
     EXPECT_THROW({
-        FixedDeposit fd(10000.0, 36);
+        FixedDeposit fd(Money::rupees(10000), 36);
     }, std::invalid_argument);
 }
 
 // Test FD with negative amount
 TEST(FixedDepositCreationTest, NegativeAmount) {
     EXPECT_THROW({
-        FixedDeposit fd(-5000.0, 12);
+        FixedDeposit fd(Money::rupees(-5000), 12);
     }, std::invalid_argument);
 }
 
 // Test FD with zero amount
 TEST(FixedDepositCreationTest, ZeroAmount) {
     EXPECT_THROW({
-        FixedDeposit fd(0.0, 12);
+        FixedDeposit fd(Money::rupees(0), 12);
     }, std::invalid_argument);
 }
 
@@ -79,15 +80,39 @@ TEST_F(FixedDepositTest, MaturityDateFormat) {
     EXPECT_EQ(maturityDate[7], '-');
 }
 
+// Test the cached maturity matches the local calendar date tenure months after opening
+TEST_F(FixedDepositTest, MaturityFollowsLocalCalendar) {
+    auto openedAt = [](int year, int month, int day) {
+        std::tm tm{};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        tm.tm_hour = 12;
+        tm.tm_isdst = -1;
+        return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    };
+    
+    FixedDeposit fd(Money::rupees(1000), 12, openedAt(2024, 1, 15));
+    EXPECT_EQ(fd.getMaturityDate(), "2025-01-15");
+    EXPECT_EQ(fd.getMaturityMonth(), 2025 * 12);
+    EXPECT_EQ(FixedDeposit::localDate(fd.getMaturityTime()), (CivilDate{2025, 1, 15}));
+    EXPECT_EQ(fd.getMaturityTime() - fd.getOpenDate(), std::chrono::hours(24 * 366));
+    
+    // A leap day rolls over to March 1st
+    FixedDeposit leap(Money::rupees(1000), 24, openedAt(2024, 2, 29));
+    EXPECT_EQ(leap.getMaturityDate(), "2026-03-01");
+    EXPECT_EQ(leap.getMaturityCivilDate(), (CivilDate{2026, 3, 1}));
+}
+
 // Test different principal amounts
 TEST(FixedDepositCalculationTest, DifferentPrincipals) {
-    FixedDeposit fd1(5000.0, 12);
-    FixedDeposit fd2(20000.0, 12);
-    FixedDeposit fd3(50000.0, 24);
+    FixedDeposit fd1(Money::rupees(5000), 12);
+    FixedDeposit fd2(Money::rupees(20000), 12);
+    FixedDeposit fd3(Money::rupees(50000), 24);
     
-    EXPECT_NEAR(fd1.calculateMaturityAmount(), 5325.0, 0.01);
-    EXPECT_NEAR(fd2.calculateMaturityAmount(), 21300.0, 0.01);
-    EXPECT_NEAR(fd3.calculateMaturityAmount(), 57500.0, 0.01);
+    EXPECT_EQ(fd1.calculateMaturityAmount(), Money::rupees(5325));
+    EXPECT_EQ(fd2.calculateMaturityAmount(), Money::rupees(21300));
+    EXPECT_EQ(fd3.calculateMaturityAmount(), Money::rupees(57500));
 }
 
 // Test serialization and deserialization
@@ -95,31 +120,45 @@ TEST_F(FixedDepositTest, SerializationDeserialization) {
     std::string serialized = fd12Months->serialize();
     FixedDeposit deserialized = FixedDeposit::deserialize(serialized);
     
-    EXPECT_DOUBLE_EQ(deserialized.getPrincipal(), fd12Months->getPrincipal());
+    EXPECT_EQ(deserialized.getPrincipal(), fd12Months->getPrincipal());
     EXPECT_EQ(deserialized.getTenure(), fd12Months->getTenure());
     EXPECT_DOUBLE_EQ(deserialized.getInterestRate(), fd12Months->getInterestRate());
 }
 
 // Test interest calculation accuracy
 TEST(FixedDepositInterestTest, InterestCalculation) {
-    FixedDeposit fd(10000.0, 12);
-    double maturity = fd.calculateMaturityAmount();
-    double interest = maturity - 10000.0;
+    FixedDeposit fd(Money::rupees(10000), 12);
+    Money maturity = fd.calculateMaturityAmount();
+    Money interest = maturity - Money::rupees(10000);
     
     // Interest should be 10000 * 6.5% = 650
-    EXPECT_NEAR(interest, 650.0, 0.01);
+    EXPECT_EQ(interest, Money::rupees(650));
 }
 
 // Test large amount FD
 TEST(FixedDepositCreationTest, LargeAmount) {
-    FixedDeposit fd(1000000.0, 24); // 10 Lakh
-    EXPECT_DOUBLE_EQ(fd.getPrincipal(), 1000000.0);
-    EXPECT_NEAR(fd.calculateMaturityAmount(), 1150000.0, 0.01);
+    FixedDeposit fd(Money::rupees(1000000), 24); // 10 Lakh
+    EXPECT_EQ(fd.getPrincipal(), Money::rupees(1000000));
+    EXPECT_EQ(fd.calculateMaturityAmount(), Money::rupees(1150000));
 }
 
 // Test small amount FD
 TEST(FixedDepositCreationTest, SmallAmount) {
-    FixedDeposit fd(100.0, 12);
-    EXPECT_DOUBLE_EQ(fd.getPrincipal(), 100.0);
-    EXPECT_NEAR(fd.calculateMaturityAmount(), 106.5, 0.01);
+    FixedDeposit fd(Money::rupees(100), 12);
+    EXPECT_EQ(fd.getPrincipal(), Money::rupees(100));
+    EXPECT_EQ(fd.calculateMaturityAmount(), Money::fromRupees(106.5));
+}
+
+// Test allocation-free parser validates fields without throwing
+TEST(FixedDepositParseTest, ParseReportsErrors) {
+    std::shared_ptr<FixedDeposit> fd;
+    EXPECT_EQ(FixedDeposit::parse("1000|12|6.5", fd), ParseError::MISSING_FIELD);
+    EXPECT_EQ(FixedDeposit::parse("1000|12x|6.5|1770747669", fd), ParseError::INVALID_NUMBER);
+    EXPECT_EQ(FixedDeposit::parse("1000|18|6.5|1770747669", fd), ParseError::INVALID_VALUE);
+    EXPECT_EQ(fd, nullptr);
+    
+    ASSERT_EQ(FixedDeposit::parse("1000|24|7.5|1770747669", fd), ParseError::NONE);
+    EXPECT_EQ(fd->getPrincipal(), Money::rupees(1000));
+    EXPECT_EQ(fd->getTenure(), 24);
+    EXPECT_EQ(std::chrono::system_clock::to_time_t(fd->getOpenDate()), 1770747669);
 }
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "FixedDepositColumns.h"
+#include "FixedDeposit.h"
+#include <ctime>
+
+class FixedDepositColumnsTest : public ::testing::Test {
+protected:
+    // Noon on the 15th, so the local month is the same in every time zone
+    static std::chrono::system_clock::time_point midMonth(int year, int month) {
+        std::tm tm{};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = 15;
+        tm.tm_hour = 12;
+        tm.tm_isdst = -1;
+        return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    }
+
+    static int month(int year, int month) { return year * 12 + month - 1; }
+
+    FixedDepositColumns columns;
+};
+
+// Test payouts land in the month each FD matures, with overdue and later buckets around them
+TEST_F(FixedDepositColumnsTest, BucketsByMaturityMonth) {
+    FixedDeposit january(Money::rupees(10000), 12, midMonth(2024, 1));   // Matures January 2025
+    FixedDeposit march(Money::rupees(20000), 24, midMonth(2023, 3));     // Matures March 2025
+    FixedDeposit overdue(Money::rupees(5000), 12, midMonth(2023, 6));    // Matured June 2024
+    FixedDeposit later(Money::rupees(8000), 24, midMonth(2024, 6));      // Matures June 2026
+    columns.attach(1001, january);
+    columns.attach(1001, march);
+    columns.attach(0, overdue);  // Account number 0 still owns a row
+    FixedDepositColumns::Cell laterCell = columns.attach(1003, later);
+    EXPECT_EQ(columns.size(), 4u);
+    EXPECT_EQ(january.getMaturityMonth(), month(2025, 1));
+
+    MaturityProjection projection = columns.project(month(2025, 1), 3);
+    ASSERT_EQ(projection.months.size(), 3u);
+    EXPECT_EQ(projection.yearOf(2), 2025);
+    EXPECT_EQ(projection.monthOf(2), 3);
+
+    EXPECT_EQ(projection.months[0].deposits, 1u);
+    EXPECT_EQ(projection.months[0].principal, Money::rupees(10000));
+    EXPECT_EQ(projection.months[0].payout, january.calculateMaturityAmount());
+    EXPECT_EQ(projection.months[0].interest(), Money::rupees(650));
+    EXPECT_EQ(projection.months[1].deposits, 0u);
+    EXPECT_EQ(projection.months[2].payout, Money::rupees(23000));
+    EXPECT_EQ(projection.overdue.payout, overdue.calculateMaturityAmount());
+    EXPECT_EQ(projection.later.payout, later.calculateMaturityAmount());
+    EXPECT_EQ(projection.total.deposits, 4u);
+    EXPECT_EQ(projection.total.principal, Money::rupees(43000));
+
+    // A released row drops out of the projection and is handed out again
+    columns.release(laterCell);
+    EXPECT_EQ(columns.size(), 3u);
+    projection = columns.project(month(2025, 1), 3);
+    EXPECT_EQ(projection.later.deposits, 0u);
+    EXPECT_EQ(projection.total.deposits, 3u);
+    EXPECT_EQ(columns.attach(1004, later).index, laterCell.index);
+}
+
+// Test a parallel projection over several chunks matches the serial one and the FDs themselves
+TEST_F(FixedDepositColumnsTest, ParallelProjectionMatchesSerial) {
+    size_t rows = FixedDepositColumns::CHUNK_ROWS * 3 + 17;
+    Money expectedPayout;
+    for (size_t i = 0; i < rows; ++i) {
+        FixedDeposit fd(Money::fromPaise(100000 + static_cast<int64_t>(i) * 37), i % 3 == 0 ? 24 : 12,
+                        midMonth(2024, static_cast<int>(i % 12) + 1));
+        columns.attach(static_cast<int>(1001 + i % 500), fd);
+        expectedPayout += fd.calculateMaturityAmount();
+    }
+
+    MaturityProjection serial = columns.project(month(2025, 1), 24, 1);
+    MaturityProjection parallel = columns.project(month(2025, 1), 24, 4);
+    EXPECT_EQ(serial.total.deposits, rows);
+    EXPECT_EQ(serial.total.payout, expectedPayout);
+    EXPECT_EQ(serial.overdue.deposits + serial.later.deposits, 0u);
+    ASSERT_EQ(parallel.months.size(), serial.months.size());
+    for (size_t m = 0; m < serial.months.size(); ++m) {
+        EXPECT_EQ(parallel.months[m].deposits, serial.months[m].deposits);
+        EXPECT_EQ(parallel.months[m].payout, serial.months[m].payout);
+    }
+    EXPECT_EQ(parallel.total.payout, expectedPayout);
+}
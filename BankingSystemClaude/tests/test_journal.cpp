@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "Journal.h"
+#include "FileManager.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class JournalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fileManager.deleteFile("test.journal");
+        journal = std::make_unique<Journal>("test.journal", "test_data");
+        ASSERT_TRUE(journal->open());
+    }
+
+    void TearDown() override {
+        journal.reset();
+        fileManager.deleteFile("test.journal");
+    }
+
+    static JournalEntry deposit(int accNum, Money amount) {
+        JournalEntry entry;
+        entry.operation = JournalEntry::Operation::DEPOSIT;
+        entry.accountNumber = accNum;
+        entry.amount = amount;
+        entry.timestamp = 1770747577;
+        return entry;
+    }
+
+    FileManager fileManager{"test_data"};
+    std::unique_ptr<Journal> journal;
+};
+
+// Test entry serialization round trip
+TEST(JournalEntryTest, SerializationRoundTrip) {
+    JournalEntry entry;
+    entry.lsn = 42;
+    entry.operation = JournalEntry::Operation::CREATE_ACCOUNT;
+    entry.accountNumber = 1001;
+    entry.amount = Money::fromRupees(1234.56);
+    entry.timestamp = 1770747552;
+    entry.passwordHash = "15651099383784684535";
+    entry.holderName = "Name|With|Pipes";
+
+    JournalEntry restored = JournalEntry::deserialize(entry.serialize());
+    EXPECT_EQ(restored.lsn, 42u);
+    EXPECT_EQ(restored.operation, JournalEntry::Operation::CREATE_ACCOUNT);
+    EXPECT_EQ(restored.accountNumber, 1001);
+    EXPECT_EQ(restored.amount, Money::fromRupees(1234.56));
+    EXPECT_EQ(restored.timestamp, 1770747552);
+    EXPECT_EQ(restored.passwordHash, "15651099383784684535");
+    EXPECT_EQ(restored.holderName, "Name|With|Pipes");
+}
+
+// Test transfer entries round-trip their counterparty
+TEST(JournalEntryTest, TransferRoundTrip) {
+    JournalEntry entry;
+    entry.operation = JournalEntry::Operation::TRANSFER;
+    entry.accountNumber = 1001;
+    entry.counterparty = 1002;
+    entry.amount = Money::rupees(250);
+
+    JournalEntry restored = JournalEntry::deserialize(entry.serialize());
+    EXPECT_EQ(restored.operation, JournalEntry::Operation::TRANSFER);
+    EXPECT_EQ(restored.accountNumber, 1001);
+    EXPECT_EQ(restored.counterparty, 1002);
+    EXPECT_EQ(restored.tenure, 0);
+}
+
+// Test appended entries get increasing LSNs and can be read back
+TEST_F(JournalTest, AppendAndRead) {
+    EXPECT_EQ(journal->append(deposit(1001, Money::rupees(100))), 1u);
+    EXPECT_EQ(journal->append(deposit(1002, Money::rupees(200))), 2u);
+    EXPECT_EQ(journal->getPendingEntries(), 2u);
+
+    auto entries = journal->readEntries();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[1].accountNumber, 1002);
+    EXPECT_EQ(entries[1].amount, Money::rupees(200));
+}
+
+// Test reopening continues LSN numbering
+TEST_F(JournalTest, ReopenContinuesLsn) {
+    journal->append(deposit(1001, Money::rupees(100)));
+    journal->append(deposit(1001, Money::rupees(100)));
+
+    Journal reopened("test.journal", "test_data");
+    ASSERT_TRUE(reopened.open());
+    EXPECT_EQ(reopened.getPendingEntries(), 2u);
+    EXPECT_EQ(reopened.append(deposit(1001, Money::rupees(100))), 3u);
+}
+
+// Test reset discards entries but keeps LSNs increasing
+TEST_F(JournalTest, ResetKeepsLsnMonotonic) {
+    journal->append(deposit(1001, Money::rupees(100)));
+    EXPECT_TRUE(journal->reset());
+    EXPECT_TRUE(journal->readEntries().empty());
+    EXPECT_EQ(journal->append(deposit(1001, Money::rupees(100))), 2u);
+}
+
+// Test torn final line from a crash is ignored
+TEST_F(JournalTest, TornTailIgnored) {
+    journal->append(deposit(1001, Money::rupees(100)));
+    journal.reset();
+
+    std::string data = fileManager.readFromFile("test.journal");
+    fileManager.writeToFile("test.journal", data + "2|D|1001|50");
+
+    Journal reopened("test.journal", "test_data");
+    EXPECT_EQ(reopened.readEntries().size(), 1u);
+}
+
+// Test discarding a prefix keeps later entries and appends after them
+TEST_F(JournalTest, DiscardThroughKeepsNewerEntries) {
+    journal->append(deposit(1001, Money::rupees(100)));
+    journal->append(deposit(1002, Money::rupees(200)));
+    journal->append(deposit(1003, Money::rupees(300)));
+    
+    EXPECT_TRUE(journal->discardThrough(2));
+    EXPECT_EQ(journal->getPendingEntries(), 1u);
+    EXPECT_EQ(journal->append(deposit(1004, Money::rupees(400))), 4u);
+    
+    std::vector<JournalEntry> entries = journal->readEntries();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].accountNumber, 1003);
+    EXPECT_EQ(entries[1].accountNumber, 1004);
+}
+
+// Test batch appends number entries in order
+TEST_F(JournalTest, AppendBatchAssignsLsns) {
+    journal->append(deposit(1001, Money::rupees(100)));
+    std::vector<JournalEntry> batch = {deposit(1002, Money::rupees(1)), deposit(1003, Money::rupees(2))};
+    
+    EXPECT_TRUE(journal->appendBatch(batch));
+    EXPECT_EQ(batch[0].lsn, 2u);
+    EXPECT_EQ(batch[1].lsn, 3u);
+    EXPECT_EQ(journal->getPendingEntries(), 3u);
+    EXPECT_EQ(journal->readEntries().back().accountNumber, 1003);
+}
+
+// Test concurrent durable appends complete and share commits
+TEST_F(JournalTest, GroupCommitBatchesConcurrentAppends) {
+    const int threads = 8;
+    const int perThread = 25;
+    journal->setMaxCommitDelay(std::chrono::milliseconds(2));
+    journal->setMaxCommitBatch(threads);
+    
+    std::atomic<int> committed(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([this, t, &committed]() {
+            for (int i = 0; i < perThread; ++i) {
+                if (journal->appendDurable(deposit(1001 + t, Money::rupees(1))).get()) {
+                    ++committed;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    EXPECT_EQ(committed.load(), threads * perThread);
+    EXPECT_LT(journal->getCommitCount(), static_cast<size_t>(threads * perThread));
+    EXPECT_EQ(journal->readEntries().size(), static_cast<size_t>(threads * perThread));
+    EXPECT_EQ(journal->getLastLsn(), static_cast<uint64_t>(threads * perThread));
+}
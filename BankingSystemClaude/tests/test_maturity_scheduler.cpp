@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "MaturityScheduler.h"
+#include <algorithm>
+#include <random>
+
+class MaturitySchedulerTest : public ::testing::Test {
+protected:
+    static std::chrono::system_clock::time_point at(std::time_t seconds) {
+        return std::chrono::system_clock::from_time_t(seconds);
+    }
+
+    MaturityScheduler scheduler;
+};
+
+// Test due accounts come out earliest first, once each, and later entries stay queued
+TEST_F(MaturitySchedulerTest, TakesDueEntriesInOrder) {
+    scheduler.schedule(1003, at(3000));
+    scheduler.schedule(1001, at(1000));
+    scheduler.schedule(1002, at(2000));
+    scheduler.schedule(1001, at(2500));
+    scheduler.schedule(1004, at(9000));
+
+    std::chrono::system_clock::time_point next;
+    ASSERT_TRUE(scheduler.nextMaturity(next));
+    EXPECT_EQ(next, at(1000));
+
+    EXPECT_TRUE(scheduler.takeDue(at(999)).empty());
+    EXPECT_EQ(scheduler.takeDue(at(3000)), (std::vector<int>{1001, 1002, 1003}));
+    EXPECT_EQ(scheduler.size(), 1u);
+    ASSERT_TRUE(scheduler.nextMaturity(next));
+    EXPECT_EQ(next, at(9000));
+
+    scheduler.clear();
+    EXPECT_FALSE(scheduler.nextMaturity(next));
+}
+
+// Test a long backlog scheduled in random order drains in maturity order
+TEST_F(MaturitySchedulerTest, CatchUpDrainsBacklogInOrder) {
+    std::vector<int> accounts;
+    for (int i = 0; i < 1000; ++i) {
+        accounts.push_back(1001 + i);
+    }
+    std::shuffle(accounts.begin(), accounts.end(), std::mt19937(7));
+    for (int accNum : accounts) {
+        scheduler.schedule(accNum, at(100000 + accNum));
+    }
+
+    std::vector<int> due = scheduler.takeDue(at(100000 + 1500));
+    ASSERT_EQ(due.size(), 500u);
+    for (size_t i = 0; i < due.size(); ++i) {
+        EXPECT_EQ(due[i], static_cast<int>(1001 + i));
+    }
+    EXPECT_EQ(scheduler.size(), 500u);
+}
+
+// Test entries keep sub-second maturity times and are not taken before them
+TEST_F(MaturitySchedulerTest, KeepsSubSecondMaturities) {
+    auto maturity = at(1000) + std::chrono::milliseconds(500);
+    scheduler.schedule(1001, maturity);
+
+    EXPECT_TRUE(scheduler.takeDue(at(1000) + std::chrono::milliseconds(200)).empty());
+    std::chrono::system_clock::time_point next;
+    ASSERT_TRUE(scheduler.nextMaturity(next));
+    EXPECT_EQ(next, maturity);
+    EXPECT_EQ(scheduler.takeDue(maturity), (std::vector<int>{1001}));
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "Money.h"
+#include "FixedDeposit.h"
+#include "BinaryIO.h"
+#include <limits>
+#include <sstream>
+
+// Test decimal text parses exactly and prints with two fraction digits
+TEST(MoneyTest, ParseAndFormatExactly) {
+    Money amount;
+    ASSERT_TRUE(Money::parse("1234.56", amount));
+    EXPECT_EQ(amount.toPaise(), 123456);
+    EXPECT_EQ(amount.toString(), "1234.56");
+    ASSERT_TRUE(Money::parse("-0.5", amount));
+    EXPECT_EQ(amount.toPaise(), -50);
+    EXPECT_EQ(amount.toString(), "-0.50");
+    ASSERT_TRUE(Money::parse("0.30000000000000004", amount));
+    EXPECT_EQ(amount, Money::fromPaise(30));
+    ASSERT_TRUE(Money::parse("1e+06", amount));
+    EXPECT_EQ(amount, Money::rupees(1000000));
+    EXPECT_FALSE(Money::parse("12abc", amount));
+    EXPECT_FALSE(Money::parse("", amount));
+
+    std::istringstream in("99.99 oops");
+    in >> amount;
+    EXPECT_EQ(amount, Money::fromPaise(9999));
+    in >> amount;
+    EXPECT_TRUE(in.fail());
+}
+
+// Test rupee values that are not finite or do not fit in int64 paise are rejected
+TEST(MoneyTest, RejectsOutOfRangeRupees) {
+    Money amount = Money::rupees(7);
+    EXPECT_FALSE(Money::fromRupees(1e300, amount));
+    EXPECT_FALSE(Money::fromRupees(-9.3e16, amount));
+    EXPECT_FALSE(Money::fromRupees(std::numeric_limits<double>::quiet_NaN(), amount));
+    EXPECT_FALSE(Money::fromRupees(std::numeric_limits<double>::infinity(), amount));
+    EXPECT_EQ(amount, Money::rupees(7));
+    ASSERT_TRUE(Money::fromRupees(9.2e16, amount));
+    EXPECT_EQ(amount.toPaise(), 9200000000000000000);
+    EXPECT_THROW(Money::fromRupees(1e300), std::out_of_range);
+
+    EXPECT_FALSE(Money::parse("1e300", amount));
+    EXPECT_FALSE(Money::parse("-1e17", amount));
+    EXPECT_FALSE(Money::parse("nan", amount));
+
+    std::string data;
+    BinaryWriter out(data);
+    out.writeF64(std::numeric_limits<double>::infinity());
+    BinaryReader in(data.data(), data.size());
+    EXPECT_THROW(in.readMoney(AmountFormat::RUPEES), std::runtime_error);
+}
+
+// Test repeated small additions do not drift the way doubles do
+TEST(MoneyTest, SumsAreExact) {
+    Money total;
+    double drifting = 0;
+    for (int i = 0; i < 1000; ++i) {
+        total += Money::fromRupees(0.1);
+        drifting += 0.1;
+    }
+    EXPECT_EQ(total, Money::rupees(100));
+    EXPECT_NE(drifting, 100.0);
+    EXPECT_EQ(Money::fromRupees(0.1 + 0.2), Money::fromRupees(0.3));
+}
+
+// Test interest rounds to the nearest paisa, halves away from zero
+TEST(MoneyTest, ScaledRoundsHalfAwayFromZero) {
+    EXPECT_EQ(Money::fromPaise(5).scaled(1, 2), Money::fromPaise(3));
+    EXPECT_EQ(Money::fromPaise(-5).scaled(1, 2), Money::fromPaise(-3));
+    EXPECT_EQ(Money::fromPaise(4).scaled(1, 3), Money::fromPaise(1));
+
+    // 333.33 at 6.5% for 12 months is 21.66645 interest
+    FixedDeposit fd(Money::fromPaise(33333), 12);
+    EXPECT_EQ(fd.calculateMaturityAmount(), Money::fromPaise(33333 + 2167));
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "RingBuffer.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class RingBufferTest : public ::testing::Test {
+protected:
+    RingBuffer<int, 3> buffer;
+
+    std::vector<int> contents() const {
+        return std::vector<int>(buffer.begin(), buffer.end());
+    }
+};
+
+// Test a full buffer drops its oldest element and iterates oldest first
+TEST_F(RingBufferTest, KeepsMostRecentInOrder) {
+    EXPECT_TRUE(buffer.empty());
+    buffer.push_back(1);
+    buffer.push_back(2);
+    EXPECT_EQ(contents(), (std::vector<int>{1, 2}));
+
+    for (int i = 3; i <= 7; ++i) {
+        buffer.emplace_back(i);
+    }
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(buffer.size(), 3u);
+    EXPECT_EQ(contents(), (std::vector<int>{5, 6, 7}));
+    EXPECT_EQ(buffer.front(), 5);
+    EXPECT_EQ(buffer.back(), 7);
+    EXPECT_EQ(buffer[1], 6);
+
+    RingBuffer<int, 3> copy(buffer);
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(std::vector<int>(copy.begin(), copy.end()), (std::vector<int>{5, 6, 7}));
+}
+
+// Test elements with owned resources are destroyed when replaced or cleared
+TEST_F(RingBufferTest, ReleasesReplacedElements) {
+    auto tracked = std::make_shared<std::string>("entry");
+    {
+        RingBuffer<std::shared_ptr<std::string>, 2> owners;
+        owners.push_back(tracked);
+        owners.push_back(tracked);
+        EXPECT_EQ(tracked.use_count(), 3);
+
+        owners.emplace_back(std::make_shared<std::string>("other"));
+        EXPECT_EQ(tracked.use_count(), 2);
+
+        RingBuffer<std::shared_ptr<std::string>, 2> copy;
+        copy = owners;
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "ThreadPool.h"
+#include <atomic>
+#include <stdexcept>
+
+// Test tasks run and return results through futures
+TEST(ThreadPoolTest, SubmitReturnsResults) {
+    ThreadPool pool(4);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(pool.submit([i]() { return i * i; }));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(results[i].get(), i * i);
+    }
+}
+
+// Test all queued tasks finish before the pool is destroyed
+TEST(ThreadPoolTest, DestructorDrainsQueue) {
+    std::atomic<int> counter(0);
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&counter]() { counter++; });
+        }
+    }
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+// Test exceptions propagate through the future
+TEST(ThreadPoolTest, ExceptionPropagates) {
+    ThreadPool pool(1);
+    auto result = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+// Test zero selects the default thread count
+TEST(ThreadPoolTest, DefaultThreadCount) {
+    ThreadPool pool(0);
+    EXPECT_EQ(pool.size(), ThreadPool::defaultThreadCount());
+    EXPECT_GE(pool.size(), 1u);
+}
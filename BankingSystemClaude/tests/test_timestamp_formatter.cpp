@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "TimestampFormatter.h"
+#include "Transaction.h"
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+class TimestampFormatterTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        useTimeZone(savedTimeZone);
+    }
+
+    static void useTimeZone(const std::string& zone) {
+#ifdef _WIN32
+        _putenv_s("TZ", zone.c_str());  // An empty value removes the variable
+        _tzset();
+#else
+        if (zone.empty()) {
+            unsetenv("TZ");
+        } else {
+            setenv("TZ", zone.c_str(), 1);
+        }
+        tzset();
+#endif
+    }
+
+    static std::string reference(std::time_t time) {
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        char buffer[32];
+        return std::string(buffer, std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm));
+    }
+
+    // Formats on a fresh thread so no day cached under another time zone is reused
+    static void expectMatchesStrftime(std::time_t from, std::time_t to, std::time_t step) {
+        std::thread([from, to, step]() {
+            char buffer[TimestampFormatter::FORMATTED_SIZE];
+            for (std::time_t time = from; time < to; time += step) {
+                ASSERT_EQ(std::string(buffer, TimestampFormatter::format(time, buffer)), reference(time)) << time;
+            }
+        }).join();
+    }
+
+    std::string savedTimeZone = std::getenv("TZ") != nullptr ? std::getenv("TZ") : "";
+};
+
+// Test cached days render exactly as strftime, including around DST changes
+TEST_F(TimestampFormatterTest, MatchesStrftime) {
+#ifdef _WIN32
+    GTEST_SKIP() << "The Windows CRT does not read IANA time zone names or times before 1970";
+#endif
+    // Two weeks around the 2024 US spring-forward and fall-back changes, in uneven steps
+    useTimeZone("America/New_York");
+    expectMatchesStrftime(1709500000, 1709500000 + 14 * 86400, 97);
+    expectMatchesStrftime(1730300000, 1730300000 + 14 * 86400, 97);
+
+    // DST started at midnight here in 2018, so that day begins at 01:00
+    useTimeZone("America/Sao_Paulo");
+    expectMatchesStrftime(1541300000, 1541300000 + 2 * 86400, 13);
+
+    useTimeZone("UTC");
+    expectMatchesStrftime(-86400 * 3, 86400 * 3, 59);
+}
+
+// Test a DST-change day is cached as two spans rather than second by second
+TEST_F(TimestampFormatterTest, DstDayCachedAsTwoSpans) {
+#ifdef _WIN32
+    GTEST_SKIP() << "The Windows CRT does not read IANA time zone names";
+#endif
+    // 2024-03-10 in New York: midnight EST to midnight EDT, clocks skip 02:00-03:00
+    useTimeZone("America/New_York");
+    std::thread([]() {
+        char buffer[TimestampFormatter::FORMATTED_SIZE];
+        size_t before = TimestampFormatter::getDayLookups();
+        for (std::time_t time = 1710046800; time < 1710129600; time += 7) {
+            TimestampFormatter::format(time, buffer);
+        }
+        EXPECT_EQ(TimestampFormatter::getDayLookups() - before, 2u);
+        EXPECT_EQ(std::string(buffer, TimestampFormatter::format(1710054000, buffer)), "2024-03-10 03:00:00");
+        EXPECT_EQ(std::string(buffer, TimestampFormatter::format(1710053999, buffer)), "2024-03-10 01:59:59");
+    }).join();
+}
+
+// Test a transaction renders its fields into a caller buffer
+TEST_F(TimestampFormatterTest, TransactionAppendTo) {
+    auto when = std::chrono::system_clock::from_time_t(1700000000);
+    Transaction deposit(Transaction::Type::DEPOSIT, Money::fromRupees(100.5), Money::fromRupees(1100.5),
+                        DescriptionTable::CASH_DEPOSIT, when);
+    char stamp[TimestampFormatter::FORMATTED_SIZE];
+    std::string prefix(stamp, TimestampFormatter::format(when, stamp));
+
+    std::string line = "1. ";
+    deposit.appendTo(line);
+    EXPECT_EQ(line, "1. " + prefix + " | DEPOSIT    | ₹100.50 | Balance: ₹1100.50 | Cash deposit");
+
+    Transaction maturity(Transaction::Type::FD_MATURITY, Money::fromPaise(-5), Money(), DescriptionTable::NONE, when);
+    EXPECT_EQ(maturity.toString(), prefix + " | FD MATURITY | ₹-0.05 | Balance: ₹0.00");
+}
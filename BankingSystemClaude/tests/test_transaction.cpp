@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "Transaction.h"
+#include "BinaryIO.h"
+#include <cstring>
+
+class TransactionTest : public ::testing::Test {
+protected:
+    std::chrono::system_clock::time_point when = std::chrono::system_clock::from_time_t(1700000000);
+};
+
+// Test the record is compact and can be copied as raw bytes
+TEST_F(TransactionTest, CompactTriviallyCopyableLayout) {
+    EXPECT_LE(sizeof(Transaction), 32u);
+    EXPECT_TRUE(std::is_trivially_copyable<Transaction>::value);
+
+    Transaction original(Transaction::Type::WITHDRAWAL, Money::fromRupees(250.5), Money::fromRupees(749.5), "Cash withdrawal", when);
+    Transaction copy(Transaction::Type::DEPOSIT, Money::rupees(0), Money::rupees(0), DescriptionTable::NONE, when);
+    std::memcpy(&copy, &original, sizeof(Transaction));
+    EXPECT_EQ(copy.getType(), Transaction::Type::WITHDRAWAL);
+    EXPECT_EQ(copy.getAmount(), Money::fromRupees(250.5));
+    EXPECT_EQ(copy.getBalanceAfter(), Money::fromRupees(749.5));
+    EXPECT_EQ(copy.getTimestamp(), when);
+    EXPECT_EQ(copy.getDescription(), "Cash withdrawal");
+}
+
+// Test equal descriptions share one interned entry
+TEST_F(TransactionTest, DescriptionsAreInterned) {
+    EXPECT_EQ(DescriptionTable::intern("Cash deposit"), static_cast<uint32_t>(DescriptionTable::CASH_DEPOSIT));
+    EXPECT_EQ(DescriptionTable::lookup(DescriptionTable::FD_OPENED_24_MONTHS), "FD opened for 24 months");
+
+    uint32_t id = DescriptionTable::intern("FD opened for 36 months");
+    size_t entries = DescriptionTable::size();
+    Transaction first(Transaction::Type::FD_OPEN, Money::rupees(10), Money::rupees(90), "FD opened for 36 months", when);
+    Transaction second(Transaction::Type::FD_OPEN, Money::rupees(20), Money::rupees(70), "FD opened for 36 months", when);
+    EXPECT_EQ(first.getDescriptionId(), id);
+    EXPECT_EQ(second.getDescriptionId(), id);
+    EXPECT_EQ(DescriptionTable::size(), entries);
+    EXPECT_EQ(DescriptionTable::lookup(12345678), "");
+
+    // The table keys its own copy, not the caller's buffer
+    std::string buffer = "FD opened for 48 months";
+    uint32_t copied = DescriptionTable::intern(buffer);
+    buffer.assign(buffer.size(), 'x');
+    EXPECT_EQ(DescriptionTable::intern("FD opened for 48 months"), copied);
+    EXPECT_EQ(DescriptionTable::lookup(copied), "FD opened for 48 months");
+}
+
+// Test transfers keep their counterparty in the record rather than in the description table
+TEST_F(TransactionTest, TransferCounterpartyRenderedOnDemand) {
+    size_t entries = DescriptionTable::size();
+    for (int account = 424242; account < 424342; ++account) {
+        Transaction sent(Transaction::Type::TRANSFER, Money::rupees(10), Money::rupees(90),
+                         DescriptionTable::TRANSFER_TO, when, account);
+        EXPECT_EQ(sent.getCounterparty(), account);
+    }
+    Transaction sent(Transaction::Type::TRANSFER, Money::rupees(10), Money::rupees(90),
+                     DescriptionTable::TRANSFER_TO, when, 424242);
+    EXPECT_EQ(sent.getDescription(), "Transfer to 424242");
+    EXPECT_NE(sent.toString().find("| Transfer to 424242"), std::string::npos);
+
+    // Text written by either format splits back into the fixed id and the counterparty
+    Transaction parsed = Transaction::deserialize(sent.serialize());
+    EXPECT_EQ(parsed.getDescriptionId(), static_cast<uint32_t>(DescriptionTable::TRANSFER_TO));
+    EXPECT_EQ(parsed.getCounterparty(), 424242);
+
+    std::string buffer;
+    BinaryWriter out(buffer);
+    Transaction(Transaction::Type::TRANSFER, Money::rupees(5), Money::rupees(95), "Transfer from 1001", when).serializeBinary(out);
+    BinaryReader in(buffer.data(), buffer.size());
+    Transaction read = Transaction::deserializeBinary(in);
+    EXPECT_EQ(read.getDescriptionId(), static_cast<uint32_t>(DescriptionTable::TRANSFER_FROM));
+    EXPECT_EQ(read.getCounterparty(), 1001);
+    EXPECT_EQ(DescriptionTable::size(), entries);
+}
+
+// Test amounts are kept in whole paise and survive both snapshot formats
+TEST_F(TransactionTest, AmountsRoundToPaise) {
+    Transaction trans(Transaction::Type::DEPOSIT, Money::fromRupees(0.1 + 0.2), Money::fromRupees(1000.006), "Cash deposit", when);
+    EXPECT_EQ(trans.getAmount(), Money::fromRupees(0.3));
+    EXPECT_EQ(trans.getBalanceAfter(), Money::fromRupees(1000.01));
+
+    Transaction parsed = Transaction::deserialize(trans.serialize());
+    EXPECT_EQ(parsed.getAmount(), Money::fromRupees(0.3));
+    EXPECT_EQ(parsed.getDescriptionId(), trans.getDescriptionId());
+
+    std::string buffer;
+    BinaryWriter out(buffer);
+    trans.serializeBinary(out);
+    BinaryReader in(buffer.data(), buffer.size());
+    Transaction read = Transaction::deserializeBinary(in);
+    EXPECT_EQ(read.getBalanceAfter(), Money::fromRupees(1000.01));
+    EXPECT_EQ(read.getTimestamp(), when);
+    EXPECT_EQ(read.getDescription(), "Cash deposit");
+}
+
+// Test binary records keep clock precision and records with whole seconds still read
+TEST_F(TransactionTest, BinaryTimestampFormats) {
+    auto precise = when + std::chrono::milliseconds(250);
+    std::string buffer;
+    BinaryWriter out(buffer);
+    Transaction(Transaction::Type::DEPOSIT, Money::rupees(5), Money::rupees(5), "Cash deposit", precise).serializeBinary(out);
+    BinaryReader in(buffer.data(), buffer.size());
+    EXPECT_EQ(Transaction::deserializeBinary(in).getTimestamp(), precise);
+
+    buffer.clear();
+    out.writeU8(static_cast<uint8_t>(Transaction::Type::DEPOSIT));
+    out.writeMoney(Money::rupees(5));
+    out.writeMoney(Money::rupees(5));
+    out.writeI64(1700000000);
+    out.writeU16(0);
+    BinaryReader seconds(buffer.data(), buffer.size());
+    EXPECT_EQ(Transaction::deserializeBinary(seconds, AmountFormat::PAISE, TimestampFormat::SECONDS).getTimestamp(), when);
+}
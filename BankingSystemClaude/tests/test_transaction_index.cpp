@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "TransactionIndex.h"
+#include <algorithm>
+#include <random>
+
+class TransactionIndexTest : public ::testing::Test {
+protected:
+    struct Added {
+        int64_t timestamp;
+        Transaction::Type type;
+        uint32_t offset;
+    };
+
+    TransactionIndex index;
+    std::vector<Added> added;
+
+    void add(int64_t timestamp, Transaction::Type type) {
+        uint32_t offset = static_cast<uint32_t>(added.size());
+        index.add({1, offset, timestamp}, type);
+        added.push_back({timestamp, type, offset});
+    }
+
+    static std::chrono::system_clock::time_point at(int64_t ticks) {
+        return std::chrono::system_clock::time_point(std::chrono::system_clock::duration(ticks));
+    }
+
+    // Offsets a linear scan would return, in time order (stable for equal timestamps)
+    std::vector<uint32_t> expected(int64_t from, int64_t to, uint32_t mask) const {
+        std::vector<Added> sorted = added;
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const Added& a, const Added& b) { return a.timestamp < b.timestamp; });
+        std::vector<uint32_t> offsets;
+        for (const auto& entry : sorted) {
+            if (entry.timestamp >= from && entry.timestamp < to && (mask & Transaction::maskOf(entry.type))) {
+                offsets.push_back(entry.offset);
+            }
+        }
+        return offsets;
+    }
+
+    std::vector<uint32_t> query(int64_t from, int64_t to, uint32_t mask) const {
+        std::vector<uint32_t> offsets;
+        for (const auto& location : index.between(at(from), at(to), mask)) {
+            offsets.push_back(location.offset);
+        }
+        return offsets;
+    }
+};
+
+// Test range and type filters across several bitmap words match a linear scan
+TEST_F(TransactionIndexTest, RangeAndTypeFilter) {
+    for (int i = 0; i < 300; ++i) {
+        add(1000 + i, static_cast<Transaction::Type>(i % Transaction::TYPE_COUNT));
+    }
+
+    uint32_t deposits = Transaction::maskOf(Transaction::Type::DEPOSIT);
+    uint32_t transfers = Transaction::maskOf(Transaction::Type::TRANSFER) |
+                         Transaction::maskOf(Transaction::Type::WITHDRAWAL);
+    EXPECT_EQ(query(1000, 1300, Transaction::ALL_TYPES).size(), 300u);
+    EXPECT_EQ(query(1010, 1200, deposits), expected(1010, 1200, deposits));
+    EXPECT_EQ(query(1063, 1129, transfers), expected(1063, 1129, transfers));
+    EXPECT_EQ(query(1064, 1065, deposits), expected(1064, 1065, deposits));
+    EXPECT_TRUE(query(1200, 1100, Transaction::ALL_TYPES).empty());
+    EXPECT_TRUE(query(1000, 1300, 0).empty());
+
+    std::vector<TransactionIndex::Location> page = index.slice(298, 10);
+    ASSERT_EQ(page.size(), 2u);
+    EXPECT_EQ(page[0].offset, 298u);
+}
+
+// Test late timestamps are inserted in order with their type bits moved along
+TEST_F(TransactionIndexTest, OutOfOrderInsertKeepsBitmaps) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> jitter(0, 20);
+    std::uniform_int_distribution<int> type(0, static_cast<int>(Transaction::TYPE_COUNT) - 1);
+    for (int i = 0; i < 500; ++i) {
+        add(1000 + i - jitter(random), static_cast<Transaction::Type>(type(random)));
+    }
+
+    for (uint32_t mask = 1; mask < Transaction::ALL_TYPES; mask <<= 1) {
+        EXPECT_EQ(query(990, 1500, mask), expected(990, 1500, mask));
+        EXPECT_EQ(query(1130, 1333, mask | 1), expected(1130, 1333, mask | 1));
+    }
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "TransactionLog.h"
+#include "BinaryIO.h"
+#include "FileManager.h"
+#include <cstdio>
+#include <fstream>
+
+class TransactionLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeSegments();
+    }
+
+    void TearDown() override {
+        log.reset();
+        removeSegments();
+    }
+
+    void removeSegments() {
+        for (int segment = 1; segment < 1000; ++segment) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "test.txlog.%06d", segment);
+            if (!fileManager.fileExists(name)) {
+                break;
+            }
+            fileManager.deleteFile(name);
+            fileManager.deleteFile(std::string(name) + ".idx");
+        }
+    }
+
+    void openLog(size_t segmentBytes) {
+        log = std::make_unique<TransactionLog>("test.txlog", "test_data", segmentBytes);
+        ASSERT_TRUE(log->open());
+    }
+
+    static Transaction deposit(int64_t amount, int64_t balance, std::time_t when) {
+        return Transaction(Transaction::Type::DEPOSIT, Money::rupees(amount), Money::rupees(balance),
+                           DescriptionTable::CASH_DEPOSIT, std::chrono::system_clock::from_time_t(when));
+    }
+
+    FileManager fileManager{"test_data"};
+    std::unique_ptr<TransactionLog> log;
+};
+
+// Test pages and time ranges come back in order and open only the segments they need
+TEST_F(TransactionLogTest, PagesAndRangesReadOnlyNeededSegments) {
+    openLog(512);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(log->append(1001, deposit(i + 1, (i + 1) * 10, 1700000000 + i)));
+        ASSERT_TRUE(log->append(1002, deposit(1, i, 1700000000 + i)));
+    }
+    EXPECT_EQ(log->size(), 200u);
+    EXPECT_EQ(log->count(1001), 100u);
+    EXPECT_GT(log->getSegmentCount(), 10u);
+
+    std::vector<Transaction> page = log->readPage(1001, 40, 5);
+    ASSERT_EQ(page.size(), 5u);
+    EXPECT_EQ(page.front().getAmount(), Money::rupees(41));
+    EXPECT_EQ(page.back().getAmount(), Money::rupees(45));
+    EXPECT_LE(log->getSegmentReads(), 2u);
+
+    size_t readsBefore = log->getSegmentReads();
+    auto from = std::chrono::system_clock::from_time_t(1700000090);
+    std::vector<Transaction> range = log->readRange(1001, from, from + std::chrono::seconds(5));
+    ASSERT_EQ(range.size(), 5u);
+    EXPECT_EQ(range.front().getAmount(), Money::rupees(91));
+    EXPECT_LE(log->getSegmentReads() - readsBefore, 2u);
+    EXPECT_TRUE(log->readRange(1001, from, from + std::chrono::seconds(5),
+                               Transaction::maskOf(Transaction::Type::WITHDRAWAL)).empty());
+
+    EXPECT_EQ(log->readPage(1001, 95, 10).size(), 5u);
+    EXPECT_TRUE(log->readPage(1001, 100, 10).empty());
+    EXPECT_TRUE(log->readPage(4242, 0, 10).empty());
+}
+
+// Test reopening restores the index, keeps complete records of a torn segment and appends to a new one
+TEST_F(TransactionLogTest, ReopenRecoversTornSegment) {
+    openLog(TransactionLog::DEFAULT_SEGMENT_BYTES);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(log->append(1001, deposit(i + 1, 0, 1700000000 + i)));
+    }
+    std::string lastSegment = log->getSegmentPath(1);
+    log.reset();
+
+    // Simulate a crash mid-append: drop the seal and leave half a record at the end
+    fileManager.deleteFile("test.txlog.000001.idx");
+    {
+        std::ofstream torn(lastSegment, std::ios::out | std::ios::binary | std::ios::app);
+        torn.write("\x30\x00\x00\x00\xE9\x03", 6);
+    }
+
+    openLog(TransactionLog::DEFAULT_SEGMENT_BYTES);
+    EXPECT_EQ(log->count(1001), 10u);
+    EXPECT_EQ(log->getSegmentCount(), 2u);
+    ASSERT_TRUE(log->append(1001, deposit(11, 0, 1700000010)));
+
+    std::vector<Transaction> all = log->readPage(1001, 0, 100);
+    ASSERT_EQ(all.size(), 11u);
+    for (size_t i = 0; i < all.size(); ++i) {
+        EXPECT_EQ(all[i].getAmount(), Money::rupees(static_cast<int64_t>(i + 1)));
+    }
+}
+
+// Test segments written with f64 rupee amounts (TXNLOG01) are still read after new segments follow them
+TEST_F(TransactionLogTest, ReadsRupeeSegments) {
+    std::string data = "TXNLOG01";
+    BinaryWriter out(data);
+    for (int i = 0; i < 3; ++i) {
+        size_t recordStart = out.position();
+        out.writeU32(0);
+        out.writeI32(1001);
+        out.writeU8(static_cast<uint8_t>(Transaction::Type::DEPOSIT));
+        out.writeF64(10.25 * (i + 1));
+        out.writeF64(100.5);
+        out.writeI64(1700000000 + i);
+        out.writeU16(0);
+        out.patchU32(recordStart, static_cast<uint32_t>(out.position() - recordStart - 4));
+    }
+    ASSERT_TRUE(fileManager.ensureDataDirectory());
+    ASSERT_TRUE(fileManager.writeToFile("test.txlog.000001", data));
+
+    openLog(TransactionLog::DEFAULT_SEGMENT_BYTES);
+    ASSERT_TRUE(log->append(1001, deposit(7, 0, 1700000003)));
+    EXPECT_EQ(log->getSegmentCount(), 2u);
+
+    std::vector<Transaction> all = log->readPage(1001, 0, 10);
+    ASSERT_EQ(all.size(), 4u);
+    EXPECT_EQ(all[0].getAmount(), Money::fromPaise(1025));
+    EXPECT_EQ(all[2].getAmount(), Money::fromPaise(3075));
+    EXPECT_EQ(all[2].getBalanceAfter(), Money::fromPaise(10050));
+    EXPECT_EQ(all[3].getAmount(), Money::rupees(7));
+}
+
+// Test ranges split a second at clock precision, also after the index is reloaded or rebuilt
+TEST_F(TransactionLogTest, RangesUseClockPrecision) {
+    using std::chrono::milliseconds;
+    auto second = std::chrono::system_clock::from_time_t(1700000000);
+    openLog(TransactionLog::DEFAULT_SEGMENT_BYTES);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(log->append(1001, Transaction(Transaction::Type::DEPOSIT, Money::rupees(i + 1), Money(),
+                                                  DescriptionTable::CASH_DEPOSIT, second + milliseconds(250 * i))));
+    }
+
+    auto inRange = [this, second]() {
+        return log->readRange(1001, second + milliseconds(200), second + milliseconds(700)).size();
+    };
+    EXPECT_EQ(inRange(), 2u);
+
+    log.reset();
+    openLog(TransactionLog::DEFAULT_SEGMENT_BYTES);
+    EXPECT_EQ(inRange(), 2u);
+
+    // An index file in the old format (no magic, whole seconds) is rebuilt from its segment
+    std::string legacy;
+    BinaryWriter out(legacy);
+    out.writeU32(1);
+    out.writeI32(1001);
+    out.writeU32(8);
+    out.writeI64(1700000000);
+    out.writeU8(static_cast<uint8_t>(Transaction::Type::DEPOSIT));
+    log.reset();
+    ASSERT_TRUE(fileManager.writeToFile("test.txlog.000001.idx", legacy));
+
+    openLog(TransactionLog::DEFAULT_SEGMENT_BYTES);
+    EXPECT_EQ(log->count(1001), 4u);
+    EXPECT_EQ(inRange(), 2u);
+    EXPECT_EQ(fileManager.readFromFile("test.txlog.000001.idx").compare(0, 8, "TXNIDX02"), 0);
+}
+
+// Test failed appends are counted until they are collected
+TEST_F(TransactionLogTest, CountsFailedAppends) {
+    log = std::make_unique<TransactionLog>("test.txlog", "test_data");
+    EXPECT_FALSE(log->append(1001, deposit(5, 5, 1700000000)));
+    EXPECT_FALSE(log->append(1001, deposit(5, 10, 1700000001)));
+    EXPECT_EQ(log->takeFailedAppends(), 2u);
+    EXPECT_EQ(log->takeFailedAppends(), 0u);
+
+    openLog(TransactionLog::DEFAULT_SEGMENT_BYTES);
+    EXPECT_TRUE(log->append(1001, deposit(5, 5, 1700000000)));
+    EXPECT_EQ(log->takeFailedAppends(), 0u);
+}
@@ -0,0 +1,46 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BankManager.h"
+
+/**
+ * Convert a snapshot in the data directory between the text and binary formats,
+ * optionally splitting it into shard files.
+ *
+ * Usage: SnapshotConverter <source> <destination> <text|binary> [shards]
+ */
+int main(int argc, char* argv[]) {
+    if (argc != 4 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " <source> <destination> <text|binary> [shards]" << std::endl;
+        std::cerr << "Files are resolved relative to the data/ directory." << std::endl;
+        return 1;
+    }
+    
+    std::string target = argv[3];
+    BankManager::SnapshotFormat format;
+    if (target == "text") {
+        format = BankManager::SnapshotFormat::TEXT;
+    } else if (target == "binary") {
+        format = BankManager::SnapshotFormat::BINARY;
+    } else {
+        std::cerr << "❌ Unknown format: " << target << " (expected text or binary)" << std::endl;
+        return 1;
+    }
+    
+    int shards = argc == 5 ? std::atoi(argv[4]) : 1;
+    if (shards < 1) {
+        std::cerr << "❌ Shard count must be at least 1" << std::endl;
+        return 1;
+    }
+    
+    std::vector<std::string> diagnostics;
+    bool ok = BankManager::convertSnapshot(argv[1], argv[2], format, static_cast<size_t>(shards), &diagnostics);
+    for (const auto& message : diagnostics) {
+        std::cerr << "❌ " << message << std::endl;
+    }
+    if (ok) {
+        std::cout << "✅ Converted " << argv[1] << " to " << argv[2] << std::endl;
+    }
+    return ok ? 0 : 1;
+}